@@ -0,0 +1,969 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+// Block returned by allocate_at_least(): the storage and how many objects really fit in it.
+template <typename T>
+struct AllocationResult {
+    T* ptr;
+    std::size_t count;
+};
+
+// Hands out memory by bumping a pointer through large chunks and frees it all at once.
+// Intended for per-request scratch: every vector built on it is released by release()
+// or by destroying the arena, never individually.
+class MonotonicArena
+{
+public:
+    static constexpr std::size_t default_chunk_size = 64 * 1024;
+
+    // Creates an arena that requests chunks of at least chunk_size bytes from the heap.
+    explicit MonotonicArena(std::size_t chunk_size = default_chunk_size) noexcept
+        : _chunk_size(chunk_size) {}
+
+    // Creates an arena that carves allocations out of a caller-owned buffer first.
+    MonotonicArena(void* buffer, std::size_t size, std::size_t chunk_size = default_chunk_size) noexcept
+        : _chunk_size(chunk_size),
+          _cursor(static_cast<std::byte*>(buffer)),
+          _end(static_cast<std::byte*>(buffer) + size),
+          _initial_buffer(static_cast<std::byte*>(buffer)),
+          _initial_size(size) {}
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    // Frees every chunk obtained from the heap.
+    ~MonotonicArena()
+    {
+        free_chunks();
+    }
+
+    // Returns a block of the requested size and alignment, growing into a new chunk if needed.
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        if (void* block = bump(bytes, alignment)) return block;
+
+        // oversized requests get a chunk of their own so the next one keeps the normal size
+        std::size_t chunk_bytes = bytes + alignment + sizeof(Chunk);
+        if (chunk_bytes < _chunk_size) chunk_bytes = _chunk_size;
+
+        auto* chunk = static_cast<Chunk*>(::operator new(chunk_bytes));
+        chunk->next = _chunks;
+        _chunks = chunk;
+        _cursor = reinterpret_cast<std::byte*>(chunk + 1);
+        _end = reinterpret_cast<std::byte*>(chunk) + chunk_bytes;
+        _bytes_reserved += chunk_bytes;
+
+        return bump(bytes, alignment);
+    }
+
+    // Individual frees are ignored; memory comes back only through release().
+    void deallocate(void*, std::size_t, std::size_t = alignof(std::max_align_t)) noexcept {}
+
+    // Returns all chunks to the heap and rewinds to the initial buffer, if any.
+    void release() noexcept
+    {
+        free_chunks();
+        _cursor = _initial_buffer;
+        _end = _initial_buffer + _initial_size;
+        _bytes_allocated = 0;
+    }
+
+    // Returns how many bytes have been handed out since construction or the last release().
+    [[nodiscard]] std::size_t bytes_allocated() const noexcept
+    {
+        return _bytes_allocated;
+    }
+
+    // Returns how many bytes the arena currently holds from the heap.
+    [[nodiscard]] std::size_t bytes_reserved() const noexcept
+    {
+        return _bytes_reserved;
+    }
+
+private:
+    struct Chunk {
+        Chunk* next;
+    };
+
+    // Carves an aligned block out of the current chunk, or returns nullptr if it does not fit.
+    void* bump(std::size_t bytes, std::size_t alignment) noexcept
+    {
+        if (!_cursor) return nullptr;
+        const auto address = reinterpret_cast<std::uintptr_t>(_cursor);
+        const auto aligned = (address + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        const auto available = static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(_end) - address);
+        const std::size_t padding = aligned - address;
+        if (padding > available || bytes > available - padding) return nullptr;
+
+        _cursor += padding + bytes;
+        _bytes_allocated += bytes;
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    // Returns every heap chunk to ::operator delete.
+    void free_chunks() noexcept
+    {
+        while (_chunks) {
+            Chunk* next = _chunks->next;
+            ::operator delete(_chunks);
+            _chunks = next;
+        }
+        _bytes_reserved = 0;
+    }
+
+    std::size_t _chunk_size;
+    std::byte* _cursor = nullptr;
+    std::byte* _end = nullptr;
+    std::byte* _initial_buffer = nullptr;
+    std::size_t _initial_size = 0;
+    Chunk* _chunks = nullptr;
+    std::size_t _bytes_allocated = 0;
+    std::size_t _bytes_reserved = 0;
+};
+
+// Standard allocator adaptor over a MonotonicArena.
+// Containers never propagate the arena on assignment or swap, so a vector stays in the
+// arena it was built in; assigning across arenas copies or moves the elements instead.
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    // Binds the allocator to the arena it draws from.
+    ArenaAllocator(MonotonicArena& arena) noexcept
+        : _arena(&arena) {}
+
+    // Rebinds an allocator for another element type onto the same arena.
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : _arena(other.arena()) {}
+
+    // Allocates room for n objects of type T from the arena.
+    T* allocate(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    // Returns storage to the arena, which ignores it until release().
+    void deallocate(T* pointer, std::size_t n) noexcept
+    {
+        _arena->deallocate(pointer, n * sizeof(T), alignof(T));
+    }
+
+    // Returns the arena backing this allocator.
+    [[nodiscard]] MonotonicArena* arena() const noexcept
+    {
+        return _arena;
+    }
+
+    // Two arena allocators are interchangeable only if they share an arena.
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept
+    {
+        return _arena == other.arena();
+    }
+
+private:
+    MonotonicArena* _arena;
+};
+
+// Recycles blocks of one fixed size through an intrusive free list.
+// Blocks are carved from chunks of blocks_per_chunk at a time and only returned to the heap
+// when the pool is destroyed.
+class FixedPool
+{
+public:
+    // Creates a pool of blocks that each hold block_size bytes.
+    explicit FixedPool(std::size_t block_size, std::size_t blocks_per_chunk = 64) noexcept
+        : _block_size(round_up(block_size < sizeof(Block) ? sizeof(Block) : block_size)),
+          _blocks_per_chunk(blocks_per_chunk == 0 ? 1 : blocks_per_chunk) {}
+
+    FixedPool(const FixedPool&) = delete;
+    FixedPool& operator=(const FixedPool&) = delete;
+
+    // Frees every chunk the pool has allocated.
+    ~FixedPool()
+    {
+        while (_chunks) {
+            Block* next = _chunks->next;
+            ::operator delete(_chunks, std::align_val_t{alignof(std::max_align_t)});
+            _chunks = next;
+        }
+    }
+
+    // Pops a block off the free list, refilling it from a new chunk when empty.
+    void* allocate()
+    {
+        if (!_free) refill();
+        Block* block = _free;
+        _free = block->next;
+        return block;
+    }
+
+    // Pushes a block back onto the free list.
+    void deallocate(void* pointer) noexcept
+    {
+        auto* block = static_cast<Block*>(pointer);
+        block->next = _free;
+        _free = block;
+    }
+
+    // Returns the usable size of every block handed out by the pool.
+    [[nodiscard]] std::size_t block_size() const noexcept
+    {
+        return _block_size;
+    }
+
+private:
+    struct Block {
+        Block* next;
+    };
+
+    // Rounds a size up to the fundamental alignment so every block stays aligned.
+    static constexpr std::size_t round_up(std::size_t bytes) noexcept
+    {
+        constexpr std::size_t alignment = alignof(std::max_align_t);
+        return (bytes + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Allocates a new chunk and threads all of its blocks onto the free list.
+    void refill()
+    {
+        // the first block of every chunk links the chunk list
+        const std::size_t bytes = _block_size * (_blocks_per_chunk + 1);
+        auto* raw = static_cast<std::byte*>(::operator new(bytes, std::align_val_t{alignof(std::max_align_t)}));
+        auto* chunk = reinterpret_cast<Block*>(raw);
+        chunk->next = _chunks;
+        _chunks = chunk;
+
+        for (std::size_t i = _blocks_per_chunk; i > 0; --i) {
+            auto* block = reinterpret_cast<Block*>(raw + i * _block_size);
+            block->next = _free;
+            _free = block;
+        }
+    }
+
+    std::size_t _block_size;
+    std::size_t _blocks_per_chunk;
+    Block* _free = nullptr;
+    Block* _chunks = nullptr;
+};
+
+// Standard allocator adaptor over a FixedPool.
+// Requests that fit in one block come from the pool; larger ones fall through to the heap,
+// so a vector reserved up to the block size never touches the global allocator.
+template <typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "PoolAllocator does not support over-aligned types");
+
+    // Binds the allocator to the pool it draws from.
+    PoolAllocator(FixedPool& pool) noexcept
+        : _pool(&pool) {}
+
+    // Rebinds an allocator for another element type onto the same pool.
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+        : _pool(other.pool()) {}
+
+    // Allocates room for n objects, from the pool when they fit in a single block.
+    T* allocate(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        if (n * sizeof(T) <= _pool->block_size()) return static_cast<T*>(_pool->allocate());
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    // Returns storage to whichever source allocate() took it from.
+    void deallocate(T* pointer, std::size_t n) noexcept
+    {
+        if (n * sizeof(T) <= _pool->block_size()) {
+            _pool->deallocate(pointer);
+        } else {
+            ::operator delete(pointer);
+        }
+    }
+
+    // Returns the pool backing this allocator.
+    [[nodiscard]] FixedPool* pool() const noexcept
+    {
+        return _pool;
+    }
+
+    // Two pool allocators are interchangeable only if they share a pool.
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept
+    {
+        return _pool == other.pool();
+    }
+
+private:
+    FixedPool* _pool;
+};
+
+// Allocator over malloc/realloc/free that lets Vector grow a block in place.
+// Vector calls reallocate() instead of allocate-copy-free when its elements are trivially
+// relocatable, so the C library can extend the block or, for large blocks, remap its pages.
+template <typename T>
+class ReallocAllocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "ReallocAllocator does not support over-aligned types");
+
+    ReallocAllocator() noexcept = default;
+
+    // Rebinds from an allocator for another element type.
+    template <typename U>
+    ReallocAllocator(const ReallocAllocator<U>&) noexcept {}
+
+    // Allocates room for n objects with malloc.
+    T* allocate(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        void* block = std::malloc(n * sizeof(T));
+        if (!block) throw std::bad_alloc();
+        return static_cast<T*>(block);
+    }
+
+    // Allocates room for at least n objects and reports the slack malloc rounded up to.
+    AllocationResult<T> allocate_at_least(std::size_t n)
+    {
+        T* block = allocate(n);
+#if defined(__GLIBC__)
+        return {block, ::malloc_usable_size(block) / sizeof(T)};
+#else
+        return {block, n};
+#endif
+    }
+
+    // Resizes a block to new_n objects, keeping its bytes; the old block stays valid on failure.
+    T* reallocate(T* pointer, std::size_t, std::size_t new_n)
+    {
+        if (new_n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        void* block = std::realloc(pointer, new_n * sizeof(T));
+        if (!block) throw std::bad_alloc();
+        return static_cast<T*>(block);
+    }
+
+    // Returns storage to free.
+    void deallocate(T* pointer, std::size_t) noexcept
+    {
+        std::free(pointer);
+    }
+
+    template <typename U>
+    bool operator==(const ReallocAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+};
+
+// Allocator over aligned operator new that starts every block on an Alignment boundary, e.g.
+// 64 for cache lines and AVX-512 loads. Block sizes are rounded up to whole multiples of the
+// alignment, and allocate_at_least() hands that padding back as capacity, so the last aligned
+// chunk of a buffer is always fully allocated.
+template <typename T, std::size_t Alignment = 64>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static_assert(Alignment > 0 && (Alignment & (Alignment - 1)) == 0, "AlignedAllocator needs a power-of-two alignment");
+
+    // Alignment of every block, never below the element type's own.
+    static constexpr std::size_t alignment = Alignment > alignof(T) ? Alignment : alignof(T);
+
+    // Rebinding keeps the alignment, which allocator_traits cannot infer from a non-type parameter.
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    // Rebinds from an allocator for another element type.
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    // Allocates an aligned block for n objects.
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(::operator new(block_bytes(n), std::align_val_t{alignment}));
+    }
+
+    // Allocates an aligned block for at least n objects, counting the padding up to the alignment boundary.
+    AllocationResult<T> allocate_at_least(std::size_t n)
+    {
+        const std::size_t bytes = block_bytes(n);
+        return {static_cast<T*>(::operator new(bytes, std::align_val_t{alignment})), bytes / sizeof(T)};
+    }
+
+    // Returns a block from either allocate function.
+    void deallocate(T* pointer, std::size_t n) noexcept
+    {
+        // rounding the reported count reproduces the size the block was allocated with
+        ::operator delete(pointer, block_bytes(n), std::align_val_t{alignment});
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept
+    {
+        return true;
+    }
+
+private:
+    // Rounds the bytes for n objects up to a whole number of alignment units.
+    static std::size_t block_bytes(std::size_t n)
+    {
+        if (n > (static_cast<std::size_t>(-1) - alignment) / sizeof(T)) throw std::bad_array_new_length();
+        return (n * sizeof(T) + alignment - 1) & ~(alignment - 1);
+    }
+};
+
+#if defined(__linux__)
+// Allocator that backs large blocks with anonymous mappings and grows them with mremap.
+// Blocks of at least map_threshold bytes are page mappings, so doubling a multi-GB buffer
+// moves page table entries instead of copying data and never holds both copies at once.
+// Smaller blocks come from malloc; which kind a block is follows from its size alone.
+//
+// With HugePages, mappings are whole 2 MiB pages: explicit huge pages (MAP_HUGETLB) when the
+// system has some reserved, otherwise 2 MiB-aligned normal pages marked MADV_HUGEPAGE so
+// transparent huge pages can back them. Either way a large buffer needs one TLB entry per
+// 2 MiB instead of per 4 KiB; allocate_at_least() reports the rounding as capacity.
+template <typename T, std::size_t MapThreshold = 4 * 1024 * 1024, bool HugePages = false>
+class MremapAllocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t map_threshold = MapThreshold;
+    static constexpr bool huge_pages = HugePages;
+    // Huge page size on x86-64 and on arm64 with 4 KiB base pages.
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "MremapAllocator does not support over-aligned types");
+
+    template <typename U>
+    struct rebind {
+        using other = MremapAllocator<U, MapThreshold, HugePages>;
+    };
+
+    MremapAllocator() noexcept = default;
+
+    // Rebinds from an allocator for another element type.
+    template <typename U>
+    MremapAllocator(const MremapAllocator<U, MapThreshold, HugePages>&) noexcept {}
+
+    // Allocates room for n objects, mapping fresh pages for large requests.
+    T* allocate(std::size_t n)
+    {
+        const std::size_t bytes = checked_bytes(n);
+        void* block = is_mapped(bytes) ? map(bytes) : std::malloc(bytes);
+        if (!block) throw std::bad_alloc();
+        return static_cast<T*>(block);
+    }
+
+    // Allocates room for at least n objects, reporting the tail of the last page for mappings.
+    AllocationResult<T> allocate_at_least(std::size_t n)
+    {
+        T* block = allocate(n);
+        const std::size_t bytes = n * sizeof(T);
+        return {block, is_mapped(bytes) ? page_round(bytes) / sizeof(T) : n};
+    }
+
+    // Resizes a block to new_n objects, remapping pages in place when both sizes are mapped.
+    T* reallocate(T* pointer, std::size_t old_n, std::size_t new_n)
+    {
+        return reallocate(pointer, old_n, new_n, [](void*, std::size_t) noexcept {});
+    }
+
+    // Unmaps or frees a block depending on its size.
+    void deallocate(T* pointer, std::size_t n) noexcept
+    {
+        const std::size_t bytes = n * sizeof(T);
+        if (is_mapped(bytes)) {
+            ::munmap(pointer, page_round(bytes));
+        } else {
+            std::free(pointer);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const MremapAllocator<U, MapThreshold, HugePages>&) const noexcept
+    {
+        return true;
+    }
+
+protected:
+    // Resizes a block like reallocate(pointer, old_n, new_n), calling prepare(block, length) on
+    // every mapping it ends up in before any byte is copied into it.
+    template <typename Prepare>
+    T* reallocate(T* pointer, std::size_t old_n, std::size_t new_n, const Prepare& prepare)
+    {
+        const std::size_t old_bytes = old_n * sizeof(T);
+        const std::size_t new_bytes = checked_bytes(new_n);
+
+        void* block = nullptr;
+        if (is_mapped(old_bytes) && is_mapped(new_bytes)) {
+            block = ::mremap(pointer, page_round(old_bytes), page_round(new_bytes), MREMAP_MAYMOVE);
+            if (block != MAP_FAILED) {
+                // the moved pages keep their placement; only the new tail is still untouched
+                prepare(block, page_round(new_bytes));
+            } else {
+                // older kernels refuse to remap huge page mappings; copy into a fresh one
+                block = map(new_bytes);
+                if (!block) throw std::bad_alloc();
+                prepare(block, page_round(new_bytes));
+                std::memcpy(block, pointer, old_bytes < new_bytes ? old_bytes : new_bytes);
+                deallocate(pointer, old_n);
+            }
+        } else if (!is_mapped(old_bytes) && !is_mapped(new_bytes)) {
+            block = std::realloc(pointer, new_bytes);
+            if (!block) throw std::bad_alloc();
+        } else {
+            // crossing the threshold changes the kind of block, so the bytes are copied once
+            block = is_mapped(new_bytes) ? map(new_bytes) : std::malloc(new_bytes);
+            if (!block) throw std::bad_alloc();
+            if (is_mapped(new_bytes)) prepare(block, page_round(new_bytes));
+            std::memcpy(block, pointer, old_bytes < new_bytes ? old_bytes : new_bytes);
+            deallocate(pointer, old_n);
+        }
+        return static_cast<T*>(block);
+    }
+
+    // Converts an element count to bytes, rejecting counts that would overflow.
+    static std::size_t checked_bytes(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        return n * sizeof(T);
+    }
+
+    // Decides whether a block of this many bytes lives in its own mapping.
+    static bool is_mapped(std::size_t bytes) noexcept
+    {
+        return bytes >= MapThreshold;
+    }
+
+    // Rounds a byte count up to a whole number of pages, huge ones under HugePages.
+    static std::size_t page_round(std::size_t bytes) noexcept
+    {
+        static const auto page = HugePages ? huge_page_size : static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) & ~(page - 1);
+    }
+
+    // Maps zeroed anonymous pages, returning nullptr on failure.
+    static void* map(std::size_t bytes) noexcept
+    {
+        constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+        const std::size_t length = page_round(bytes);
+        if constexpr (HugePages) {
+            void* block = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+            if (block != MAP_FAILED) return block;
+
+            // no reserved huge pages: over-map, trim to a 2 MiB boundary and ask for THP
+            void* raw = ::mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (raw == MAP_FAILED) return nullptr;
+            const auto start = reinterpret_cast<std::uintptr_t>(raw);
+            const std::uintptr_t aligned = (start + huge_page_size - 1) & ~(huge_page_size - 1);
+            if (aligned > start) ::munmap(raw, aligned - start);
+            const std::size_t tail = huge_page_size - (aligned - start);
+            if (tail > 0) ::munmap(reinterpret_cast<void*>(aligned + length), tail);
+            ::madvise(reinterpret_cast<void*>(aligned), length, MADV_HUGEPAGE);
+            return reinterpret_cast<void*>(aligned);
+        } else {
+            void* block = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, flags, -1, 0);
+            return block == MAP_FAILED ? nullptr : block;
+        }
+    }
+};
+
+// MremapAllocator that maps every block of 2 MiB or more on huge pages.
+template <typename T>
+using HugePageAllocator = MremapAllocator<T, MremapAllocator<T>::huge_page_size, true>;
+
+// Which NUMA nodes a NumaAllocator places the pages of its mapped blocks on. Nodes are bits of
+// one unsigned long, so only nodes below max_nodes can be named.
+class NumaPolicy
+{
+public:
+    static constexpr unsigned max_nodes = sizeof(unsigned long) * CHAR_BIT;
+
+    // Leaves placement to the kernel default: each page goes to the node of the thread that
+    // first writes it.
+    static NumaPolicy first_touch() noexcept
+    {
+        return NumaPolicy(MPOL_DEFAULT, 0);
+    }
+
+    // Spreads pages round-robin over the nodes in node_mask, or over every online node if it is 0.
+    static NumaPolicy interleave(unsigned long node_mask = 0) noexcept
+    {
+        return NumaPolicy(MPOL_INTERLEAVE, node_mask);
+    }
+
+    // Puts every page on node, which must be below max_nodes.
+    static NumaPolicy bind(unsigned node)
+    {
+        if (node >= max_nodes) throw std::out_of_range("NumaPolicy: node beyond the node mask");
+        return NumaPolicy(MPOL_BIND, 1UL << node);
+    }
+
+    // Returns the MPOL_* mode passed to mbind.
+    [[nodiscard]] int mode() const noexcept
+    {
+        return _mode;
+    }
+
+    // Returns the nodes the policy names, resolving "every online node".
+    [[nodiscard]] unsigned long nodes() const noexcept
+    {
+        return _nodes != 0 || _mode == MPOL_DEFAULT ? _nodes : online_nodes();
+    }
+
+    // Sets the policy of the page-aligned range [address, address + length) for pages not yet
+    // touched. Placement is advice: where mbind fails, e.g. on kernels built without NUMA, the
+    // range keeps the kernel default and the memory is just as usable.
+    void apply(void* address, std::size_t length) const noexcept
+    {
+        if (_mode == MPOL_DEFAULT) return;
+        const unsigned long mask = nodes();
+        // the kernel reads one bit fewer than maxnode
+        ::syscall(SYS_mbind, address, length, _mode, &mask, sizeof(mask) * 8 + 1, 0);
+    }
+
+    // Returns the mask of online nodes, read once from sysfs; node 0 alone if that fails.
+    static unsigned long online_nodes() noexcept
+    {
+        static const unsigned long mask = [] {
+            unsigned long nodes = 0;
+            if (std::FILE* file = std::fopen("/sys/devices/system/node/online", "r")) {
+                // a list of ranges such as "0-1,4"
+                unsigned first = 0;
+                unsigned last = 0;
+                while (std::fscanf(file, "%u", &first) == 1) {
+                    last = first;
+                    int separator = std::fgetc(file);
+                    if (separator == '-') {
+                        if (std::fscanf(file, "%u", &last) != 1) break;
+                        separator = std::fgetc(file);
+                    }
+                    for (unsigned node = first; node <= last && node < max_nodes; ++node) {
+                        nodes |= 1UL << node;
+                    }
+                    if (separator != ',') break;
+                }
+                std::fclose(file);
+            }
+            return nodes != 0 ? nodes : 1UL;
+        }();
+        return mask;
+    }
+
+    bool operator==(const NumaPolicy&) const noexcept = default;
+
+private:
+    NumaPolicy(int mode, unsigned long nodes) noexcept
+        : _mode(mode), _nodes(nodes) {}
+
+    int _mode;
+    unsigned long _nodes;
+};
+
+// MremapAllocator that also sets a NumaPolicy on every mapped block before its pages are
+// touched, so that large buffers are interleaved across the sockets, or bound to the one whose
+// workers scan them, however the allocating thread is placed. Blocks under map_threshold come
+// from malloc and share pages with other allocations, so the policy does not apply to them.
+// Allocators compare equal when their policies do. The policy propagates with container copy,
+// move and swap, so a container's buffer and its policy always travel together.
+template <typename T, std::size_t MapThreshold = 4 * 1024 * 1024>
+class NumaAllocator : private MremapAllocator<T, MapThreshold>
+{
+    using base = MremapAllocator<T, MapThreshold>;
+
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    static constexpr std::size_t map_threshold = MapThreshold;
+
+    template <typename U>
+    struct rebind {
+        using other = NumaAllocator<U, MapThreshold>;
+    };
+
+    // Creates an allocator that interleaves mapped blocks over every online node.
+    NumaAllocator() noexcept = default;
+
+    // Creates an allocator that places mapped blocks by policy.
+    explicit NumaAllocator(NumaPolicy policy) noexcept
+        : _policy(policy) {}
+
+    // Rebinds from an allocator for another element type, keeping its policy.
+    template <typename U>
+    NumaAllocator(const NumaAllocator<U, MapThreshold>& other) noexcept
+        : _policy(other.policy()) {}
+
+    // Returns the placement policy.
+    [[nodiscard]] NumaPolicy policy() const noexcept
+    {
+        return _policy;
+    }
+
+    // Allocates room for n objects, placing fresh mappings by the policy.
+    T* allocate(std::size_t n)
+    {
+        return place(base::allocate(n), n);
+    }
+
+    // Allocates room for at least n objects, reporting the tail of the last page for mappings.
+    AllocationResult<T> allocate_at_least(std::size_t n)
+    {
+        AllocationResult<T> result = base::allocate_at_least(n);
+        place(result.ptr, n);
+        return result;
+    }
+
+    // Resizes a block with mremap where possible. A fresh mapping gets the policy before the old
+    // contents are copied in, so that the copy already faults its pages in on the right nodes.
+    T* reallocate(T* pointer, std::size_t old_n, std::size_t new_n)
+    {
+        return base::reallocate(pointer, old_n, new_n,
+                                [this](void* block, std::size_t length) noexcept { _policy.apply(block, length); });
+    }
+
+    // Unmaps or frees a block depending on its size.
+    void deallocate(T* pointer, std::size_t n) noexcept
+    {
+        base::deallocate(pointer, n);
+    }
+
+    // Two allocators are interchangeable only if they place blocks the same way.
+    template <typename U>
+    bool operator==(const NumaAllocator<U, MapThreshold>& other) const noexcept
+    {
+        return _policy == other.policy();
+    }
+
+private:
+    T* place(T* block, std::size_t n) const noexcept
+    {
+        const std::size_t bytes = n * sizeof(T);
+        if (base::is_mapped(bytes)) _policy.apply(block, base::page_round(bytes));
+        return block;
+    }
+
+    NumaPolicy _policy = NumaPolicy::interleave();
+};
+#endif
+
+// Per-thread cache of freed heap blocks by power-of-two size class, from 64 bytes up to
+// max_class_bytes. A thread that frees a block keeps it for its next allocation of the same
+// class, so a workload that keeps building and dropping similar vectors stops going through
+// ::operator new and its locks. Each class keeps at most blocks_per_class blocks; larger blocks
+// and overflow go straight back to the heap. A block can be freed on any thread; it then joins
+// that thread's cache. Everything still cached is freed when the thread exits.
+class ThreadBufferCache
+{
+public:
+    static constexpr std::size_t min_class_bytes = 64;
+    static constexpr std::size_t max_class_bytes = 16 * 1024 * 1024;
+    static constexpr std::size_t blocks_per_class = 8;
+
+    ThreadBufferCache() noexcept = default;
+    ThreadBufferCache(const ThreadBufferCache&) = delete;
+    ThreadBufferCache& operator=(const ThreadBufferCache&) = delete;
+
+    // Frees every cached block; later frees on this thread bypass the cache.
+    ~ThreadBufferCache()
+    {
+        trim();
+        _retired = true;
+    }
+
+    // Returns the calling thread's cache, or nullptr while the thread is being torn down.
+    static ThreadBufferCache* local() noexcept
+    {
+        if (_retired) return nullptr;
+        thread_local ThreadBufferCache cache;
+        return &cache;
+    }
+
+    // Returns the size class a request of this many bytes is served from, or bytes itself when
+    // it is too large to cache.
+    static constexpr std::size_t class_bytes(std::size_t bytes) noexcept
+    {
+        if (bytes > max_class_bytes) return bytes;
+        return std::bit_ceil(std::max(bytes, min_class_bytes));
+    }
+
+    // Returns a block of class_bytes(bytes) bytes, reusing a cached one when there is one.
+    void* allocate(std::size_t bytes)
+    {
+        const std::size_t size = class_bytes(bytes);
+        if (size <= max_class_bytes) {
+            const std::size_t index = class_index(size);
+            if (FreeBlock* block = _free[index]) {
+                _free[index] = block->next;
+                --_cached[index];
+                ++_hits;
+                return block;
+            }
+        }
+        ++_misses;
+        return ::operator new(size);
+    }
+
+    // Takes back a block of class_bytes(bytes) bytes, caching it if its class has room.
+    void deallocate(void* pointer, std::size_t bytes) noexcept
+    {
+        const std::size_t size = class_bytes(bytes);
+        if (size <= max_class_bytes) {
+            const std::size_t index = class_index(size);
+            if (_cached[index] < blocks_per_class) {
+                _free[index] = ::new (pointer) FreeBlock{_free[index]};
+                ++_cached[index];
+                return;
+            }
+        }
+        ::operator delete(pointer);
+    }
+
+    // Returns every cached block to the heap.
+    void trim() noexcept
+    {
+        for (std::size_t i = 0; i < class_count; ++i) {
+            while (FreeBlock* block = _free[i]) {
+                _free[i] = block->next;
+                ::operator delete(block);
+            }
+            _cached[i] = 0;
+        }
+    }
+
+    // Returns how many allocations were served from the cache.
+    [[nodiscard]] std::size_t hits() const noexcept
+    {
+        return _hits;
+    }
+
+    // Returns how many allocations went to the heap.
+    [[nodiscard]] std::size_t misses() const noexcept
+    {
+        return _misses;
+    }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    static constexpr std::size_t class_count =
+        std::bit_width(max_class_bytes) - std::bit_width(min_class_bytes) + 1;
+
+    static std::size_t class_index(std::size_t size) noexcept
+    {
+        return std::bit_width(size) - std::bit_width(min_class_bytes);
+    }
+
+    static inline thread_local bool _retired = false;
+
+    FreeBlock* _free[class_count] = {};
+    std::size_t _cached[class_count] = {};
+    std::size_t _hits = 0;
+    std::size_t _misses = 0;
+};
+
+// Allocator over the calling thread's ThreadBufferCache. Requests are rounded up to their size
+// class, and allocate_at_least() reports the rounding as capacity, so a vector grown by doubling
+// fills whole classes and a freed buffer fits the next vector of the same class exactly.
+template <typename T>
+class RecyclingAllocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static_assert(alignof(T) <= alignof(std::max_align_t), "RecyclingAllocator does not support over-aligned types");
+
+    RecyclingAllocator() noexcept = default;
+
+    // Rebinds from an allocator for another element type.
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U>&) noexcept {}
+
+    // Allocates room for n objects from the calling thread's cache.
+    T* allocate(std::size_t n)
+    {
+        if (n > static_cast<std::size_t>(-1) / sizeof(T)) throw std::bad_array_new_length();
+        const std::size_t bytes = n * sizeof(T);
+        if (ThreadBufferCache* cache = ThreadBufferCache::local()) return static_cast<T*>(cache->allocate(bytes));
+        return static_cast<T*>(::operator new(ThreadBufferCache::class_bytes(bytes)));
+    }
+
+    // Allocates room for at least n objects: as many as fit in the size class.
+    AllocationResult<T> allocate_at_least(std::size_t n)
+    {
+        T* block = allocate(n);
+        return {block, std::max(n, ThreadBufferCache::class_bytes(n * sizeof(T)) / sizeof(T))};
+    }
+
+    // Returns storage to the calling thread's cache, whichever thread allocated it.
+    void deallocate(T* pointer, std::size_t n) noexcept
+    {
+        if (ThreadBufferCache* cache = ThreadBufferCache::local()) {
+            cache->deallocate(pointer, n * sizeof(T));
+        } else {
+            ::operator delete(pointer);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const RecyclingAllocator<U>&) const noexcept
+    {
+        return true;
+    }
+};
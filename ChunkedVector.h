@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+namespace vector_detail {
+
+// Elements per chunk that keep one chunk near 4 KiB, rounded down to a power of two.
+template <typename T>
+constexpr std::size_t default_chunk_size() noexcept
+{
+    return std::bit_floor(sizeof(T) >= 4096 ? std::size_t{1} : 4096 / sizeof(T));
+}
+
+} // namespace vector_detail
+
+// Vector-like sequence stored in fixed-size chunks reached through a chunk index. Appending never
+// moves an element: when the last chunk is full one more is allocated and its pointer appended to
+// the index, so the worst case is one chunk allocation plus, rarely, the index doubling, which
+// copies one pointer per chunk rather than chunk_size elements. References and pointers stay
+// valid until their element is popped or the container is cleared; iterators survive growth.
+// Popped chunks are kept for reuse until shrink_to_fit().
+template <typename T, typename Allocator = std::allocator<T>, std::size_t ChunkSize = vector_detail::default_chunk_size<T>()>
+class ChunkedVector
+{
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using index_allocator = typename alloc_traits::template rebind_alloc<T*>;
+
+    static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                  "ChunkedVector requires Allocator::value_type to match T");
+    static_assert(ChunkSize > 0 && std::has_single_bit(ChunkSize), "ChunkSize must be a power of two");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = IndexIterator<ChunkedVector, T>;
+    using const_iterator = IndexIterator<const ChunkedVector, const T>;
+
+    // Elements held by each chunk.
+    static constexpr size_type chunk_size = ChunkSize;
+
+    // Constructs an empty container; no chunk is allocated until the first append.
+    ChunkedVector() noexcept(noexcept(Allocator()))
+        : _allocator(), _chunks(index_allocator(_allocator)) {}
+
+    // Constructs an empty container that allocates from the given allocator.
+    explicit ChunkedVector(const Allocator& allocator) noexcept
+        : _allocator(allocator), _chunks(index_allocator(_allocator)) {}
+
+    // Copies the elements of an initializer list.
+    ChunkedVector(std::initializer_list<T> init, const Allocator& allocator = Allocator())
+        : ChunkedVector(allocator)
+    {
+        reserve(init.size());
+        for (const T& value : init) {
+            push_back(value);
+        }
+    }
+
+    // Copies elements from another container.
+    ChunkedVector(const ChunkedVector& other)
+        : ChunkedVector(alloc_traits::select_on_container_copy_construction(other._allocator))
+    {
+        copy_from(other);
+    }
+
+    // Takes ownership of another container's chunks without touching elements.
+    ChunkedVector(ChunkedVector&& other) noexcept
+        : _allocator(std::move(other._allocator)), _chunks(std::move(other._chunks)), _size(other._size)
+    {
+        other._size = 0;
+    }
+
+    // Assigns from another container by making a deep copy.
+    ChunkedVector& operator=(const ChunkedVector& other)
+    {
+        if (this != &other) {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (!alloc_traits::is_always_equal::value && _allocator != other._allocator) {
+                    release();
+                }
+                _allocator = other._allocator;
+            }
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    // Takes another container's chunks if the allocators allow it, otherwise moves each element.
+    ChunkedVector& operator=(ChunkedVector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value)
+    {
+        if (this != &other) {
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                release();
+                _allocator = std::move(other._allocator);
+                steal(other);
+            } else if (alloc_traits::is_always_equal::value || _allocator == other._allocator) {
+                release();
+                steal(other);
+            } else {
+                // chunks cannot change hands, so the elements move one by one
+                clear();
+                reserve(other._size);
+                for (T& value : other) {
+                    emplace_back(std::move(value));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // Exchanges all with another container.
+    void swap(ChunkedVector& other) noexcept
+    {
+        using std::swap;
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            swap(_allocator, other._allocator);
+        }
+        _chunks.swap(other._chunks);
+        swap(_size, other._size);
+    }
+
+    // Destroys every element and frees every chunk.
+    ~ChunkedVector()
+    {
+        release();
+    }
+
+    // Returns a copy of the allocator used for chunks.
+    [[nodiscard]] allocator_type get_allocator() const noexcept
+    {
+        return _allocator;
+    }
+
+    // Returns how many elements are currently stored.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // Returns how many elements fit in the chunks already allocated.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return _chunks.size() * chunk_size;
+    }
+
+    // Indicates whether the container holds no elements.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // Returns how many chunks are allocated.
+    [[nodiscard]] size_type chunk_count() const noexcept
+    {
+        return _chunks.size();
+    }
+
+    // Returns a reference to the element at the supplied index, throwing if it is out of range.
+    reference at(size_type index)
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return element(index);
+    }
+
+    // Returns a const reference to the element at the supplied index, throwing if it is out of range.
+    const_reference at(size_type index) const
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return element(index);
+    }
+
+    // Returns a reference to the element at the supplied index without a bounds check.
+    reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return element(index);
+    }
+
+    // Returns a const reference to the element at the supplied index without a bounds check.
+    const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return element(index);
+    }
+
+    // Returns a reference to the first element.
+    reference front()
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty ChunkedVector");
+        return element(0);
+    }
+
+    // Returns a const reference to the first element.
+    const_reference front() const
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty ChunkedVector");
+        return element(0);
+    }
+
+    // Returns a reference to the last element.
+    reference back()
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty ChunkedVector");
+        return element(_size - 1);
+    }
+
+    // Returns a const reference to the last element.
+    const_reference back() const
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty ChunkedVector");
+        return element(_size - 1);
+    }
+
+    // Appends a copy of value.
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    // Appends value by moving it.
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    // Constructs an element at the end and returns a reference to it. If construction throws, the
+    // container is unchanged apart from possibly one more spare chunk.
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if (_size == capacity()) {
+            add_chunk();
+        }
+        T* slot = &element(_size);
+        alloc_traits::construct(_allocator, slot, std::forward<Args>(args)...);
+        ++_size;
+        return *slot;
+    }
+
+    // Destroys the last element, if any; its chunk stays allocated for the next append.
+    void pop_back()
+    {
+        if (_size == 0) return;
+        --_size;
+        alloc_traits::destroy(_allocator, &element(_size));
+    }
+
+    // Allocates chunks until at least new_capacity elements fit.
+    void reserve(size_type new_capacity)
+    {
+        const size_type needed = (new_capacity + chunk_size - 1) / chunk_size;
+        if (needed <= _chunks.size()) return;
+        _chunks.reserve(needed);
+        while (_chunks.size() < needed) {
+            add_chunk();
+        }
+    }
+
+    // Frees chunks past the one holding the last element.
+    void shrink_to_fit()
+    {
+        const size_type needed = (_size + chunk_size - 1) / chunk_size;
+        while (_chunks.size() > needed) {
+            alloc_traits::deallocate(_allocator, _chunks.back(), chunk_size);
+            _chunks.pop_back();
+        }
+        _chunks.shrink_to_fit();
+    }
+
+    // Destroys every element, keeping the chunks.
+    void clear() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i = 0; i < _size; ++i) {
+                alloc_traits::destroy(_allocator, &element(i));
+            }
+        }
+        _size = 0;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, _size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, _size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Compares element-wise.
+    friend bool operator==(const ChunkedVector& lhs, const ChunkedVector& rhs)
+    {
+        return lhs._size == rhs._size && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+private:
+    T& element(size_type index) const noexcept
+    {
+        return _chunks.data()[index / chunk_size][index % chunk_size];
+    }
+
+    // Allocates one chunk and records it in the index; nothing leaks if either step throws.
+    void add_chunk()
+    {
+        T* chunk = alloc_traits::allocate(_allocator, chunk_size);
+        try {
+            _chunks.push_back(chunk);
+        } catch (...) {
+            alloc_traits::deallocate(_allocator, chunk, chunk_size);
+            throw;
+        }
+    }
+
+    void copy_from(const ChunkedVector& other)
+    {
+        reserve(other._size);
+        for (const T& value : other) {
+            push_back(value);
+        }
+    }
+
+    void release() noexcept
+    {
+        clear();
+        for (T* chunk : _chunks) {
+            alloc_traits::deallocate(_allocator, chunk, chunk_size);
+        }
+        _chunks.clear();
+    }
+
+    void steal(ChunkedVector& other) noexcept
+    {
+        _chunks = std::move(other._chunks);
+        _size = other._size;
+        other._size = 0;
+    }
+
+    [[no_unique_address]] Allocator _allocator;
+    Vector<T*, index_allocator> _chunks;
+    size_type _size = 0;
+};
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+// Append-only vector that many threads can grow at once without a lock.
+// Elements live in segments of doubling size that are never moved or freed while the vector is
+// alive, so references and indices stay valid under concurrent growth. A thread claims slots
+// with one atomic add and installs a missing segment with one compare-and-swap; racing threads
+// that lose the swap free their copy and use the winner's.
+//
+// Appending constructs the element before claiming its slot, so a throwing constructor never
+// leaves a hole. Running out of memory for a new segment after claiming a slot cannot be
+// undone and terminates. Reading is safe for any element whose append happened-before the read,
+// e.g. an index handed over through another synchronising operation or read after joining the
+// writers. clear(), compact() and destruction need every writer to have finished.
+template <typename T, typename Allocator = std::allocator<T>>
+class ConcurrentVector
+{
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                  "ConcurrentVector requires Allocator::value_type to match T");
+    static_assert(std::is_nothrow_move_constructible_v<T>,
+                  "ConcurrentVector moves elements into claimed slots and needs a non-throwing move");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+
+    // Elements in segment 0; segment k holds first_segment_size << k. About 1 KiB to start.
+    static constexpr size_type first_segment_size = std::bit_ceil(sizeof(T) >= 1024 ? size_type{1} : 1024 / sizeof(T));
+    // Number of segment slots, enough to index more elements than memory can hold.
+    static constexpr size_type max_segments = 48;
+
+    // Constructs an empty vector; no memory is allocated until the first append.
+    ConcurrentVector() noexcept(noexcept(Allocator()))
+        : _allocator() {}
+
+    // Constructs an empty vector that allocates segments from the given allocator, which must be
+    // safe to call from several threads.
+    explicit ConcurrentVector(const Allocator& allocator) noexcept
+        : _allocator(allocator) {}
+
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    // Destroys every element and frees the segments.
+    ~ConcurrentVector()
+    {
+        clear();
+        for (size_type k = 0; k < max_segments; ++k) {
+            if (T* segment = _segments[k].load(std::memory_order_relaxed)) {
+                alloc_traits::deallocate(_allocator, segment, segment_size(k));
+            }
+        }
+    }
+
+    // Returns how many slots have been claimed; slots claimed by a concurrent append may still be
+    // under construction.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _size.load(std::memory_order_acquire);
+    }
+
+    // Returns whether no slot has been claimed.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // Appends a copy of value from any thread and returns its index.
+    size_type push_back(const T& value)
+    {
+        return emplace_back(value);
+    }
+
+    // Appends value from any thread and returns its index.
+    size_type push_back(T&& value)
+    {
+        return emplace_back(std::move(value));
+    }
+
+    // Constructs an element from args and appends it from any thread, returning its index.
+    template <typename... Args>
+    size_type emplace_back(Args&&... args)
+    {
+        T value(std::forward<Args>(args)...); // may throw before any slot is taken
+        const size_type index = _size.fetch_add(1, std::memory_order_acq_rel);
+        alloc_traits::construct(_allocator, slot(index), std::move(value));
+        return index;
+    }
+
+    // Appends count value-initialized elements as one contiguous run of indices from any thread
+    // and returns the first index.
+    size_type grow_by(size_type count)
+        requires std::is_nothrow_default_constructible_v<T>
+    {
+        const size_type first = _size.fetch_add(count, std::memory_order_acq_rel);
+        for_each_slot(first, count, [&](T* target) { alloc_traits::construct(_allocator, target); });
+        return first;
+    }
+
+    // Appends count copies of value as one contiguous run of indices from any thread and returns
+    // the first index.
+    size_type grow_by(size_type count, const T& value)
+        requires std::is_nothrow_copy_constructible_v<T>
+    {
+        const size_type first = _size.fetch_add(count, std::memory_order_acq_rel);
+        for_each_slot(first, count, [&](T* target) { alloc_traits::construct(_allocator, target, value); });
+        return first;
+    }
+
+    // Returns the element at index without a bounds check.
+    reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < size(), "index out of range");
+        return *address(index);
+    }
+
+    // Returns the element at index without a bounds check.
+    const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < size(), "index out of range");
+        return *address(index);
+    }
+
+    // Returns the element at index, throwing std::out_of_range if no such slot was claimed.
+    reference at(size_type index)
+    {
+        if (index >= size()) throw std::out_of_range("index out of range");
+        return *address(index);
+    }
+
+    // Returns the element at index, throwing std::out_of_range if no such slot was claimed.
+    const_reference at(size_type index) const
+    {
+        if (index >= size()) throw std::out_of_range("index out of range");
+        return *address(index);
+    }
+
+    // Calls visit with a span over each segment's elements in index order. Not safe against
+    // concurrent appends.
+    template <typename Visitor>
+    void for_each_segment(Visitor&& visit) const
+    {
+        visit_segments(*this, visit);
+    }
+
+    // Copies every element into one contiguous Vector.
+    template <typename VectorAllocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+    Vector<T, VectorAllocator, GrowthPolicy> to_vector(const VectorAllocator& allocator = VectorAllocator()) const
+    {
+        Vector<T, VectorAllocator, GrowthPolicy> result(allocator);
+        result.reserve(size());
+        for_each_segment([&](std::span<const T> segment) { result.append_range(segment); });
+        return result;
+    }
+
+    // Moves every element into one contiguous Vector and leaves this vector empty, keeping its
+    // segments for reuse.
+    template <typename VectorAllocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+    Vector<T, VectorAllocator, GrowthPolicy> compact(const VectorAllocator& allocator = VectorAllocator())
+    {
+        Vector<T, VectorAllocator, GrowthPolicy> result(allocator);
+        result.reserve(size());
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            for_each_segment([&](std::span<const T> segment) { result.append_range(segment); });
+        } else {
+            visit_segments(*this, [&](std::span<T> segment) {
+                for (T& element : segment) {
+                    result.emplace_back(std::move(element));
+                }
+            });
+        }
+        clear();
+        return result;
+    }
+
+    // Destroys every element, keeping the segments. Not safe against concurrent appends.
+    void clear() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for_each_slot(0, size(), [&](T* target) { alloc_traits::destroy(_allocator, target); });
+        }
+        _size.store(0, std::memory_order_release);
+    }
+
+private:
+    static constexpr size_type segment_size(size_type k) noexcept
+    {
+        return first_segment_size << k;
+    }
+
+    // Index of the first element of segment k.
+    static constexpr size_type segment_base(size_type k) noexcept
+    {
+        return first_segment_size * ((size_type{1} << k) - 1);
+    }
+
+    // Segment holding index.
+    static constexpr size_type segment_of(size_type index) noexcept
+    {
+        return static_cast<size_type>(std::bit_width(index / first_segment_size + 1)) - 1;
+    }
+
+    // Address of an element whose segment is known to exist.
+    T* address(size_type index) const noexcept
+    {
+        const size_type k = segment_of(index);
+        return _segments[k].load(std::memory_order_acquire) + (index - segment_base(k));
+    }
+
+    // Address of a claimed slot, installing its segment first if nobody has yet.
+    T* slot(size_type index) noexcept
+    {
+        const size_type k = segment_of(index);
+        return segment(k) + (index - segment_base(k));
+    }
+
+    // Calls visit with a span over each of self's segments in index order, const exactly when
+    // self is.
+    template <typename Self, typename Visitor>
+    static void visit_segments(Self& self, Visitor&& visit)
+    {
+        using Element = std::conditional_t<std::is_const_v<Self>, const T, T>;
+        const size_type total = self.size();
+        for (size_type k = 0, begin = 0; begin < total; begin += segment_size(k), ++k) {
+            const size_type count = total - begin < segment_size(k) ? total - begin : segment_size(k);
+            visit(std::span<Element>(self._segments[k].load(std::memory_order_acquire), count));
+        }
+    }
+
+    // Returns segment k, allocating it if needed. Throwing here would strand the caller's claimed
+    // slots, hence noexcept.
+    T* segment(size_type k) noexcept
+    {
+        if (k >= max_segments) std::terminate();
+        T* existing = _segments[k].load(std::memory_order_acquire);
+        if (existing) return existing;
+
+        T* fresh = alloc_traits::allocate(_allocator, segment_size(k));
+        if (_segments[k].compare_exchange_strong(existing, fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return fresh;
+        }
+        alloc_traits::deallocate(_allocator, fresh, segment_size(k));
+        return existing;
+    }
+
+    // Calls apply on the address of every slot in [first, first + count), segment by segment.
+    template <typename Apply>
+    void for_each_slot(size_type first, size_type count, Apply&& apply) noexcept
+    {
+        const size_type last = first + count;
+        while (first < last) {
+            const size_type k = segment_of(first);
+            T* const slots = segment(k);
+            const size_type base = segment_base(k);
+            const size_type end = base + segment_size(k) < last ? base + segment_size(k) : last;
+            for (; first < end; ++first) {
+                apply(slots + (first - base));
+            }
+        }
+    }
+
+    std::atomic<size_type> _size{0};
+    std::atomic<T*> _segments[max_segments] = {};
+    [[no_unique_address]] Allocator _allocator;
+};
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+template <typename T, typename Allocator>
+class AtomicCowVector;
+
+// Copy-on-write Vector for read-mostly data handed to many readers.
+// Copies share one reference-counted buffer, so copying costs an atomic increment however many
+// elements there are. The first mutating call on a copy that still shares its buffer detaches
+// it: the elements are copied into a private buffer, and other copies keep the old one. Note
+// that the non-const accessors (operator[], at(), front(), back(), data(), begin(), end()) count
+// as mutating; read through a const reference, or cbegin()/cend(), to keep sharing.
+//
+// Different CowVector objects may be read, copied, written and destroyed from different
+// threads even when they share a buffer; one object needs the usual external synchronization.
+// AtomicCowVector publishes a CowVector to concurrent readers.
+template <typename T, typename Allocator = std::allocator<T>>
+class CowVector
+{
+    using Buffer = Vector<T, Allocator>;
+    using buffer_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Buffer>;
+
+    static_assert(std::is_copy_constructible_v<T>, "CowVector copies elements when a shared buffer is written");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using pointer_type = T*;
+    using const_pointer_type = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = VectorIterator<T>;
+    using const_iterator = VectorIterator<const T>;
+
+    // Constructs an empty vector; no buffer is allocated until the first write.
+    CowVector() noexcept(noexcept(Allocator()))
+        : _allocator() {}
+
+    // Constructs an empty vector whose buffers come from the given allocator.
+    explicit CowVector(const Allocator& allocator) noexcept
+        : _allocator(allocator) {}
+
+    // Copies the elements of an initializer list into a new buffer.
+    CowVector(std::initializer_list<T> init, const Allocator& allocator = Allocator())
+        : CowVector(Buffer(init, allocator)) {}
+
+    // Copies the elements of [first, last) into a new buffer.
+    template <std::input_iterator InputIt>
+    CowVector(InputIt first, InputIt last, const Allocator& allocator = Allocator())
+        : CowVector(Buffer(first, last, allocator)) {}
+
+    // Takes over a Vector's elements without copying them.
+    explicit CowVector(Buffer&& elements)
+        : _allocator(elements.get_allocator())
+    {
+        if (!elements.empty()) {
+            _buffer = std::allocate_shared<Buffer>(buffer_allocator(_allocator), std::move(elements));
+        }
+    }
+
+    // Shares other's buffer.
+    CowVector(const CowVector& other) noexcept = default;
+
+    // Takes other's reference to its buffer, leaving other empty.
+    CowVector(CowVector&& other) noexcept = default;
+
+    // Shares other's buffer, releasing this vector's.
+    CowVector& operator=(const CowVector& other) noexcept = default;
+
+    // Takes other's reference to its buffer, releasing this vector's.
+    CowVector& operator=(CowVector&& other) noexcept = default;
+
+    // Releases this vector's reference; the last one out destroys the elements.
+    ~CowVector() = default;
+
+    // Exchanges buffers and allocators with another vector.
+    void swap(CowVector& other) noexcept
+    {
+        using std::swap;
+        swap(_buffer, other._buffer);
+        swap(_allocator, other._allocator);
+    }
+
+    // Returns a copy of the allocator used for new buffers.
+    [[nodiscard]] allocator_type get_allocator() const noexcept
+    {
+        return _allocator;
+    }
+
+    // Returns how many elements are currently stored.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _buffer ? _buffer->size() : 0;
+    }
+
+    // Returns how many elements the current buffer can hold.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return _buffer ? _buffer->capacity() : 0;
+    }
+
+    // Indicates whether the vector contains no elements.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // Returns how many CowVector objects share this one's buffer, or 0 if it has none. Like
+    // std::shared_ptr::use_count(), the value may be stale by the time it is read.
+    [[nodiscard]] long use_count() const noexcept
+    {
+        return _buffer.use_count();
+    }
+
+    // Returns a private copy of the elements as a plain Vector.
+    [[nodiscard]] Buffer to_vector() const
+    {
+        return _buffer ? Buffer(*_buffer) : Buffer(_allocator);
+    }
+
+    // Provides read access to the elements without detaching.
+    const_pointer_type data() const noexcept
+    {
+        return _buffer ? _buffer->data() : nullptr;
+    }
+
+    // Provides write access to the elements, detaching first.
+    pointer_type data()
+    {
+        return _buffer ? unique_buffer().data() : nullptr;
+    }
+
+    // Returns a const reference to the element at the supplied index, throwing if it is out of range.
+    const_reference at(size_type index) const
+    {
+        if (index >= size()) throw std::out_of_range("index out of range");
+        return data()[index];
+    }
+
+    // Returns a reference to the element at the supplied index, throwing if it is out of range;
+    // detaches first.
+    reference at(size_type index)
+    {
+        if (index >= size()) throw std::out_of_range("index out of range");
+        return data()[index];
+    }
+
+    // Returns a const reference to the element at the supplied index without a bounds check.
+    const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < size(), "index out of range");
+        return data()[index];
+    }
+
+    // Returns a reference to the element at the supplied index without a bounds check; detaches first.
+    reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < size(), "index out of range");
+        return data()[index];
+    }
+
+    // Returns a const reference to the first element.
+    const_reference front() const
+    {
+        VECTOR_ASSERT(!empty(), "front() on empty CowVector");
+        return data()[0];
+    }
+
+    // Returns a reference to the first element; detaches first.
+    reference front()
+    {
+        VECTOR_ASSERT(!empty(), "front() on empty CowVector");
+        return data()[0];
+    }
+
+    // Returns a const reference to the last element.
+    const_reference back() const
+    {
+        VECTOR_ASSERT(!empty(), "back() on empty CowVector");
+        return data()[size() - 1];
+    }
+
+    // Returns a reference to the last element; detaches first.
+    reference back()
+    {
+        VECTOR_ASSERT(!empty(), "back() on empty CowVector");
+        return data()[size() - 1];
+    }
+
+    // Removes every element. A shared buffer is simply released rather than copied.
+    void clear() noexcept
+    {
+        if (_buffer && is_unique()) {
+            _buffer->clear();
+        } else {
+            _buffer.reset();
+        }
+    }
+
+    // Appends a copy of value, detaching first.
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    // Appends value by moving it, detaching first.
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    // Constructs an element at the end, detaching first. A detach copies into a buffer that
+    // already has room for the new element.
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        return writable_buffer(1).emplace_back(std::forward<Args>(args)...);
+    }
+
+    // Removes the last element if the vector is not empty, detaching first.
+    void pop_back()
+    {
+        if (!empty()) unique_buffer().pop_back();
+    }
+
+    // Inserts a copy of value before pos, detaching first, and returns an iterator to it.
+    iterator insert(const_iterator pos, const T& value)
+    {
+        return emplace(pos, value);
+    }
+
+    // Inserts value before pos by moving it, detaching first, and returns an iterator to it.
+    iterator insert(const_iterator pos, T&& value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    // Constructs an element from args before pos, detaching first, and returns an iterator to it.
+    // pos may come from the shared buffer; it is translated into the private one.
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args)
+    {
+        const size_type index = index_of(pos);
+        Buffer& buffer = writable_buffer(1);
+        return buffer.emplace(buffer.cbegin() + index, std::forward<Args>(args)...);
+    }
+
+    // Removes the element at pos, detaching first, and returns an iterator to the element that
+    // followed it.
+    iterator erase(const_iterator pos)
+    {
+        VECTOR_ASSERT(pos != cend(), "erase() of end()");
+        return erase(pos, pos + 1);
+    }
+
+    // Removes [first, last), detaching first, and returns an iterator to the element that
+    // followed the range.
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const size_type index = index_of(first);
+        const auto count = static_cast<size_type>(last - first);
+        if (count == 0) return begin() + index;
+        Buffer& buffer = unique_buffer();
+        return buffer.erase(buffer.cbegin() + index, buffer.cbegin() + index + count);
+    }
+
+    // Makes room for new_cap elements in a private buffer.
+    void reserve(size_type new_cap)
+    {
+        if (new_cap <= capacity() && (!_buffer || is_unique())) return;
+        Buffer& buffer = writable_buffer(new_cap > size() ? new_cap - size() : 0);
+        buffer.reserve(new_cap);
+    }
+
+    // Grows or shrinks the vector to new_size in a private buffer.
+    void resize(size_type new_size)
+    {
+        if (new_size == size()) return;
+        writable_buffer(new_size > size() ? new_size - size() : 0).resize(new_size);
+    }
+
+    // Returns a const iterator to the first element.
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(data());
+    }
+
+    // Returns a const iterator one past the last element.
+    const_iterator end() const noexcept
+    {
+        return const_iterator(data() + size());
+    }
+
+    // Returns an iterator to the first element; detaches first.
+    iterator begin()
+    {
+        return iterator(data());
+    }
+
+    // Returns an iterator one past the last element; detaches first.
+    iterator end()
+    {
+        pointer_type first = data();
+        return iterator(first + size());
+    }
+
+    // Returns a const iterator to the first element (C++ standard naming).
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    // Returns a const iterator one past the last element (C++ standard naming).
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // Compares element-wise; vectors sharing a buffer compare equal without visiting it.
+    friend bool operator==(const CowVector& lhs, const CowVector& rhs)
+    {
+        if (lhs._buffer == rhs._buffer) return true;
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    friend class AtomicCowVector<T, Allocator>;
+
+    // Wraps a buffer published through AtomicCowVector.
+    explicit CowVector(std::shared_ptr<Buffer> buffer) noexcept
+        : _buffer(std::move(buffer)), _allocator(_buffer ? _buffer->get_allocator() : Allocator()) {}
+
+    // Whether no other CowVector shares the buffer. Observing a count of one proves every other
+    // owner has released its reference; the fence orders this thread's writes after their
+    // last reads, which use_count()'s relaxed load alone would not.
+    bool is_unique() const noexcept
+    {
+        if (_buffer.use_count() != 1) return false;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+
+    // Returns a buffer this vector owns alone with room for extra more elements, allocating or
+    // detaching as needed. A detach copies the elements once into a buffer sized for the write.
+    Buffer& writable_buffer(size_type extra)
+    {
+        if (!_buffer) {
+            _buffer = std::allocate_shared<Buffer>(buffer_allocator(_allocator), _allocator);
+        } else if (!is_unique()) {
+            auto fresh = std::allocate_shared<Buffer>(buffer_allocator(_allocator), _allocator);
+            fresh->reserve(_buffer->size() + extra);
+            fresh->append_range(*_buffer);
+            _buffer = std::move(fresh);
+        }
+        return *_buffer;
+    }
+
+    // Returns the existing buffer, detached if it was shared.
+    Buffer& unique_buffer()
+    {
+        return writable_buffer(0);
+    }
+
+    size_type index_of(const_iterator pos) const noexcept
+    {
+        return static_cast<size_type>(std::to_address(pos) - data());
+    }
+
+    std::shared_ptr<Buffer> _buffer;
+    [[no_unique_address]] Allocator _allocator;
+};
+
+// Slot through which one thread publishes CowVector snapshots to any number of readers.
+// store() and load() are atomic with respect to each other and only move a reference count, so
+// a reader never sees a half-written snapshot and publishing never copies elements.
+template <typename T, typename Allocator = std::allocator<T>>
+class AtomicCowVector
+{
+    using Buffer = Vector<T, Allocator>;
+
+public:
+    // Constructs a slot holding an empty snapshot.
+    AtomicCowVector() noexcept = default;
+
+    // Constructs a slot holding initial.
+    explicit AtomicCowVector(CowVector<T, Allocator> initial) noexcept
+        : _buffer(std::move(initial._buffer)) {}
+
+    AtomicCowVector(const AtomicCowVector&) = delete;
+    AtomicCowVector& operator=(const AtomicCowVector&) = delete;
+
+    // Replaces the published snapshot; readers that already loaded the old one keep it.
+    void store(CowVector<T, Allocator> snapshot) noexcept
+    {
+        _buffer.store(std::move(snapshot._buffer), std::memory_order_release);
+    }
+
+    // Returns the current snapshot, sharing its buffer.
+    [[nodiscard]] CowVector<T, Allocator> load() const noexcept
+    {
+        return CowVector<T, Allocator>(_buffer.load(std::memory_order_acquire));
+    }
+
+    // Replaces the published snapshot and returns the previous one.
+    CowVector<T, Allocator> exchange(CowVector<T, Allocator> snapshot) noexcept
+    {
+        return CowVector<T, Allocator>(_buffer.exchange(std::move(snapshot._buffer), std::memory_order_acq_rel));
+    }
+
+private:
+    std::atomic<std::shared_ptr<Buffer>> _buffer;
+};
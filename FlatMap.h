@@ -0,0 +1,767 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+// Sorted-Vector associative containers in the style of C++23 std::flat_set and std::flat_map.
+// Keys are kept sorted and unique in one Vector (and, for FlatMap, the mapped values in a
+// parallel Vector), so lookups binary-search contiguous memory and iteration is a linear scan.
+// Inserting or erasing one element shifts the elements after it; batches should go through
+// insert(first, last) or insert_sorted_range(), which merge in one pass.
+//
+// Lookups use a branchless binary search. For read-mostly phases build_lookup_index() also lays
+// the keys out in Eytzinger (breadth-first) order, where each step of the search touches the
+// next cache line predictably and can prefetch the ones after it; any change to the keys drops
+// the index again.
+
+namespace vector_detail {
+
+// Returns the first element of [first, first + count) not ordered before key. The loop body
+// has no data-dependent branch, so it compiles to conditional moves.
+template <typename Key, typename K, typename Compare>
+const Key* branchless_lower_bound(const Key* first, std::size_t count, const K& key, const Compare& compare)
+{
+    if (count == 0) return first;
+    while (count > 1) {
+        const std::size_t half = count / 2;
+        first = compare(first[half], key) ? first + half : first;
+        count -= half;
+    }
+    return first + compare(*first, key);
+}
+
+// Copy of sorted keys in Eytzinger order with each slot's rank in the sorted order.
+template <typename Key, typename Allocator>
+class EytzingerIndex
+{
+    using rank_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::size_t>;
+
+public:
+    // Indicates whether the index holds no keys; an empty index is never consulted.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _keys.empty();
+    }
+
+    // Rebuilds the index from count sorted keys.
+    void build(const Key* sorted, std::size_t count)
+    {
+        // slot k - 1 holds node k of an implicit tree whose children are 2k and 2k + 1; an
+        // in-order walk of that tree visits the sorted keys in order. The slots start out as a
+        // plain copy so that Key need not be default-constructible.
+        Vector<Key, Allocator> slots(sorted, sorted + count);
+        Vector<std::size_t, rank_allocator> ranks;
+        ranks.resize_for_overwrite(count);
+        std::size_t next = 0;
+        fill(slots, ranks, sorted, next, 1, count);
+        _keys = std::move(slots);
+        _ranks = std::move(ranks);
+    }
+
+    // Drops every key.
+    void clear() noexcept
+    {
+        _keys.clear();
+        _ranks.clear();
+    }
+
+    // Returns the sorted rank of the first key not ordered before key, or count if there is none.
+    template <typename K, typename Compare>
+    std::size_t lower_bound_rank(const K& key, const Compare& compare) const
+    {
+        const Key* keys = _keys.data();
+        const std::size_t count = _keys.size();
+        std::size_t k = 1;
+        while (k <= count) {
+#if defined(__GNUC__)
+            __builtin_prefetch(keys + prefetch_stride * k);
+#endif
+            k = 2 * k + compare(keys[k - 1], key);
+        }
+        // undo the trailing right turns; what is left is the last left turn, i.e. the answer
+        k >>= std::countr_one(k) + 1;
+        return k == 0 ? count : _ranks.data()[k - 1];
+    }
+
+private:
+    // Nodes prefetched one level ahead share a cache line once the search is this deep.
+    static constexpr std::size_t prefetch_stride = std::bit_ceil(sizeof(Key) >= 64 ? std::size_t{1} : 64 / sizeof(Key));
+
+    static void fill(Vector<Key, Allocator>& slots, Vector<std::size_t, rank_allocator>& ranks, const Key* sorted,
+                     std::size_t& next, std::size_t k, std::size_t count)
+    {
+        if (k > count) return;
+        fill(slots, ranks, sorted, next, 2 * k, count);
+        slots[k - 1] = sorted[next];
+        ranks[k - 1] = next++;
+        fill(slots, ranks, sorted, next, 2 * k + 1, count);
+    }
+
+    Vector<Key, Allocator> _keys;
+    Vector<std::size_t, rank_allocator> _ranks;
+};
+
+} // namespace vector_detail
+
+// Set of unique keys kept sorted in a Vector.
+template <typename Key, typename Compare = std::less<Key>, typename Allocator = std::allocator<Key>>
+class FlatSet
+{
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using reference = const Key&;
+    using const_reference = const Key&;
+    using iterator = VectorIterator<const Key>;
+    using const_iterator = VectorIterator<const Key>;
+    using container_type = Vector<Key, Allocator>;
+
+    // Constructs an empty set.
+    FlatSet() = default;
+
+    // Constructs an empty set ordered by compare.
+    explicit FlatSet(const Compare& compare, const Allocator& allocator = Allocator())
+        : _keys(allocator), _compare(compare) {}
+
+    // Inserts the elements of [first, last), which need not be sorted.
+    template <std::input_iterator InputIt>
+    FlatSet(InputIt first, InputIt last, const Compare& compare = Compare(), const Allocator& allocator = Allocator())
+        : FlatSet(compare, allocator)
+    {
+        insert(first, last);
+    }
+
+    // Inserts the elements of an initializer list, which need not be sorted.
+    FlatSet(std::initializer_list<Key> init, const Compare& compare = Compare(), const Allocator& allocator = Allocator())
+        : FlatSet(init.begin(), init.end(), compare, allocator) {}
+
+    // Returns how many keys are stored.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _keys.size();
+    }
+
+    // Indicates whether the set is empty.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _keys.empty();
+    }
+
+    // Returns how many keys fit without reallocating.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return _keys.capacity();
+    }
+
+    // Returns the ordering.
+    [[nodiscard]] key_compare key_comp() const
+    {
+        return _compare;
+    }
+
+    // Returns the sorted keys.
+    [[nodiscard]] const container_type& keys() const noexcept
+    {
+        return _keys;
+    }
+
+    // Reserves room for count keys.
+    void reserve(size_type count)
+    {
+        _keys.reserve(count);
+    }
+
+    // Removes every key.
+    void clear() noexcept
+    {
+        _keys.clear();
+        _index.clear();
+    }
+
+    // Inserts key unless an equal one is present; returns its position and whether it was added.
+    std::pair<iterator, bool> insert(const Key& key)
+    {
+        return emplace(key);
+    }
+
+    // Inserts key by moving it unless an equal one is present.
+    std::pair<iterator, bool> insert(Key&& key)
+    {
+        return emplace(std::move(key));
+    }
+
+    // Constructs a key from args and inserts it unless an equal one is present.
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        Key key(std::forward<Args>(args)...);
+        const size_type index = lower_index(key);
+        if (index < size() && !_compare(key, _keys[index])) return {begin() + index, false};
+        _index.clear();
+        _keys.emplace(_keys.cbegin() + index, std::move(key));
+        return {begin() + index, true};
+    }
+
+    // Inserts the keys of [first, last), which need not be sorted, in one merge pass.
+    template <std::input_iterator InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        container_type batch(first, last, _keys.get_allocator());
+        std::stable_sort(batch.begin(), batch.end(), _compare);
+        insert_sorted_range(std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    }
+
+    // Inserts the keys of an initializer list in one merge pass.
+    void insert(std::initializer_list<Key> init)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    // Merges the keys of [first, last), which must be sorted by key_comp(), in one linear pass.
+    // Keys already present, and repeats within the range, are skipped. Existing keys move into
+    // the merged column as it fills, so if anything throws the set is left empty.
+    template <std::input_iterator InputIt>
+    void insert_sorted_range(InputIt first, InputIt last)
+    {
+        if (first == last) return;
+        container_type merged(_keys.get_allocator());
+        try {
+            if constexpr (std::forward_iterator<InputIt>) {
+                merged.reserve(size() + static_cast<size_type>(std::distance(first, last)));
+            }
+            size_type i = 0;
+            auto append_new = [&](auto&& key) {
+                if (merged.empty() || _compare(merged.back(), key)) merged.emplace_back(std::forward<decltype(key)>(key));
+            };
+            for (; first != last; ++first) {
+                decltype(auto) key = *first;
+                while (i < size() && _compare(_keys[i], key)) {
+                    merged.emplace_back(std::move_if_noexcept(_keys[i++]));
+                }
+                if (i < size() && !_compare(key, _keys[i])) continue; // present already
+                append_new(std::forward<decltype(key)>(key));
+            }
+            for (; i < size(); ++i) {
+                merged.emplace_back(std::move_if_noexcept(_keys[i]));
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+        _keys = std::move(merged);
+        _index.clear();
+    }
+
+    // Removes the key at pos and returns an iterator to the key that followed it.
+    iterator erase(const_iterator pos)
+    {
+        _index.clear();
+        return _keys.erase(pos);
+    }
+
+    // Removes the keys in [first, last).
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        _index.clear();
+        return _keys.erase(first, last);
+    }
+
+    // Removes key if present and returns how many keys were removed.
+    size_type erase(const Key& key)
+    {
+        const const_iterator pos = find(key);
+        if (pos == end()) return 0;
+        erase(pos);
+        return 1;
+    }
+
+    // Returns the position of key, or end().
+    [[nodiscard]] const_iterator find(const Key& key) const
+    {
+        const size_type index = lower_index(key);
+        return index < size() && !_compare(key, _keys[index]) ? begin() + index : end();
+    }
+
+    // Returns whether key is present.
+    [[nodiscard]] bool contains(const Key& key) const
+    {
+        return find(key) != end();
+    }
+
+    // Returns 1 if key is present and 0 otherwise.
+    [[nodiscard]] size_type count(const Key& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    // Returns the first key not ordered before key.
+    [[nodiscard]] const_iterator lower_bound(const Key& key) const
+    {
+        return begin() + lower_index(key);
+    }
+
+    // Returns the first key ordered after key.
+    [[nodiscard]] const_iterator upper_bound(const Key& key) const
+    {
+        return std::upper_bound(begin(), end(), key, _compare);
+    }
+
+    // Lays out a copy of the keys in Eytzinger order that lookups use until the keys next
+    // change. Worth it for large sets that are read far more often than written.
+    void build_lookup_index()
+    {
+        _index.build(_keys.data(), _keys.size());
+    }
+
+    // Indicates whether lookups currently go through the Eytzinger index.
+    [[nodiscard]] bool has_lookup_index() const noexcept
+    {
+        return !_index.empty();
+    }
+
+    const_iterator begin() const noexcept { return _keys.cbegin(); }
+    const_iterator end() const noexcept { return _keys.cend(); }
+    const_iterator cbegin() const noexcept { return _keys.cbegin(); }
+    const_iterator cend() const noexcept { return _keys.cend(); }
+
+    // Compares the keys in order.
+    friend bool operator==(const FlatSet& lhs, const FlatSet& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    size_type lower_index(const Key& key) const
+    {
+        if (!_index.empty()) return _index.lower_bound_rank(key, _compare);
+        return static_cast<size_type>(vector_detail::branchless_lower_bound(_keys.data(), _keys.size(), key, _compare) - _keys.data());
+    }
+
+    container_type _keys;
+    [[no_unique_address]] Compare _compare;
+    vector_detail::EytzingerIndex<Key, Allocator> _index;
+};
+
+// Map from unique keys to values, with the keys sorted in one Vector and the values in a
+// parallel Vector at the same positions. Iterators yield std::pair<const Key&, T&> proxies, as
+// with std::flat_map; it->second and structured bindings work as usual. Like std::flat_map's,
+// they are random-access by concept but only input iterators by legacy category, so use the
+// member operators or std::ranges::next/prev rather than std::prev. The const iterator only
+// models std::random_access_iterator where the library provides the C++23 common_reference for
+// pairs of references (libstdc++ 14 and later).
+template <typename Key, typename T, typename Compare = std::less<Key>,
+          typename KeyAllocator = std::allocator<Key>, typename MappedAllocator = std::allocator<T>>
+class FlatMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using size_type = std::size_t;
+    using key_container_type = Vector<Key, KeyAllocator>;
+    using mapped_container_type = Vector<T, MappedAllocator>;
+
+private:
+    template <bool Const>
+    class Iterator
+    {
+        using mapped_pointer = std::conditional_t<Const, const T*, T*>;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::pair<Key, T>;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::pair<const Key&, std::conditional_t<Const, const T&, T&>>;
+
+        // Holds a dereferenced element so that operator-> can return its address.
+        struct pointer {
+            reference element;
+            const reference* operator->() const noexcept { return &element; }
+        };
+
+        // Creates an iterator that does not point to any element.
+        Iterator() noexcept = default;
+
+        // Creates an iterator to the element whose key and value are at the given addresses.
+        Iterator(const Key* key, mapped_pointer mapped) noexcept
+            : _key(key), _mapped(mapped) {}
+
+        // Converts an iterator over mutable values into one over const values.
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        Iterator(const Iterator<OtherConst>& other) noexcept
+            : _key(other._key), _mapped(other._mapped) {}
+
+        reference operator*() const noexcept { return reference(*_key, *_mapped); }
+        pointer operator->() const noexcept { return pointer{**this}; }
+        reference operator[](difference_type offset) const noexcept { return *(*this + offset); }
+
+        Iterator& operator++() noexcept { ++_key; ++_mapped; return *this; }
+        Iterator operator++(int) noexcept { Iterator old = *this; ++*this; return old; }
+        Iterator& operator--() noexcept { --_key; --_mapped; return *this; }
+        Iterator operator--(int) noexcept { Iterator old = *this; --*this; return old; }
+        Iterator& operator+=(difference_type offset) noexcept { _key += offset; _mapped += offset; return *this; }
+        Iterator& operator-=(difference_type offset) noexcept { _key -= offset; _mapped -= offset; return *this; }
+
+        friend Iterator operator+(Iterator it, difference_type offset) noexcept { return it += offset; }
+        friend Iterator operator+(difference_type offset, Iterator it) noexcept { return it += offset; }
+        friend Iterator operator-(Iterator it, difference_type offset) noexcept { return it -= offset; }
+        friend difference_type operator-(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs._key - rhs._key; }
+        friend bool operator==(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs._key == rhs._key; }
+        friend std::strong_ordering operator<=>(const Iterator& lhs, const Iterator& rhs) noexcept { return lhs._key <=> rhs._key; }
+
+    private:
+        friend class FlatMap;
+        template <bool>
+        friend class Iterator;
+
+        const Key* _key = nullptr;
+        mapped_pointer _mapped = nullptr;
+    };
+
+public:
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    // Constructs an empty map.
+    FlatMap() = default;
+
+    // Constructs an empty map ordered by compare.
+    explicit FlatMap(const Compare& compare, const KeyAllocator& key_allocator = KeyAllocator(),
+                     const MappedAllocator& mapped_allocator = MappedAllocator())
+        : _keys(key_allocator), _values(mapped_allocator), _compare(compare) {}
+
+    // Inserts the pairs of [first, last), which need not be sorted; the first of equal keys wins.
+    template <std::input_iterator InputIt>
+    FlatMap(InputIt first, InputIt last, const Compare& compare = Compare())
+        : FlatMap(compare)
+    {
+        insert(first, last);
+    }
+
+    // Inserts the pairs of an initializer list, which need not be sorted.
+    FlatMap(std::initializer_list<value_type> init, const Compare& compare = Compare())
+        : FlatMap(init.begin(), init.end(), compare) {}
+
+    // Returns how many elements are stored.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _keys.size();
+    }
+
+    // Indicates whether the map is empty.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _keys.empty();
+    }
+
+    // Returns how many elements fit without reallocating either column.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return std::min(_keys.capacity(), _values.capacity());
+    }
+
+    // Returns the ordering of keys.
+    [[nodiscard]] key_compare key_comp() const
+    {
+        return _compare;
+    }
+
+    // Returns the sorted keys.
+    [[nodiscard]] const key_container_type& keys() const noexcept
+    {
+        return _keys;
+    }
+
+    // Returns the values, in the order of keys().
+    [[nodiscard]] const mapped_container_type& values() const noexcept
+    {
+        return _values;
+    }
+
+    // Reserves room for count elements in both columns.
+    void reserve(size_type count)
+    {
+        _keys.reserve(count);
+        _values.reserve(count);
+    }
+
+    // Removes every element.
+    void clear() noexcept
+    {
+        _keys.clear();
+        _values.clear();
+        _index.clear();
+    }
+
+    // Returns the value for key, throwing std::out_of_range if it is absent.
+    T& at(const Key& key)
+    {
+        const size_type index = find_index(key);
+        if (index == size()) throw std::out_of_range("key not found");
+        return _values[index];
+    }
+
+    // Returns the value for key, throwing std::out_of_range if it is absent.
+    const T& at(const Key& key) const
+    {
+        const size_type index = find_index(key);
+        if (index == size()) throw std::out_of_range("key not found");
+        return _values[index];
+    }
+
+    // Returns the value for key, inserting a value-initialized one if it is absent.
+    T& operator[](const Key& key)
+    {
+        return try_emplace(key).first->second;
+    }
+
+    // Inserts value unless its key is present; returns its position and whether it was added.
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+        return try_emplace(value.first, value.second);
+    }
+
+    // Inserts value by moving it unless its key is present.
+    std::pair<iterator, bool> insert(value_type&& value)
+    {
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    // Constructs a pair from args and inserts it unless its key is present.
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(Args&&... args)
+    {
+        value_type value(std::forward<Args>(args)...);
+        return try_emplace(std::move(value.first), std::move(value.second));
+    }
+
+    // Inserts a value constructed from args under key unless key is present, in which case
+    // args are left untouched.
+    template <typename K, typename... Args>
+        requires std::is_constructible_v<Key, K&&>
+    std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+    {
+        const size_type index = lower_index(key);
+        if (index < size() && !_compare(key, _keys[index])) return {begin() + index, false};
+        insert_at(index, std::forward<K>(key), std::forward<Args>(args)...);
+        return {begin() + index, true};
+    }
+
+    // Stores value under key, inserting or overwriting, and returns whether it was inserted.
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& value)
+    {
+        const size_type index = lower_index(key);
+        if (index < size() && !_compare(key, _keys[index])) {
+            _values[index] = std::forward<M>(value);
+            return {begin() + index, false};
+        }
+        insert_at(index, key, std::forward<M>(value));
+        return {begin() + index, true};
+    }
+
+    // Inserts the pairs of [first, last), which need not be sorted, in one merge pass; the first
+    // of equal keys wins and keys already present keep their values.
+    template <std::input_iterator InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        Vector<value_type> batch(first, last);
+        std::stable_sort(batch.begin(), batch.end(),
+                         [&](const value_type& lhs, const value_type& rhs) { return _compare(lhs.first, rhs.first); });
+        insert_sorted_range(std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+    }
+
+    // Inserts the pairs of an initializer list in one merge pass.
+    void insert(std::initializer_list<value_type> init)
+    {
+        insert(init.begin(), init.end());
+    }
+
+    // Merges the pairs of [first, last), which must be sorted by key, in one linear pass. Keys
+    // already present keep their values, and of repeated keys within the range the first wins.
+    // Existing elements move into the merged columns as they fill, so if anything throws the map
+    // is left empty.
+    template <std::input_iterator InputIt>
+    void insert_sorted_range(InputIt first, InputIt last)
+    {
+        if (first == last) return;
+        key_container_type keys(_keys.get_allocator());
+        mapped_container_type values(_values.get_allocator());
+        try {
+            if constexpr (std::forward_iterator<InputIt>) {
+                const size_type total = size() + static_cast<size_type>(std::distance(first, last));
+                keys.reserve(total);
+                values.reserve(total);
+            }
+            size_type i = 0;
+            auto keep_existing = [&] {
+                keys.emplace_back(std::move_if_noexcept(_keys[i]));
+                values.emplace_back(std::move_if_noexcept(_values[i]));
+                ++i;
+            };
+            for (; first != last; ++first) {
+                // members are moved only out of elements the iterator yields as rvalues
+                decltype(auto) element = *first;
+                const auto& key = std::get<0>(element);
+                while (i < size() && _compare(_keys[i], key)) {
+                    keep_existing();
+                }
+                if (i < size() && !_compare(key, _keys[i])) continue; // present already
+                if (!keys.empty() && !_compare(keys.back(), key)) continue; // repeated within the range
+                keys.emplace_back(std::get<0>(std::forward<decltype(element)>(element)));
+                values.emplace_back(std::get<1>(std::forward<decltype(element)>(element)));
+            }
+            while (i < size()) {
+                keep_existing();
+            }
+        } catch (...) {
+            clear();
+            throw;
+        }
+        _keys = std::move(keys);
+        _values = std::move(values);
+        _index.clear();
+    }
+
+    // Removes the element at pos and returns an iterator to the element that followed it.
+    iterator erase(const_iterator pos)
+    {
+        return erase(pos, pos + 1);
+    }
+
+    // Removes the elements in [first, last).
+    iterator erase(const_iterator first, const_iterator last)
+    {
+        const auto index = static_cast<size_type>(first._key - _keys.data());
+        const auto count = static_cast<size_type>(last - first);
+        _keys.erase(_keys.cbegin() + index, _keys.cbegin() + index + count);
+        _values.erase(_values.cbegin() + index, _values.cbegin() + index + count);
+        _index.clear();
+        return begin() + index;
+    }
+
+    // Removes key if present and returns how many elements were removed.
+    size_type erase(const Key& key)
+    {
+        const size_type index = find_index(key);
+        if (index == size()) return 0;
+        erase(cbegin() + index);
+        return 1;
+    }
+
+    // Returns the element with key, or end().
+    [[nodiscard]] iterator find(const Key& key)
+    {
+        return begin() + find_index(key);
+    }
+
+    // Returns the element with key, or end().
+    [[nodiscard]] const_iterator find(const Key& key) const
+    {
+        return begin() + find_index(key);
+    }
+
+    // Returns whether key is present.
+    [[nodiscard]] bool contains(const Key& key) const
+    {
+        return find_index(key) != size();
+    }
+
+    // Returns 1 if key is present and 0 otherwise.
+    [[nodiscard]] size_type count(const Key& key) const
+    {
+        return contains(key) ? 1 : 0;
+    }
+
+    // Returns the first element whose key is not ordered before key.
+    [[nodiscard]] const_iterator lower_bound(const Key& key) const
+    {
+        return begin() + lower_index(key);
+    }
+
+    // Returns the first element whose key is ordered after key.
+    [[nodiscard]] const_iterator upper_bound(const Key& key) const
+    {
+        const auto position = std::upper_bound(_keys.begin(), _keys.end(), key, _compare);
+        return begin() + (position - _keys.begin());
+    }
+
+    // Lays out a copy of the keys in Eytzinger order that lookups use until the keys next
+    // change; assigning through iterators or at() only touches values and keeps it.
+    void build_lookup_index()
+    {
+        _index.build(_keys.data(), _keys.size());
+    }
+
+    // Indicates whether lookups currently go through the Eytzinger index.
+    [[nodiscard]] bool has_lookup_index() const noexcept
+    {
+        return !_index.empty();
+    }
+
+    iterator begin() noexcept { return iterator(_keys.data(), _values.data()); }
+    iterator end() noexcept { return begin() + static_cast<std::ptrdiff_t>(size()); }
+    const_iterator begin() const noexcept { return const_iterator(_keys.data(), _values.data()); }
+    const_iterator end() const noexcept { return begin() + static_cast<std::ptrdiff_t>(size()); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Compares keys and values in order.
+    friend bool operator==(const FlatMap& lhs, const FlatMap& rhs)
+    {
+        return std::equal(lhs._keys.begin(), lhs._keys.end(), rhs._keys.begin(), rhs._keys.end()) &&
+            std::equal(lhs._values.begin(), lhs._values.end(), rhs._values.begin());
+    }
+
+private:
+    size_type lower_index(const Key& key) const
+    {
+        if (!_index.empty()) return _index.lower_bound_rank(key, _compare);
+        return static_cast<size_type>(vector_detail::branchless_lower_bound(_keys.data(), _keys.size(), key, _compare) - _keys.data());
+    }
+
+    // Position of key, or size() if it is absent.
+    size_type find_index(const Key& key) const
+    {
+        const size_type index = lower_index(key);
+        return index < size() && !_compare(key, _keys[index]) ? index : size();
+    }
+
+    // Inserts key and a value built from args at index in both columns, or in neither.
+    template <typename K, typename... Args>
+    void insert_at(size_type index, K&& key, Args&&... args)
+    {
+        _keys.emplace(_keys.cbegin() + index, std::forward<K>(key));
+        try {
+            _values.emplace(_values.cbegin() + index, std::forward<Args>(args)...);
+        } catch (...) {
+            _keys.erase(_keys.cbegin() + index);
+            throw;
+        }
+        _index.clear();
+    }
+
+    key_container_type _keys;
+    mapped_container_type _values;
+    [[no_unique_address]] Compare _compare;
+    vector_detail::EytzingerIndex<Key, KeyAllocator> _index;
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+
+// Growth policies decide how far Vector's capacity jumps when it runs out of room.
+// A policy is any type with
+//     static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size)
+// returning a capacity of at least required elements.
+
+#if defined(__GNUC__) && !defined(_WIN32)
+// Provided by jemalloc and tcmalloc; null when neither is linked in.
+extern "C" std::size_t nallocx(std::size_t size, int flags) __attribute__((weak));
+#endif
+
+namespace growth_detail {
+
+// Largest element count whose byte size still fits in size_t.
+constexpr std::size_t max_elements(std::size_t element_size) noexcept
+{
+    return std::numeric_limits<std::size_t>::max() / element_size;
+}
+
+// Scales capacity by Numerator / Denominator, saturating instead of overflowing.
+template <std::size_t Numerator, std::size_t Denominator>
+constexpr std::size_t scale(std::size_t capacity, std::size_t element_size) noexcept
+{
+    const std::size_t limit = max_elements(element_size);
+    if (capacity > limit / Numerator) return limit;
+    return capacity * Numerator / Denominator;
+}
+
+// Returns the first capacity to allocate so that it fills at least minimum_bytes.
+constexpr std::size_t initial_capacity(std::size_t minimum_bytes, std::size_t element_size) noexcept
+{
+    const std::size_t elements = minimum_bytes / element_size;
+    return elements > 0 ? elements : 1;
+}
+
+// Applies the geometric rule shared by the shipped policies.
+template <std::size_t Numerator, std::size_t Denominator, std::size_t MinimumBytes>
+constexpr std::size_t geometric(std::size_t capacity, std::size_t required, std::size_t element_size) noexcept
+{
+    std::size_t next = capacity == 0
+        ? initial_capacity(MinimumBytes, element_size)
+        : scale<Numerator, Denominator>(capacity, element_size);
+    if (next <= capacity) next = capacity + 1; // small factors must still make progress
+    return next < required ? required : next;
+}
+
+// Estimates how many usable bytes malloc hands back for a request of this many bytes. When
+// jemalloc or tcmalloc is linked in its nallocx() answers; otherwise this follows what
+// malloc_usable_size() reports rather than inventing size classes the allocator does not have.
+inline std::size_t allocator_size_class(std::size_t bytes) noexcept
+{
+#if defined(__GNUC__) && !defined(_WIN32)
+    if (nallocx != nullptr && bytes > 0) {
+        // 0 means the request is too large to serve at all
+        const std::size_t rounded = nallocx(bytes, 0);
+        if (rounded >= bytes) return rounded;
+    }
+#endif
+    constexpr std::size_t word = sizeof(std::size_t);
+    constexpr std::size_t alignment = 2 * word;
+    if (bytes > std::numeric_limits<std::size_t>::max() - alignment - word) return bytes;
+#if defined(__GLIBC__)
+    // a chunk is the request plus its size word, rounded to the alignment; the next chunk's size
+    // word is usable too, and the smallest chunk holds three words
+    const std::size_t usable = (bytes + word + alignment - 1) / alignment * alignment - word;
+    return usable > 3 * word ? usable : 3 * word;
+#else
+    return (bytes + alignment - 1) / alignment * alignment;
+#endif
+}
+
+} // namespace growth_detail
+
+// Grows 0 -> 1 -> 2 -> 4 ..., the classic doubling Vector has always used.
+struct DoublingGrowth
+{
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size) noexcept
+    {
+        const std::size_t next = capacity == 0 ? 1 : growth_detail::scale<2, 1>(capacity, element_size);
+        return next < required ? required : next;
+    }
+};
+
+// Multiplies capacity by Numerator / Denominator, starting from a block of at least MinimumBytes
+// so short vectors skip the run of 1, 2 and 4 element allocations.
+template <std::size_t Numerator, std::size_t Denominator, std::size_t MinimumBytes = 64>
+struct GeometricGrowth
+{
+    static_assert(Numerator > Denominator && Denominator > 0, "GeometricGrowth needs a factor above one");
+
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size) noexcept
+    {
+        return growth_detail::geometric<Numerator, Denominator, MinimumBytes>(capacity, required, element_size);
+    }
+};
+
+using Growth2x = GeometricGrowth<2, 1>;
+using Growth1_5x = GeometricGrowth<3, 2>;
+
+// Grows geometrically until a single step would exceed MaxStepBytes, then grows linearly by
+// that much, bounding the over-allocation of very large buffers.
+template <std::size_t MaxStepBytes, std::size_t Numerator = 2, std::size_t Denominator = 1, std::size_t MinimumBytes = 64>
+struct CappedGrowth
+{
+    static_assert(MaxStepBytes > 0, "CappedGrowth needs a positive step cap");
+
+    static constexpr std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size) noexcept
+    {
+        std::size_t next = growth_detail::geometric<Numerator, Denominator, MinimumBytes>(capacity, capacity + 1, element_size);
+        const std::size_t max_step = MaxStepBytes / element_size > 0 ? MaxStepBytes / element_size : 1;
+        if (next - capacity > max_step) next = capacity + max_step;
+        return next < required ? required : next;
+    }
+};
+
+// Rounds another policy's choice up to the allocator's size class so the bytes malloc would
+// waste as padding become usable capacity instead.
+template <typename Base = Growth2x>
+struct SizeClassGrowth
+{
+    static std::size_t next_capacity(std::size_t capacity, std::size_t required, std::size_t element_size) noexcept
+    {
+        const std::size_t next = Base::next_capacity(capacity, required, element_size);
+        if (next > growth_detail::max_elements(element_size)) return next; // next * element_size overflows
+        const std::size_t rounded = growth_detail::allocator_size_class(next * element_size) / element_size;
+        return rounded > next ? rounded : next;
+    }
+};
@@ -0,0 +1,484 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+// Vector-like sequence that spreads reallocation over later appends, the way incremental
+// rehashing spreads a hash table's resize. When the buffer fills, a larger one is allocated and
+// the new element goes straight into it; the old elements then migrate a batch per push_back,
+// and operator[] resolves each index to whichever buffer currently holds it. No single append
+// moves more than one batch, however large the container, at the cost of a branch per access
+// and both buffers being alive until migration finishes.
+//
+// Vector itself keeps a single buffer because data(), contiguous iterators and every span over
+// it depend on that; this is the container to use when the stall matters more than contiguity.
+// data() is still available here and finishes any pending migration first.
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class IncrementalVector
+{
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                  "IncrementalVector requires Allocator::value_type to match T");
+    static_assert(std::is_same_v<typename alloc_traits::pointer, T*>,
+                  "IncrementalVector requires an allocator with raw pointers");
+
+    static constexpr bool trivial_relocate =
+        is_trivially_relocatable_v<T> &&
+        vector_detail::uses_default_construct<Allocator, T> &&
+        vector_detail::uses_default_destroy<Allocator, T>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = IndexIterator<IncrementalVector, T>;
+    using const_iterator = IndexIterator<const IncrementalVector, const T>;
+
+    // Fewest elements migrated per append; about four cache lines, so each append stays cheap
+    // while migration still finishes long before the new buffer fills.
+    static constexpr size_type migration_batch = sizeof(T) >= 256 ? 1 : 256 / sizeof(T);
+
+    // Constructs an empty vector with zero capacity.
+    IncrementalVector() noexcept(noexcept(Allocator()))
+        : _allocator() {}
+
+    // Constructs an empty vector that allocates from the given allocator.
+    explicit IncrementalVector(const Allocator& allocator) noexcept
+        : _allocator(allocator) {}
+
+    // Copies the elements of an initializer list.
+    IncrementalVector(std::initializer_list<T> init, const Allocator& allocator = Allocator())
+        : IncrementalVector(allocator)
+    {
+        reserve(init.size());
+        for (const T& value : init) {
+            push_back(value);
+        }
+    }
+
+    // Copies elements from another vector into one buffer of exactly the right size.
+    IncrementalVector(const IncrementalVector& other)
+        : IncrementalVector(alloc_traits::select_on_container_copy_construction(other._allocator))
+    {
+        copy_from(other);
+    }
+
+    // Takes ownership of both of another vector's buffers, mid-migration or not.
+    IncrementalVector(IncrementalVector&& other) noexcept
+        : _allocator(std::move(other._allocator))
+    {
+        steal(other);
+    }
+
+    // Assigns from another vector by making a deep copy.
+    IncrementalVector& operator=(const IncrementalVector& other)
+    {
+        if (this != &other) {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (!alloc_traits::is_always_equal::value && _allocator != other._allocator) {
+                    release();
+                }
+                _allocator = other._allocator;
+            }
+            clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    // Takes another vector's buffers if the allocators allow it, otherwise moves each element.
+    IncrementalVector& operator=(IncrementalVector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value)
+    {
+        if (this != &other) {
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                release();
+                _allocator = std::move(other._allocator);
+                steal(other);
+            } else if (alloc_traits::is_always_equal::value || _allocator == other._allocator) {
+                release();
+                steal(other);
+            } else {
+                // buffers cannot change hands, so the elements move one by one
+                clear();
+                reserve(other._size);
+                for (size_type i = 0; i < other._size; ++i) {
+                    emplace_back(std::move(other.element(i)));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // Exchanges all with another vector.
+    void swap(IncrementalVector& other) noexcept
+    {
+        using std::swap;
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            swap(_allocator, other._allocator);
+        }
+        swap(_data, other._data);
+        swap(_capacity, other._capacity);
+        swap(_size, other._size);
+        swap(_old, other._old);
+        swap(_old_capacity, other._old_capacity);
+        swap(_migrated, other._migrated);
+        swap(_old_end, other._old_end);
+        swap(_step, other._step);
+    }
+
+    // Destroys every element and frees both buffers.
+    ~IncrementalVector()
+    {
+        release();
+    }
+
+    // Returns a copy of the allocator used for element storage.
+    [[nodiscard]] allocator_type get_allocator() const noexcept
+    {
+        return _allocator;
+    }
+
+    // Returns how many elements are currently stored.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // Returns how many elements fit before the next buffer is allocated.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    // Indicates whether the vector contains no elements.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // Indicates whether some elements still live in the previous buffer.
+    [[nodiscard]] bool migrating() const noexcept
+    {
+        return _old != nullptr;
+    }
+
+    // Returns a reference to the element at the supplied index, throwing if it is out of range.
+    reference at(size_type index)
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return element(index);
+    }
+
+    // Returns a const reference to the element at the supplied index, throwing if it is out of range.
+    const_reference at(size_type index) const
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return element(index);
+    }
+
+    // Returns a reference to the element at the supplied index without a bounds check.
+    reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return element(index);
+    }
+
+    // Returns a const reference to the element at the supplied index without a bounds check.
+    const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return element(index);
+    }
+
+    // Returns a reference to the first element.
+    reference front()
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty IncrementalVector");
+        return element(0);
+    }
+
+    // Returns a const reference to the first element.
+    const_reference front() const
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty IncrementalVector");
+        return element(0);
+    }
+
+    // Returns a reference to the last element.
+    reference back()
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty IncrementalVector");
+        return element(_size - 1);
+    }
+
+    // Returns a const reference to the last element.
+    const_reference back() const
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty IncrementalVector");
+        return element(_size - 1);
+    }
+
+    // Finishes any pending migration and returns the single buffer holding every element.
+    T* data()
+    {
+        finish_migration();
+        return _data;
+    }
+
+    // Appends a copy of value.
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    // Appends value by moving it.
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    // Constructs an element at the end, then migrates one batch if a migration is pending; args
+    // may refer to an element. If anything throws, no element has been appended and every element
+    // is still reachable.
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        if constexpr (trivial_relocate || std::is_nothrow_move_constructible_v<T>) {
+            // migration cannot throw, so the element goes in before any old element moves
+            if (_size == _capacity) {
+                grow();
+            }
+            T* slot = _data + _size;
+            alloc_traits::construct(_allocator, slot, std::forward<Args>(args)...);
+            ++_size;
+            if (_old) {
+                migrate(_step);
+            }
+            return *slot;
+        } else {
+            // migration copies and may throw, so args are read into a value first
+            T value(std::forward<Args>(args)...);
+            if (_size == _capacity) {
+                grow();
+            }
+            if (_old) {
+                migrate(_step);
+            }
+            T* slot = _data + _size;
+            alloc_traits::construct(_allocator, slot, std::move(value));
+            ++_size;
+            return *slot;
+        }
+    }
+
+    // Destroys the last element, if any.
+    void pop_back()
+    {
+        if (_size == 0) return;
+        const size_type last = --_size;
+        alloc_traits::destroy(_allocator, &element(last));
+        if (in_old(last)) {
+            // the not-yet-migrated range simply gets shorter
+            _old_end = last;
+            if (_migrated == _old_end) release_old();
+        }
+    }
+
+    // Destroys every element, keeping the current buffer.
+    void clear() noexcept
+    {
+        for (size_type i = 0; i < _size; ++i) {
+            alloc_traits::destroy(_allocator, &element(i));
+        }
+        release_old();
+        _size = 0;
+    }
+
+    // Grows capacity to at least new_cap in one step. Unlike growth on append this moves every
+    // element now, so call it before the latency-sensitive phase.
+    void reserve(size_type new_cap)
+    {
+        if (new_cap <= _capacity) return;
+        finish_migration();
+        auto [buffer, allocated] = allocate_storage(new_cap);
+        try {
+            relocate(buffer, _data, _size);
+        } catch (...) {
+            alloc_traits::deallocate(_allocator, buffer, allocated);
+            throw;
+        }
+        if (_data) alloc_traits::deallocate(_allocator, _data, _capacity);
+        _data = buffer;
+        _capacity = allocated;
+    }
+
+    // Moves every element still in the previous buffer and frees it.
+    void finish_migration()
+    {
+        if (_old) migrate(_old_end - _migrated);
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, _size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, _size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Compares element-wise.
+    friend bool operator==(const IncrementalVector& lhs, const IncrementalVector& rhs)
+    {
+        return lhs._size == rhs._size && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+private:
+    // Indicates whether index is in [_migrated, _old_end), the part still in the old buffer.
+    bool in_old(size_type index) const noexcept
+    {
+        return index - _migrated < _old_end - _migrated;
+    }
+
+    T& element(size_type index) const noexcept
+    {
+        return in_old(index) ? _old[index] : _data[index];
+    }
+
+    // Switches to a larger buffer; the existing elements stay where they are for now.
+    void grow()
+    {
+        finish_migration(); // only left over if an earlier migration step threw
+        auto [buffer, allocated] = allocate_storage(GrowthPolicy::next_capacity(_capacity, _size + 1, sizeof(T)));
+        if (_size == 0) {
+            if (_data) alloc_traits::deallocate(_allocator, _data, _capacity);
+        } else {
+            _old = _data;
+            _old_capacity = _capacity;
+            _migrated = 0;
+            _old_end = _size;
+            // enough per append that the old buffer is empty before the new one fills
+            const size_type room = allocated - _size;
+            const size_type needed = (_size + room - 1) / room;
+            _step = needed > migration_batch ? needed : migration_batch;
+        }
+        _data = buffer;
+        _capacity = allocated;
+    }
+
+    // Moves up to count pending elements into the current buffer; frees the old one when done.
+    void migrate(size_type count)
+    {
+        const size_type pending = _old_end - _migrated;
+        if (count > pending) count = pending;
+        if constexpr (trivial_relocate) {
+            std::memcpy(static_cast<void*>(_data + _migrated), _old + _migrated, count * sizeof(T));
+            _migrated += count;
+        } else {
+            // one element at a time, so a throwing copy leaves every element reachable
+            for (const size_type end = _migrated + count; _migrated < end; ++_migrated) {
+                alloc_traits::construct(_allocator, _data + _migrated, std::move_if_noexcept(_old[_migrated]));
+                alloc_traits::destroy(_allocator, _old + _migrated);
+            }
+        }
+        if (_migrated == _old_end) release_old();
+    }
+
+    // Moves count elements from source into raw storage at destination in one pass; on a throw
+    // the source is untouched and nothing is left constructed at destination.
+    void relocate(T* destination, T* source, size_type count)
+    {
+        if constexpr (trivial_relocate) {
+            if (count > 0) std::memcpy(static_cast<void*>(destination), source, count * sizeof(T));
+        } else {
+            size_type i = 0;
+            try {
+                for (; i < count; ++i) {
+                    alloc_traits::construct(_allocator, destination + i, std::move_if_noexcept(source[i]));
+                }
+            } catch (...) {
+                for (size_type j = 0; j < i; ++j) {
+                    alloc_traits::destroy(_allocator, destination + j);
+                }
+                throw;
+            }
+            for (i = 0; i < count; ++i) {
+                alloc_traits::destroy(_allocator, source + i);
+            }
+        }
+    }
+
+    // Allocates room for at least n elements, returning the buffer and its usable capacity.
+    std::pair<T*, size_type> allocate_storage(size_type n)
+    {
+        if constexpr (vector_detail::has_allocate_at_least<Allocator, T>) {
+            auto result = _allocator.allocate_at_least(n);
+            return {result.ptr, result.count};
+        } else {
+            return {alloc_traits::allocate(_allocator, n), n};
+        }
+    }
+
+    void copy_from(const IncrementalVector& other)
+    {
+        reserve(other._size);
+        for (size_type i = 0; i < other._size; ++i) {
+            push_back(other.element(i));
+        }
+    }
+
+    // Frees the previous buffer; every element it held must already be gone.
+    void release_old() noexcept
+    {
+        if (_old) alloc_traits::deallocate(_allocator, _old, _old_capacity);
+        _old = nullptr;
+        _old_capacity = _migrated = _old_end = 0;
+    }
+
+    void release() noexcept
+    {
+        clear();
+        if (_data) alloc_traits::deallocate(_allocator, _data, _capacity);
+        _data = nullptr;
+        _capacity = 0;
+    }
+
+    // Adopts other's buffers, leaving it empty; the allocators must already compare equal.
+    void steal(IncrementalVector& other) noexcept
+    {
+        _data = std::exchange(other._data, nullptr);
+        _capacity = std::exchange(other._capacity, 0);
+        _size = std::exchange(other._size, 0);
+        _old = std::exchange(other._old, nullptr);
+        _old_capacity = std::exchange(other._old_capacity, 0);
+        _migrated = std::exchange(other._migrated, 0);
+        _old_end = std::exchange(other._old_end, 0);
+        _step = other._step;
+    }
+
+    [[no_unique_address]] Allocator _allocator;
+    T* _data = nullptr;
+    size_type _capacity = 0;
+    size_type _size = 0;
+    // Previous buffer while migrating; elements [_migrated, _old_end) still live in it.
+    T* _old = nullptr;
+    size_type _old_capacity = 0;
+    size_type _migrated = 0;
+    size_type _old_end = 0;
+    // Elements migrated per append during the current migration.
+    size_type _step = migration_batch;
+};
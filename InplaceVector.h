@@ -0,0 +1,617 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+// Vector with a fixed capacity of N elements stored inside the object, following C++26
+// std::inplace_vector: it never allocates, and growing past N throws std::bad_alloc from the
+// throwing members or returns nullptr from the try_ ones. Every member is constexpr. Trivial
+// elements live in a plain array, which keeps the whole vector trivially copyable and lets a
+// filled vector be a constant, e.g. a lookup table computed at compile time; other elements
+// live in a union, so slots past size() hold no object.
+template <typename T, std::size_t N>
+class InplaceVector
+{
+    static constexpr bool trivial =
+        std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T>;
+
+    struct ArrayStorage {
+        T elements[N > 0 ? N : 1];
+    };
+    union UnionStorage {
+        constexpr UnionStorage() noexcept {}
+        constexpr ~UnionStorage() {}
+        T elements[N > 0 ? N : 1];
+    };
+    using Storage = std::conditional_t<trivial, ArrayStorage, UnionStorage>;
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using pointer_type = T*;
+    using const_pointer_type = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = VectorIterator<T>;
+    using const_iterator = VectorIterator<const T>;
+
+    // Constructs an empty vector.
+    constexpr InplaceVector() noexcept
+    {
+        if constexpr (trivial) {
+            // a constant must not contain uninitialized bytes; at run time the slots stay unwritten
+            if consteval {
+                std::ranges::fill(_storage.elements, T());
+            }
+        }
+    }
+
+    // Constructs count value-initialized elements, throwing std::bad_alloc if count exceeds N.
+    constexpr explicit InplaceVector(size_type count)
+        : InplaceVector()
+    {
+        resize(count);
+    }
+
+    // Constructs count copies of value, throwing std::bad_alloc if count exceeds N.
+    constexpr InplaceVector(size_type count, const T& value)
+        : InplaceVector()
+    {
+        assign(count, value);
+    }
+
+    // Copies the elements of [first, last), throwing std::bad_alloc if there are more than N.
+    template <std::input_iterator InputIt>
+    constexpr InplaceVector(InputIt first, InputIt last)
+        : InplaceVector()
+    {
+        assign(first, last);
+    }
+
+    // Copies the elements of an initializer list, throwing std::bad_alloc if there are more than N.
+    constexpr InplaceVector(std::initializer_list<T> init)
+        : InplaceVector(init.begin(), init.end()) {}
+
+    constexpr InplaceVector(const InplaceVector&) requires trivial = default;
+
+    // Copies the elements of another vector.
+    constexpr InplaceVector(const InplaceVector& other)
+        : InplaceVector()
+    {
+        assign(other.begin(), other.end());
+    }
+
+    constexpr InplaceVector(InplaceVector&&) requires trivial = default;
+
+    // Moves the elements of another vector one by one; other keeps its size with moved-from elements.
+    constexpr InplaceVector(InplaceVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : InplaceVector()
+    {
+        for (T& value : other) {
+            unchecked_emplace_back(std::move(value));
+        }
+    }
+
+    constexpr InplaceVector& operator=(const InplaceVector&) requires trivial = default;
+
+    // Replaces the contents with copies of another vector's elements.
+    constexpr InplaceVector& operator=(const InplaceVector& other)
+    {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    constexpr InplaceVector& operator=(InplaceVector&&) requires trivial = default;
+
+    // Replaces the contents by moving another vector's elements.
+    constexpr InplaceVector& operator=(InplaceVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        if (this != &other) {
+            clear();
+            for (T& value : other) {
+                unchecked_emplace_back(std::move(value));
+            }
+        }
+        return *this;
+    }
+
+    // Replaces the contents with the elements of an initializer list.
+    constexpr InplaceVector& operator=(std::initializer_list<T> init)
+    {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    constexpr ~InplaceVector() requires trivial = default;
+
+    // Destroys every element.
+    constexpr ~InplaceVector()
+    {
+        clear();
+    }
+
+    // Exchanges elements with another vector, element by element.
+    constexpr void swap(InplaceVector& other) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>)
+    {
+        InplaceVector& shorter = _size < other._size ? *this : other;
+        InplaceVector& longer = _size < other._size ? other : *this;
+        const size_type common = shorter._size;
+        const size_type total = longer._size;
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        for (size_type i = common; i < total; ++i) {
+            shorter.unchecked_emplace_back(std::move(longer.slots()[i]));
+        }
+        longer.destroy_range(common, total);
+        longer._size = common;
+    }
+
+    // Returns how many elements are currently stored.
+    [[nodiscard]] constexpr size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // Returns the fixed number of elements the vector can hold.
+    [[nodiscard]] static constexpr size_type capacity() noexcept
+    {
+        return N;
+    }
+
+    // Returns the fixed number of elements the vector can hold.
+    [[nodiscard]] static constexpr size_type max_size() noexcept
+    {
+        return N;
+    }
+
+    // Indicates whether the vector contains no elements.
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // Indicates whether another element would not fit.
+    [[nodiscard]] constexpr bool full() const noexcept
+    {
+        return _size == N;
+    }
+
+    // Provides direct access to the underlying mutable buffer.
+    constexpr pointer_type data() noexcept
+    {
+        return slots();
+    }
+
+    // Provides direct access to the underlying immutable buffer.
+    constexpr const_pointer_type data() const noexcept
+    {
+        return slots();
+    }
+
+    // Returns a reference to the element at the supplied index, throwing if it is out of range.
+    constexpr reference at(size_type index)
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return slots()[index];
+    }
+
+    // Returns a const reference to the element at the supplied index, throwing if it is out of range.
+    constexpr const_reference at(size_type index) const
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return slots()[index];
+    }
+
+    // Returns a reference to the element at the supplied index without a bounds check.
+    constexpr reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return slots()[index];
+    }
+
+    // Returns a const reference to the element at the supplied index without a bounds check.
+    constexpr const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return slots()[index];
+    }
+
+    // Returns a reference to the first element.
+    constexpr reference front()
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty InplaceVector");
+        return slots()[0];
+    }
+
+    // Returns a const reference to the first element.
+    constexpr const_reference front() const
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty InplaceVector");
+        return slots()[0];
+    }
+
+    // Returns a reference to the last element.
+    constexpr reference back()
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty InplaceVector");
+        return slots()[_size - 1];
+    }
+
+    // Returns a const reference to the last element.
+    constexpr const_reference back() const
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty InplaceVector");
+        return slots()[_size - 1];
+    }
+
+    // Destroys all elements.
+    constexpr void clear() noexcept
+    {
+        destroy_range(0, _size);
+        _size = 0;
+    }
+
+    // Appends a copy of value, throwing std::bad_alloc if the vector is full.
+    constexpr void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    // Appends value by moving it, throwing std::bad_alloc if the vector is full.
+    constexpr void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    // Constructs an element at the end, throwing std::bad_alloc if the vector is full.
+    template <typename... Args>
+    constexpr reference emplace_back(Args&&... args)
+    {
+        if (full()) throw std::bad_alloc();
+        return unchecked_emplace_back(std::forward<Args>(args)...);
+    }
+
+    // Appends a copy of value and returns a pointer to it, or returns nullptr if the vector is full.
+    constexpr pointer_type try_push_back(const T& value)
+    {
+        return try_emplace_back(value);
+    }
+
+    // Appends value by moving it and returns a pointer to it, or returns nullptr if the vector is
+    // full, in which case value is left untouched.
+    constexpr pointer_type try_push_back(T&& value)
+    {
+        return try_emplace_back(std::move(value));
+    }
+
+    // Constructs an element at the end and returns a pointer to it, or returns nullptr without
+    // touching args if the vector is full.
+    template <typename... Args>
+    constexpr pointer_type try_emplace_back(Args&&... args)
+    {
+        if (full()) return nullptr;
+        return std::addressof(unchecked_emplace_back(std::forward<Args>(args)...));
+    }
+
+    // Appends a copy of value; the vector must not be full.
+    constexpr reference unchecked_push_back(const T& value)
+    {
+        return unchecked_emplace_back(value);
+    }
+
+    // Appends value by moving it; the vector must not be full.
+    constexpr reference unchecked_push_back(T&& value)
+    {
+        return unchecked_emplace_back(std::move(value));
+    }
+
+    // Constructs an element at the end; the vector must not be full.
+    template <typename... Args>
+    constexpr reference unchecked_emplace_back(Args&&... args)
+    {
+        VECTOR_ASSERT(!full(), "unchecked_emplace_back() on full InplaceVector");
+        T* slot = std::construct_at(slots() + _size, std::forward<Args>(args)...);
+        ++_size;
+        return *slot;
+    }
+
+    // Removes the last element if the vector is not empty.
+    constexpr void pop_back()
+    {
+        if (_size > 0) {
+            --_size;
+            std::destroy_at(slots() + _size);
+        }
+    }
+
+    // Appends every element of range, throwing std::bad_alloc and appending nothing if they do
+    // not all fit.
+    template <std::ranges::input_range Range>
+    constexpr void append_range(Range&& range)
+    {
+        insert(cend(), std::ranges::begin(range), std::ranges::end(range));
+    }
+
+    // Appends elements of range until the vector is full and returns an iterator to the first
+    // element of range that was left out.
+    template <std::ranges::input_range Range>
+    constexpr std::ranges::borrowed_iterator_t<Range> try_append_range(Range&& range)
+    {
+        auto first = std::ranges::begin(range);
+        const auto last = std::ranges::end(range);
+        for (; first != last && !full(); ++first) {
+            unchecked_emplace_back(*first);
+        }
+        return first;
+    }
+
+    // Inserts copies of [first, last) before pos and returns an iterator to the first of them.
+    // Throws std::bad_alloc and leaves the vector unchanged if they do not all fit.
+    template <std::input_iterator InputIt>
+    constexpr iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const size_type index = index_of(pos);
+        const size_type old_size = _size;
+        if constexpr (std::forward_iterator<InputIt>) {
+            if (static_cast<size_type>(std::distance(first, last)) > N - _size) throw std::bad_alloc();
+        }
+        try {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        } catch (...) {
+            destroy_range(old_size, _size);
+            _size = old_size;
+            throw;
+        }
+        std::rotate(slots() + index, slots() + old_size, slots() + _size);
+        return iterator(slots() + index);
+    }
+
+    // Inserts copies of an initializer list's elements before pos.
+    constexpr iterator insert(const_iterator pos, std::initializer_list<T> init)
+    {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    // Inserts a copy of value before pos and returns an iterator to it.
+    constexpr iterator insert(const_iterator pos, const T& value)
+    {
+        return emplace(pos, value);
+    }
+
+    // Inserts value before pos by moving it and returns an iterator to it.
+    constexpr iterator insert(const_iterator pos, T&& value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    // Inserts count copies of value before pos and returns an iterator to the first of them.
+    // Throws std::bad_alloc and leaves the vector unchanged if they do not all fit.
+    constexpr iterator insert(const_iterator pos, size_type count, const T& value)
+    {
+        const size_type index = index_of(pos);
+        if (count > N - _size) throw std::bad_alloc();
+        // appending never moves existing elements, so value stays valid even if it is one of them
+        const size_type old_size = _size;
+        try {
+            for (size_type i = 0; i < count; ++i) {
+                unchecked_emplace_back(value);
+            }
+        } catch (...) {
+            destroy_range(old_size, _size);
+            _size = old_size;
+            throw;
+        }
+        std::rotate(slots() + index, slots() + old_size, slots() + _size);
+        return iterator(slots() + index);
+    }
+
+    // Constructs an element from args before pos and returns an iterator to it, throwing
+    // std::bad_alloc if the vector is full.
+    template <typename... Args>
+    constexpr iterator emplace(const_iterator pos, Args&&... args)
+    {
+        const size_type index = index_of(pos);
+        emplace_back(std::forward<Args>(args)...);
+        std::rotate(slots() + index, slots() + _size - 1, slots() + _size);
+        return iterator(slots() + index);
+    }
+
+    // Removes the element at pos and returns an iterator to the element that followed it.
+    constexpr iterator erase(const_iterator pos)
+    {
+        VECTOR_ASSERT(pos != cend(), "erase() of end()");
+        return erase(pos, pos + 1);
+    }
+
+    // Removes [first, last) and returns an iterator to the element that followed the range.
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        const size_type index = index_of(first);
+        const auto count = static_cast<size_type>(last - first);
+        std::move(slots() + index + count, slots() + _size, slots() + index);
+        destroy_range(_size - count, _size);
+        _size -= count;
+        return iterator(slots() + index);
+    }
+
+    // Removes the element at index in O(1) by moving the last element into its place, so the
+    // order of the remaining elements is not preserved.
+    constexpr void swap_remove(size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "swap_remove() index out of range");
+        if (index != _size - 1) slots()[index] = std::move(slots()[_size - 1]);
+        pop_back();
+    }
+
+    // Removes every element for which pred returns true, keeping the others in order, and
+    // returns how many were removed.
+    template <typename Predicate>
+    constexpr size_type remove_if(Predicate pred)
+    {
+        T* new_end = std::remove_if(slots(), slots() + _size, [&](const T& value) { return pred(value); });
+        const auto new_size = static_cast<size_type>(new_end - slots());
+        const size_type removed = _size - new_size;
+        destroy_range(new_size, _size);
+        _size = new_size;
+        return removed;
+    }
+
+    // Replaces the contents with copies of [first, last), throwing std::bad_alloc if there are
+    // more than N.
+    template <std::input_iterator InputIt>
+    constexpr void assign(InputIt first, InputIt last)
+    {
+        if constexpr (std::forward_iterator<InputIt>) {
+            if (static_cast<size_type>(std::distance(first, last)) > N) throw std::bad_alloc();
+        }
+        clear();
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    // Replaces the contents with count copies of value, throwing std::bad_alloc if count exceeds N.
+    constexpr void assign(size_type count, const T& value)
+    {
+        if (count > N) throw std::bad_alloc();
+        const T copy(value); // value may be one of the elements about to be destroyed
+        clear();
+        for (size_type i = 0; i < count; ++i) {
+            unchecked_emplace_back(copy);
+        }
+    }
+
+    // Replaces the contents with the elements of an initializer list.
+    constexpr void assign(std::initializer_list<T> init)
+    {
+        assign(init.begin(), init.end());
+    }
+
+    // Does nothing when new_cap fits in N and throws std::bad_alloc otherwise; present so that
+    // code written against Vector compiles unchanged.
+    static constexpr void reserve(size_type new_cap)
+    {
+        if (new_cap > N) throw std::bad_alloc();
+    }
+
+    // Does nothing: the capacity is fixed.
+    static constexpr void shrink_to_fit() noexcept {}
+
+    // Grows or shrinks the vector to new_size, value-initializing new elements and throwing
+    // std::bad_alloc if new_size exceeds N.
+    constexpr void resize(size_type new_size)
+    {
+        if (new_size > N) throw std::bad_alloc();
+        if (new_size <= _size) {
+            destroy_range(new_size, _size);
+            _size = new_size;
+            return;
+        }
+        const size_type old_size = _size;
+        try {
+            while (_size < new_size) {
+                unchecked_emplace_back();
+            }
+        } catch (...) {
+            destroy_range(old_size, _size);
+            _size = old_size;
+            throw;
+        }
+    }
+
+    // Returns an iterator to the first element.
+    constexpr iterator begin() noexcept
+    {
+        return iterator(slots());
+    }
+
+    // Returns an iterator one past the last element.
+    constexpr iterator end() noexcept
+    {
+        return iterator(slots() + _size);
+    }
+
+    // Returns a const iterator to the first element.
+    constexpr const_iterator begin() const noexcept
+    {
+        return const_iterator(slots());
+    }
+
+    // Returns a const iterator one past the last element.
+    constexpr const_iterator end() const noexcept
+    {
+        return const_iterator(slots() + _size);
+    }
+
+    // Returns a const iterator to the first element (C++ standard naming).
+    constexpr const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    // Returns a const iterator one past the last element (C++ standard naming).
+    constexpr const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    // Compares element-wise.
+    friend constexpr bool operator==(const InplaceVector& lhs, const InplaceVector& rhs)
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+private:
+    constexpr pointer_type slots() noexcept
+    {
+        return _storage.elements;
+    }
+
+    constexpr const_pointer_type slots() const noexcept
+    {
+        return _storage.elements;
+    }
+
+    constexpr size_type index_of(const_iterator pos) const noexcept
+    {
+        return static_cast<size_type>(std::to_address(pos) - slots());
+    }
+
+    // Destroys the elements in [first, last).
+    constexpr void destroy_range(size_type first, size_type last) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            std::destroy(slots() + first, slots() + last);
+        }
+    }
+
+    Storage _storage;
+    size_type _size = 0;
+};
+
+// Removes every element of vec for which pred returns true and returns how many were removed.
+template <typename T, std::size_t N, typename Predicate>
+constexpr std::size_t erase_if(InplaceVector<T, N>& vec, Predicate pred)
+{
+    return vec.remove_if(pred);
+}
+
+// Removes every element of vec equal to value and returns how many were removed.
+template <typename T, std::size_t N, typename U>
+constexpr std::size_t erase(InplaceVector<T, N>& vec, const U& value)
+{
+    return vec.remove_if([&](const T& element) { return element == value; });
+}
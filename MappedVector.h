@@ -0,0 +1,452 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Vector.h"
+
+// Vector of trivially copyable elements stored directly in a memory-mapped file.
+// The file holds nothing but the elements, so an existing array file opens without a copy and a
+// MappedVector's file can be read back as a plain array. While open, the file is sized to the
+// capacity; closing truncates it back to size() elements. A process that dies before closing
+// leaves the spare capacity in the file as trailing zero elements.
+template <typename T, typename GrowthPolicy = DoublingGrowth>
+class MappedVector
+{
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector requires trivially copyable elements");
+
+public:
+    using value_type = T;
+    using growth_policy = GrowthPolicy;
+    using size_type = std::size_t;
+    using pointer_type = T*;
+    using const_pointer_type = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = VectorIterator<T>;
+    using const_iterator = VectorIterator<const T>;
+
+    // How an existing file is mapped.
+    enum class Mode
+    {
+        read_only,  // PROT_READ; the vector cannot change size and writing through it faults
+        read_write, // shared mapping; every change lands in the file
+    };
+
+    // Access pattern hints forwarded to madvise().
+    enum class Access
+    {
+        normal,
+        sequential, // aggressive read-ahead, pages dropped soon after use
+        random,     // no read-ahead
+        will_need,  // start reading the whole mapping in now
+        dont_need,  // the mapped pages can be reclaimed
+    };
+
+    // Maps an existing file whose length is a whole number of elements.
+    explicit MappedVector(const std::filesystem::path& path, Mode mode = Mode::read_write)
+        : _writable(mode == Mode::read_write)
+    {
+        _fd = ::open(path.c_str(), (_writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+        if (_fd < 0) throw_errno("open");
+
+        struct stat info{};
+        if (::fstat(_fd, &info) != 0) {
+            const int error = errno;
+            ::close(_fd);
+            throw std::system_error(error, std::system_category(), "MappedVector: fstat");
+        }
+        const auto bytes = static_cast<size_type>(info.st_size);
+        if (bytes % sizeof(T) != 0) {
+            ::close(_fd);
+            throw std::invalid_argument("MappedVector: file length is not a multiple of the element size");
+        }
+
+        _size = _capacity = bytes / sizeof(T);
+        try {
+            map(_capacity);
+        } catch (...) {
+            ::close(_fd);
+            throw;
+        }
+    }
+
+    // Creates (or truncates) a file and maps it as an empty vector with room for capacity elements.
+    static MappedVector create(const std::filesystem::path& path, size_type capacity = 0)
+    {
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) throw_errno("open");
+        MappedVector vec(fd);
+        vec.reserve(capacity);
+        return vec;
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    // Takes over another vector's file and mapping.
+    MappedVector(MappedVector&& other) noexcept
+        : _data(std::exchange(other._data, nullptr)),
+          _size(std::exchange(other._size, 0)),
+          _capacity(std::exchange(other._capacity, 0)),
+          _fd(std::exchange(other._fd, -1)),
+          _writable(other._writable) {}
+
+    // Closes the current file and takes over another vector's.
+    MappedVector& operator=(MappedVector&& other) noexcept
+    {
+        if (this != &other) {
+            close_quietly();
+            _data = std::exchange(other._data, nullptr);
+            _size = std::exchange(other._size, 0);
+            _capacity = std::exchange(other._capacity, 0);
+            _fd = std::exchange(other._fd, -1);
+            _writable = other._writable;
+        }
+        return *this;
+    }
+
+    // Unmaps the file and trims it to size() elements; errors are swallowed, call close() to see them.
+    ~MappedVector()
+    {
+        close_quietly();
+    }
+
+    // Returns the number of elements in the vector.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // Returns the number of elements the file currently has room for.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    // Returns whether the vector holds no elements.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // Returns whether the vector is still attached to a file.
+    [[nodiscard]] bool is_open() const noexcept
+    {
+        return _fd >= 0;
+    }
+
+    // Returns whether the mapping accepts writes and growth.
+    [[nodiscard]] bool writable() const noexcept
+    {
+        return _writable;
+    }
+
+    // Returns a pointer to the mapped elements.
+    [[nodiscard]] T* data() noexcept
+    {
+        return _data;
+    }
+
+    // Returns a const pointer to the mapped elements.
+    [[nodiscard]] const T* data() const noexcept
+    {
+        return _data;
+    }
+
+    // Returns a reference to the element at the supplied index, throwing if it is out of range.
+    reference at(size_type index)
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return _data[index];
+    }
+
+    // Returns a const reference to the element at the supplied index, throwing if it is out of range.
+    const_reference at(size_type index) const
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return _data[index];
+    }
+
+    // Returns a reference to the element at the supplied index without a bounds check.
+    reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return _data[index];
+    }
+
+    // Returns a const reference to the element at the supplied index without a bounds check.
+    const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return _data[index];
+    }
+
+    // Returns a reference to the first element.
+    reference front()
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty vector");
+        return _data[0];
+    }
+
+    // Returns a const reference to the first element.
+    const_reference front() const
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty vector");
+        return _data[0];
+    }
+
+    // Returns a reference to the last element.
+    reference back()
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty vector");
+        return _data[_size - 1];
+    }
+
+    // Returns a const reference to the last element.
+    const_reference back() const
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty vector");
+        return _data[_size - 1];
+    }
+
+    // Appends a copy of the provided value, growing the file if needed.
+    void push_back(const T& value)
+    {
+        require_writable();
+        const T copy = value; // value may be an element, and growing can move the mapping
+        ensure_capacity(1);
+        std::memcpy(static_cast<void*>(_data + _size), &copy, sizeof(T));
+        ++_size;
+    }
+
+    // Constructs a new element at the end from the supplied arguments.
+    template <typename... Args>
+    reference emplace_back(Args&&... args)
+    {
+        require_writable();
+        const T value(std::forward<Args>(args)...); // args may refer to an element
+        ensure_capacity(1);
+        std::memcpy(static_cast<void*>(_data + _size), &value, sizeof(T));
+        ++_size;
+        return _data[_size - 1];
+    }
+
+    // Removes the last element if the vector is not empty.
+    void pop_back()
+    {
+        require_writable();
+        if (_size > 0) --_size;
+    }
+
+    // Removes every element, keeping the file's capacity.
+    void clear()
+    {
+        require_writable();
+        _size = 0;
+    }
+
+    // Grows the file so it holds at least new_capacity elements.
+    void reserve(size_type new_capacity)
+    {
+        require_writable();
+        if (new_capacity > _capacity) remap(new_capacity);
+    }
+
+    // Resizes to new_size elements; new elements are value-initialized.
+    void resize(size_type new_size)
+    {
+        require_writable();
+        if (new_size > _capacity) remap(new_size);
+        if (new_size > _size) {
+            // the slots may hold elements from before an earlier shrink
+            for (size_type i = _size; i < new_size; ++i) {
+                ::new (static_cast<void*>(_data + i)) T();
+            }
+        }
+        _size = new_size;
+    }
+
+    // Shrinks the file to exactly size() elements.
+    void shrink_to_fit()
+    {
+        require_writable();
+        if (_capacity > _size) remap(_size);
+    }
+
+    // Passes an access pattern hint for the whole mapping to the kernel.
+    void advise(Access access) const
+    {
+        if (!_data) return;
+        if (::madvise(static_cast<void*>(_data), _capacity * sizeof(T), advice(access)) != 0) throw_errno("madvise");
+    }
+
+    // Writes dirty pages back to the file; waits for the write to finish unless async is set.
+    void flush(bool async = false) const
+    {
+        if (!_data || !_writable) return;
+        if (::msync(static_cast<void*>(_data), _capacity * sizeof(T), async ? MS_ASYNC : MS_SYNC) != 0) throw_errno("msync");
+    }
+
+    // Flushes, unmaps and trims the file to size() elements, reporting any failure.
+    void close()
+    {
+        if (_fd < 0) return;
+        flush();
+        unmap();
+        const int fd = std::exchange(_fd, -1);
+        const bool trimmed = !_writable || ::ftruncate(fd, static_cast<off_t>(_size * sizeof(T))) == 0;
+        const int error = errno;
+        _size = _capacity = 0;
+        if (::close(fd) != 0 && trimmed) throw_errno("close");
+        if (!trimmed) throw std::system_error(error, std::system_category(), "MappedVector: ftruncate");
+    }
+
+    // Returns an iterator to the first element.
+    iterator begin() noexcept
+    {
+        return iterator(_data);
+    }
+
+    // Returns an iterator past the last element.
+    iterator end() noexcept
+    {
+        return iterator(_data + _size);
+    }
+
+    // Returns a const iterator to the first element.
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(_data);
+    }
+
+    // Returns a const iterator past the last element.
+    const_iterator end() const noexcept
+    {
+        return const_iterator(_data + _size);
+    }
+
+    // Returns a const iterator to the first element.
+    const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    // Returns a const iterator past the last element.
+    const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+private:
+    // Adopts a freshly created, empty, writable file.
+    explicit MappedVector(int fd) noexcept
+        : _fd(fd), _writable(true) {}
+
+    [[noreturn]] static void throw_errno(const char* call)
+    {
+        throw std::system_error(errno, std::system_category(), std::string("MappedVector: ") + call);
+    }
+
+    static int advice(Access access) noexcept
+    {
+        switch (access) {
+        case Access::sequential: return MADV_SEQUENTIAL;
+        case Access::random: return MADV_RANDOM;
+        case Access::will_need: return MADV_WILLNEED;
+        case Access::dont_need: return MADV_DONTNEED;
+        default: return MADV_NORMAL;
+        }
+    }
+
+    // Throws unless the mapping accepts writes; every member that changes size() checks first.
+    void require_writable() const
+    {
+        if (!_writable) throw std::logic_error("MappedVector: cannot resize a read-only mapping");
+    }
+
+    // Makes room for extra more elements, growing the file by the growth policy.
+    void ensure_capacity(size_type extra)
+    {
+        if (_size + extra > _capacity) remap(GrowthPolicy::next_capacity(_capacity, _size + extra, sizeof(T)));
+    }
+
+    // Maps count elements of the file, or nothing for an empty file.
+    void map(size_type count)
+    {
+        if (count == 0) return;
+        const int protection = _writable ? PROT_READ | PROT_WRITE : PROT_READ;
+        void* block = ::mmap(nullptr, count * sizeof(T), protection, MAP_SHARED, _fd, 0);
+        if (block == MAP_FAILED) throw_errno("mmap");
+        _data = static_cast<T*>(block);
+    }
+
+    void unmap() noexcept
+    {
+        if (_data) ::munmap(static_cast<void*>(_data), _capacity * sizeof(T));
+        _data = nullptr;
+    }
+
+    // Resizes the file to new_capacity elements and moves the mapping to match.
+    void remap(size_type new_capacity)
+    {
+        require_writable();
+        if (new_capacity > static_cast<size_type>(-1) / sizeof(T)) throw std::length_error("MappedVector: capacity overflow");
+        const size_type new_bytes = new_capacity * sizeof(T);
+        if (::ftruncate(_fd, static_cast<off_t>(new_bytes)) != 0) throw_errno("ftruncate");
+
+        if (new_capacity == 0) {
+            unmap();
+        } else if (_data) {
+#if defined(__linux__)
+            void* block = ::mremap(static_cast<void*>(_data), _capacity * sizeof(T), new_bytes, MREMAP_MAYMOVE);
+            if (block == MAP_FAILED) throw_errno("mremap");
+            _data = static_cast<T*>(block);
+#else
+            // the file already holds every element, so a fresh mapping sees the same bytes
+            const int protection = PROT_READ | PROT_WRITE;
+            void* block = ::mmap(nullptr, new_bytes, protection, MAP_SHARED, _fd, 0);
+            if (block == MAP_FAILED) throw_errno("mmap");
+            unmap();
+            _data = static_cast<T*>(block);
+#endif
+        } else {
+            _capacity = 0;
+            map(new_capacity);
+        }
+        _capacity = new_capacity;
+    }
+
+    // Closes without reporting errors, for destruction and move assignment.
+    void close_quietly() noexcept
+    {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    T* _data = nullptr;
+    size_type _size = 0;
+    size_type _capacity = 0;
+    int _fd = -1;
+    bool _writable = false;
+};
+
+#endif
@@ -0,0 +1,785 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+// Containers that store elements narrower than a byte packed into 64-bit words: BitVector holds
+// one bit per flag and PackedIntVector<Bits> holds unsigned integers of Bits bits each. Element
+// access goes through proxy references, and the words themselves are exposed for bulk work.
+// Bits past size() in the last word are always zero, so whole-word operations need no masking.
+
+// Random access iterator over a container whose operator[] returns a proxy or a value rather
+// than a reference. Like every proxy iterator it only meets the input iterator requirements of
+// the classic iterator categories, but algorithms on random access ranges accept it.
+template <typename Owner>
+class ProxyIterator
+{
+public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = typename std::remove_const_t<Owner>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = decltype(std::declval<Owner&>()[0]);
+
+    // Creates an iterator that does not point into any container.
+    ProxyIterator() noexcept = default;
+
+    // Creates an iterator to the element at index of owner.
+    ProxyIterator(Owner* owner, std::size_t index) noexcept
+        : _owner(owner), _index(index) {}
+
+    // Converts an iterator over a mutable container into one over the same container as const.
+    template <typename Other>
+        requires(std::is_same_v<const Other, Owner> && !std::is_same_v<Other, Owner>)
+    ProxyIterator(const ProxyIterator<Other>& other) noexcept
+        : _owner(other._owner), _index(other._index) {}
+
+    reference operator*() const { return (*_owner)[_index]; }
+    reference operator[](difference_type offset) const { return (*_owner)[_index + offset]; }
+
+    ProxyIterator& operator++() noexcept { ++_index; return *this; }
+    ProxyIterator operator++(int) noexcept { ProxyIterator old = *this; ++_index; return old; }
+    ProxyIterator& operator--() noexcept { --_index; return *this; }
+    ProxyIterator operator--(int) noexcept { ProxyIterator old = *this; --_index; return old; }
+    ProxyIterator& operator+=(difference_type offset) noexcept { _index += offset; return *this; }
+    ProxyIterator& operator-=(difference_type offset) noexcept { _index -= offset; return *this; }
+
+    friend ProxyIterator operator+(ProxyIterator it, difference_type offset) noexcept { return it += offset; }
+    friend ProxyIterator operator+(difference_type offset, ProxyIterator it) noexcept { return it += offset; }
+    friend ProxyIterator operator-(ProxyIterator it, difference_type offset) noexcept { return it -= offset; }
+    friend difference_type operator-(const ProxyIterator& lhs, const ProxyIterator& rhs) noexcept
+    {
+        return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+    }
+    friend bool operator==(const ProxyIterator& lhs, const ProxyIterator& rhs) noexcept { return lhs._index == rhs._index; }
+    friend std::strong_ordering operator<=>(const ProxyIterator& lhs, const ProxyIterator& rhs) noexcept
+    {
+        return lhs._index <=> rhs._index;
+    }
+
+private:
+    template <typename>
+    friend class ProxyIterator;
+
+    Owner* _owner = nullptr;
+    std::size_t _index = 0;
+};
+
+namespace vector_detail {
+
+using packed_word = std::uint64_t;
+inline constexpr std::size_t packed_word_bits = 64;
+
+// Words needed to hold bits bits.
+constexpr std::size_t packed_words_for(std::size_t bits) noexcept
+{
+    return (bits + packed_word_bits - 1) / packed_word_bits;
+}
+
+// Mask of the low bits bits of a word.
+constexpr packed_word low_bits(std::size_t bits) noexcept
+{
+    return bits >= packed_word_bits ? ~packed_word{0} : (packed_word{1} << bits) - 1;
+}
+
+// Narrowest unsigned type that holds Bits bits.
+template <std::size_t Bits>
+using packed_value_t = std::conditional_t<(Bits <= 8), std::uint8_t,
+    std::conditional_t<(Bits <= 16), std::uint16_t,
+    std::conditional_t<(Bits <= 32), std::uint32_t, std::uint64_t>>>;
+
+// Reads the Bits-bit field that starts at bit of words; the field may straddle two words.
+template <std::size_t Bits>
+[[gnu::always_inline]] inline packed_word read_field(const packed_word* words, std::size_t bit) noexcept
+{
+    const std::size_t offset = bit % packed_word_bits;
+    const packed_word* word = words + bit / packed_word_bits;
+    packed_word value = word[0] >> offset;
+    if (offset + Bits > packed_word_bits) value |= word[1] << (packed_word_bits - offset);
+    return value & low_bits(Bits);
+}
+
+// Decodes the 64 fields of one block, which spans exactly Bits words. Every shift and word
+// offset is a compile-time constant, so the block compiles to straight-line shifts and masks
+// that the vectorizer can pack into SIMD registers.
+template <std::size_t Bits, typename U>
+[[gnu::always_inline]] inline void unpack_block(const packed_word* words, U* out) noexcept
+{
+    constexpr packed_word mask = low_bits(Bits);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((out[I] = static_cast<U>(((words[I * Bits / packed_word_bits] >> (I * Bits % packed_word_bits)) |
+                                   (I * Bits % packed_word_bits + Bits > packed_word_bits
+                                        ? words[I * Bits / packed_word_bits + 1] << ((packed_word_bits - I * Bits % packed_word_bits) % packed_word_bits)
+                                        : 0)) &
+                                  mask)),
+         ...);
+    }(std::make_index_sequence<packed_word_bits>());
+}
+
+} // namespace vector_detail
+
+// Sequence of bools stored one bit each, for bitmaps and filters. Besides element access it
+// offers whole-word queries (popcount(), find_first(), find_next()) and bulk &=, |= and ^=
+// that touch 64 flags per instruction.
+template <typename Allocator = std::allocator<std::uint64_t>>
+class BitVector
+{
+    using word_type = vector_detail::packed_word;
+    static constexpr std::size_t word_bits = vector_detail::packed_word_bits;
+
+public:
+    using value_type = bool;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using const_reference = bool;
+    using iterator = ProxyIterator<BitVector>;
+    using const_iterator = ProxyIterator<const BitVector>;
+
+    // Returned by the find functions when no set bit follows.
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    // Writable view of one bit.
+    class reference
+    {
+    public:
+        reference(const reference&) = default;
+
+        operator bool() const noexcept { return (*_word & _mask) != 0; }
+
+        // Stores value into the bit.
+        reference& operator=(bool value) noexcept
+        {
+            *_word = value ? (*_word | _mask) : (*_word & ~_mask);
+            return *this;
+        }
+
+        // Copies the value of another bit, not the proxy itself.
+        reference& operator=(const reference& other) noexcept
+        {
+            return *this = static_cast<bool>(other);
+        }
+
+        // Inverts the bit.
+        void flip() noexcept { *_word ^= _mask; }
+
+    private:
+        friend class BitVector;
+
+        reference(word_type* word, word_type mask) noexcept
+            : _word(word), _mask(mask) {}
+
+        word_type* _word;
+        word_type _mask;
+    };
+
+    // Constructs an empty bit vector.
+    BitVector() noexcept(noexcept(Allocator()))
+        : _words() {}
+
+    // Constructs an empty bit vector that allocates from the given allocator.
+    explicit BitVector(const Allocator& allocator) noexcept
+        : _words(allocator) {}
+
+    // Constructs count bits all equal to value.
+    explicit BitVector(size_type count, bool value = false, const Allocator& allocator = Allocator())
+        : _words(allocator)
+    {
+        resize(count, value);
+    }
+
+    // Copies the flags of an initializer list.
+    BitVector(std::initializer_list<bool> init, const Allocator& allocator = Allocator())
+        : _words(allocator)
+    {
+        reserve(init.size());
+        for (bool value : init) {
+            push_back(value);
+        }
+    }
+
+    // Returns a copy of the allocator used for the words.
+    [[nodiscard]] allocator_type get_allocator() const noexcept
+    {
+        return _words.get_allocator();
+    }
+
+    // Returns how many bits are stored.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // Returns how many bits fit without reallocating.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return _words.capacity() * word_bits;
+    }
+
+    // Indicates whether no bits are stored.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // Returns the words holding the bits, least significant bit first; bits past size() are zero.
+    [[nodiscard]] std::span<const word_type> words() const noexcept
+    {
+        return std::span<const word_type>(_words.data(), _words.size());
+    }
+
+    // Returns the bit at index, throwing if it is out of range.
+    [[nodiscard]] bool at(size_type index) const
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return test(index);
+    }
+
+    // Returns a writable view of the bit at index, throwing if it is out of range.
+    reference at(size_type index)
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return (*this)[index];
+    }
+
+    // Returns the bit at index without a bounds check.
+    bool operator[](size_type index) const noexcept
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return test(index);
+    }
+
+    // Returns a writable view of the bit at index without a bounds check.
+    reference operator[](size_type index) noexcept
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return reference(_words.data() + index / word_bits, word_type{1} << (index % word_bits));
+    }
+
+    // Returns the first bit.
+    bool front() const noexcept
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty BitVector");
+        return test(0);
+    }
+
+    // Returns the last bit.
+    bool back() const noexcept
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty BitVector");
+        return test(_size - 1);
+    }
+
+    // Returns the bit at index without a bounds check.
+    [[nodiscard]] bool test(size_type index) const noexcept
+    {
+        return (_words.data()[index / word_bits] >> (index % word_bits)) & 1;
+    }
+
+    // Sets the bit at index to value.
+    void set(size_type index, bool value = true) noexcept
+    {
+        (*this)[index] = value;
+    }
+
+    // Clears the bit at index.
+    void reset(size_type index) noexcept
+    {
+        (*this)[index] = false;
+    }
+
+    // Inverts the bit at index.
+    void flip(size_type index) noexcept
+    {
+        (*this)[index].flip();
+    }
+
+    // Sets every bit to value.
+    void fill(bool value) noexcept
+    {
+        std::fill(_words.begin(), _words.end(), value ? ~word_type{0} : word_type{0});
+        clear_tail();
+    }
+
+    // Inverts every bit.
+    void flip() noexcept
+    {
+        for (word_type& word : _words) {
+            word = ~word;
+        }
+        clear_tail();
+    }
+
+    // Appends one bit.
+    void push_back(bool value)
+    {
+        if (_size % word_bits == 0) _words.push_back(0);
+        ++_size;
+        if (value) set(_size - 1);
+    }
+
+    // Removes the last bit if there is one.
+    void pop_back() noexcept
+    {
+        if (_size == 0) return;
+        reset(_size - 1);
+        --_size;
+        if (_size % word_bits == 0) _words.pop_back();
+    }
+
+    // Grows or shrinks to count bits; new bits equal value.
+    void resize(size_type count, bool value = false)
+    {
+        const size_type old_size = _size;
+        _words.resize(vector_detail::packed_words_for(count)); // new words are zero
+        _size = count;
+        if (count < old_size) {
+            clear_tail();
+        } else if (value) {
+            set_range(old_size, count);
+        }
+    }
+
+    // Reserves room for bits bits.
+    void reserve(size_type bits)
+    {
+        _words.reserve(vector_detail::packed_words_for(bits));
+    }
+
+    // Returns unused words to the allocator.
+    void shrink_to_fit()
+    {
+        _words.shrink_to_fit();
+    }
+
+    // Removes every bit.
+    void clear() noexcept
+    {
+        _words.clear();
+        _size = 0;
+    }
+
+    // Returns how many bits are set.
+    [[nodiscard]] size_type popcount() const noexcept
+    {
+        size_type total = 0;
+        for (word_type word : _words) {
+            total += static_cast<size_type>(std::popcount(word));
+        }
+        return total;
+    }
+
+    // Returns whether any bit is set.
+    [[nodiscard]] bool any() const noexcept
+    {
+        return find_first() != npos;
+    }
+
+    // Returns whether no bit is set.
+    [[nodiscard]] bool none() const noexcept
+    {
+        return !any();
+    }
+
+    // Returns whether every bit is set; true when empty.
+    [[nodiscard]] bool all() const noexcept
+    {
+        return popcount() == _size;
+    }
+
+    // Returns the index of the first set bit, or npos.
+    [[nodiscard]] size_type find_first() const noexcept
+    {
+        return scan_from(0, ~word_type{0});
+    }
+
+    // Returns the index of the first set bit after index, or npos.
+    [[nodiscard]] size_type find_next(size_type index) const noexcept
+    {
+        const size_type start = index + 1;
+        if (start >= _size) return npos;
+        return scan_from(start / word_bits, ~word_type{0} << (start % word_bits));
+    }
+
+    // Keeps the bits set in both; the sizes must match.
+    BitVector& operator&=(const BitVector& other)
+    {
+        require_same_size(other);
+        combine(other, [](word_type a, word_type b) { return a & b; });
+        return *this;
+    }
+
+    // Sets the bits set in either; the sizes must match.
+    BitVector& operator|=(const BitVector& other)
+    {
+        require_same_size(other);
+        combine(other, [](word_type a, word_type b) { return a | b; });
+        return *this;
+    }
+
+    // Sets the bits set in exactly one; the sizes must match.
+    BitVector& operator^=(const BitVector& other)
+    {
+        require_same_size(other);
+        combine(other, [](word_type a, word_type b) { return a ^ b; });
+        return *this;
+    }
+
+    friend BitVector operator&(BitVector lhs, const BitVector& rhs) { return lhs &= rhs; }
+    friend BitVector operator|(BitVector lhs, const BitVector& rhs) { return lhs |= rhs; }
+    friend BitVector operator^(BitVector lhs, const BitVector& rhs) { return lhs ^= rhs; }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, _size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, _size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Compares bit by bit, a word at a time.
+    friend bool operator==(const BitVector& lhs, const BitVector& rhs) noexcept
+    {
+        return lhs._size == rhs._size && std::equal(lhs._words.begin(), lhs._words.end(), rhs._words.begin());
+    }
+
+private:
+    void require_same_size(const BitVector& other) const
+    {
+        if (_size != other._size) throw std::invalid_argument("BitVector sizes differ");
+    }
+
+    template <typename Op>
+    void combine(const BitVector& other, Op op) noexcept
+    {
+        word_type* words = _words.data();
+        const word_type* others = other._words.data();
+        for (size_type i = 0; i < _words.size(); ++i) {
+            words[i] = op(words[i], others[i]);
+        }
+    }
+
+    // Sets bits [first, last) a word at a time.
+    void set_range(size_type first, size_type last) noexcept
+    {
+        word_type* words = _words.data();
+        for (size_type bit = first; bit < last;) {
+            const size_type offset = bit % word_bits;
+            const size_type span = std::min(word_bits - offset, last - bit);
+            words[bit / word_bits] |= vector_detail::low_bits(span) << offset;
+            bit += span;
+        }
+    }
+
+    // Returns the first set bit in word first onward, with the first word masked by mask.
+    size_type scan_from(size_type first, word_type mask) const noexcept
+    {
+        const word_type* words = _words.data();
+        for (size_type i = first; i < _words.size(); ++i, mask = ~word_type{0}) {
+            if (const word_type word = words[i] & mask) {
+                return i * word_bits + static_cast<size_type>(std::countr_zero(word));
+            }
+        }
+        return npos;
+    }
+
+    // Zeroes the bits of the last word that lie past size().
+    void clear_tail() noexcept
+    {
+        if (_size % word_bits != 0) _words.back() &= vector_detail::low_bits(_size % word_bits);
+    }
+
+    Vector<word_type, Allocator> _words;
+    size_type _size = 0;
+};
+
+// Sequence of unsigned integers of Bits bits each, packed back to back into 64-bit words, e.g.
+// 12-bit ids at a quarter of the memory of uint64_t. Values wider than Bits are truncated
+// (asserted under VECTOR_HARDENED). unpack() decodes a run into plain integers 64 values per
+// block with compile-time shifts, several times faster than reading one element at a time.
+template <std::size_t Bits, typename Allocator = std::allocator<std::uint64_t>>
+class PackedIntVector
+{
+    static_assert(Bits >= 1 && Bits <= 64, "PackedIntVector holds fields of 1 to 64 bits");
+
+    using word_type = vector_detail::packed_word;
+    static constexpr std::size_t word_bits = vector_detail::packed_word_bits;
+    static constexpr word_type mask = vector_detail::low_bits(Bits);
+
+public:
+    using value_type = vector_detail::packed_value_t<Bits>;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using const_reference = value_type;
+    using iterator = ProxyIterator<PackedIntVector>;
+    using const_iterator = ProxyIterator<const PackedIntVector>;
+
+    // Width of every element in bits.
+    static constexpr size_type bits = Bits;
+    // Elements decoded together by unpack(); a block starts on a word boundary.
+    static constexpr size_type block_size = word_bits;
+
+    // Writable view of one element.
+    class reference
+    {
+    public:
+        reference(const reference&) = default;
+
+        operator value_type() const noexcept { return _owner->get(_index); }
+
+        // Stores value into the element.
+        reference& operator=(value_type value) noexcept
+        {
+            _owner->put(_index, value);
+            return *this;
+        }
+
+        // Copies the value of another element, not the proxy itself.
+        reference& operator=(const reference& other) noexcept
+        {
+            return *this = static_cast<value_type>(other);
+        }
+
+    private:
+        friend class PackedIntVector;
+
+        reference(PackedIntVector* owner, size_type index) noexcept
+            : _owner(owner), _index(index) {}
+
+        PackedIntVector* _owner;
+        size_type _index;
+    };
+
+    // Constructs an empty vector.
+    PackedIntVector() noexcept(noexcept(Allocator()))
+        : _words() {}
+
+    // Constructs an empty vector that allocates from the given allocator.
+    explicit PackedIntVector(const Allocator& allocator) noexcept
+        : _words(allocator) {}
+
+    // Constructs count elements equal to value.
+    explicit PackedIntVector(size_type count, value_type value = 0, const Allocator& allocator = Allocator())
+        : _words(allocator)
+    {
+        resize(count, value);
+    }
+
+    // Copies the values of an initializer list.
+    PackedIntVector(std::initializer_list<value_type> init, const Allocator& allocator = Allocator())
+        : _words(allocator)
+    {
+        reserve(init.size());
+        for (value_type value : init) {
+            push_back(value);
+        }
+    }
+
+    // Returns a copy of the allocator used for the words.
+    [[nodiscard]] allocator_type get_allocator() const noexcept
+    {
+        return _words.get_allocator();
+    }
+
+    // Returns how many elements are stored.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // Returns how many elements fit without reallocating.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return _words.capacity() * word_bits / Bits;
+    }
+
+    // Indicates whether no elements are stored.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // Returns the words holding the packed elements; bits past the last element are zero.
+    [[nodiscard]] std::span<const word_type> words() const noexcept
+    {
+        return std::span<const word_type>(_words.data(), _words.size());
+    }
+
+    // Returns the element at index, throwing if it is out of range.
+    [[nodiscard]] value_type at(size_type index) const
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return get(index);
+    }
+
+    // Returns a writable view of the element at index, throwing if it is out of range.
+    reference at(size_type index)
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return reference(this, index);
+    }
+
+    // Returns the element at index without a bounds check.
+    value_type operator[](size_type index) const noexcept
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return get(index);
+    }
+
+    // Returns a writable view of the element at index without a bounds check.
+    reference operator[](size_type index) noexcept
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return reference(this, index);
+    }
+
+    // Returns the first element.
+    value_type front() const noexcept
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty PackedIntVector");
+        return get(0);
+    }
+
+    // Returns the last element.
+    value_type back() const noexcept
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty PackedIntVector");
+        return get(_size - 1);
+    }
+
+    // Appends value.
+    void push_back(value_type value)
+    {
+        // at most one new word per element; push_back grows by the growth policy, where resize()
+        // would reserve exactly and copy the buffer on every new word
+        if (vector_detail::packed_words_for((_size + 1) * Bits) > _words.size()) _words.push_back(0);
+        put(_size, value);
+        ++_size;
+    }
+
+    // Removes the last element if there is one.
+    void pop_back() noexcept
+    {
+        if (_size == 0) return;
+        put(_size - 1, 0);
+        --_size;
+        _words.resize(vector_detail::packed_words_for(_size * Bits));
+    }
+
+    // Grows or shrinks to count elements; new elements equal value.
+    void resize(size_type count, value_type value = 0)
+    {
+        const size_type old_size = _size;
+        if (count < old_size) {
+            for (size_type i = count; i < old_size; ++i) {
+                put(i, 0);
+            }
+            _words.resize(vector_detail::packed_words_for(count * Bits));
+            _size = count;
+            return;
+        }
+        _words.resize(vector_detail::packed_words_for(count * Bits)); // new words are zero
+        _size = count;
+        if (value != 0) {
+            for (size_type i = old_size; i < count; ++i) {
+                put(i, value);
+            }
+        }
+    }
+
+    // Reserves room for count elements.
+    void reserve(size_type count)
+    {
+        _words.reserve(vector_detail::packed_words_for(count * Bits));
+    }
+
+    // Returns unused words to the allocator.
+    void shrink_to_fit()
+    {
+        _words.shrink_to_fit();
+    }
+
+    // Removes every element.
+    void clear() noexcept
+    {
+        _words.clear();
+        _size = 0;
+    }
+
+    // Decodes out.size() elements starting at first into out.
+    void unpack(size_type first, std::span<value_type> out) const
+    {
+        if (first > _size || out.size() > _size - first) throw std::out_of_range("unpack range out of range");
+        const word_type* words = _words.data();
+        value_type* dest = out.data();
+        size_type index = first;
+        const size_type last = first + out.size();
+
+        // single elements up to a block boundary, whole blocks, then the remainder
+        for (; index < last && index % block_size != 0; ++index) {
+            *dest++ = get(index);
+        }
+        for (; index + block_size <= last; index += block_size, dest += block_size) {
+            vector_detail::unpack_block<Bits>(words + index / block_size * Bits, dest);
+        }
+        for (; index < last; ++index) {
+            *dest++ = get(index);
+        }
+    }
+
+    // Decodes every element into a plain Vector.
+    template <typename VectorAllocator = std::allocator<value_type>>
+    [[nodiscard]] Vector<value_type, VectorAllocator> unpack(const VectorAllocator& allocator = VectorAllocator()) const
+    {
+        Vector<value_type, VectorAllocator> result(allocator);
+        unpack(0, result.append_uninitialized(_size));
+        return result;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, _size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, _size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Compares element by element, a word at a time.
+    friend bool operator==(const PackedIntVector& lhs, const PackedIntVector& rhs) noexcept
+    {
+        return lhs._size == rhs._size && std::equal(lhs._words.begin(), lhs._words.end(), rhs._words.begin());
+    }
+
+private:
+    value_type get(size_type index) const noexcept
+    {
+        return static_cast<value_type>(vector_detail::read_field<Bits>(_words.data(), index * Bits));
+    }
+
+    // Writes the low Bits bits of value into element index, which may straddle two words.
+    void put(size_type index, value_type value) noexcept
+    {
+        VECTOR_ASSERT((static_cast<word_type>(value) & ~mask) == 0, "value wider than Bits");
+        const word_type field = static_cast<word_type>(value) & mask;
+        const size_type bit = index * Bits;
+        const size_type offset = bit % word_bits;
+        word_type* word = _words.data() + bit / word_bits;
+        word[0] = (word[0] & ~(mask << offset)) | (field << offset);
+        if (offset + Bits > word_bits) {
+            const size_type spill = word_bits - offset;
+            word[1] = (word[1] & ~(mask >> spill)) | (field >> spill);
+        }
+    }
+
+    Vector<word_type, Allocator> _words;
+    size_type _size = 0;
+};
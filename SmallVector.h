@@ -0,0 +1,537 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+// Vector with room for N elements inside the object itself.
+// Elements live in the inline buffer until the size exceeds N, then spill to heap storage
+// obtained from Allocator and grown by GrowthPolicy exactly like Vector. Shrinking never moves
+// elements back inline.
+template <typename T, std::size_t N, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+class SmallVector
+{
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static_assert(N > 0, "SmallVector needs at least one inline element; use Vector instead");
+    static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                  "SmallVector requires Allocator::value_type to match T");
+    static_assert(std::is_same_v<typename alloc_traits::pointer, T*>,
+                  "SmallVector requires an allocator with raw pointers");
+
+    static constexpr bool trivial_destroy =
+        std::is_trivially_destructible_v<T> && vector_detail::uses_default_destroy<Allocator, T>;
+    static constexpr bool trivial_relocate =
+        is_trivially_relocatable_v<T> &&
+        vector_detail::uses_default_construct<Allocator, T> &&
+        vector_detail::uses_default_destroy<Allocator, T>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
+    using size_type = std::size_t;
+    using pointer_type = T*;
+    using const_pointer_type = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = VectorIterator<T>;
+    using const_iterator = VectorIterator<const T>;
+
+    static constexpr size_type inline_capacity = N;
+    // Alignment of data(), honoured by the inline buffer as well as by heap blocks.
+    static constexpr size_type alignment = vector_detail::allocator_alignment<Allocator, T>();
+
+    // Constructs an empty vector using the inline buffer.
+    SmallVector() noexcept(noexcept(Allocator()))
+        : _data(inline_data()), _allocator() {}
+
+    // Constructs an empty vector that spills to the given allocator.
+    explicit SmallVector(const Allocator& allocator) noexcept
+        : _data(inline_data()), _allocator(allocator) {}
+
+    // Copies elements from another vector, staying inline when they fit. Delegating lets the
+    // destructor free a spilled heap buffer if a copy throws.
+    SmallVector(const SmallVector& other)
+        : SmallVector(alloc_traits::select_on_container_copy_construction(other._allocator))
+    {
+        append_copies(other);
+    }
+
+    // Takes another vector's heap buffer, or moves its inline elements one by one.
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T> || trivial_relocate)
+        : _data(inline_data()), _allocator(std::move(other._allocator))
+    {
+        take(other);
+    }
+
+    // Assigns from another vector by making a deep copy.
+    SmallVector& operator=(const SmallVector& other)
+    {
+        if (this != &other) {
+            clear();
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (!alloc_traits::is_always_equal::value && _allocator != other._allocator) {
+                    release_heap();
+                }
+                _allocator = other._allocator;
+            }
+            append_copies(other);
+        }
+        return *this;
+    }
+
+    // Assigns from another vector, taking its heap buffer when the allocators allow it. Unequal
+    // allocators that do not propagate force an allocation, and inline elements always move one
+    // by one, so either can throw.
+    SmallVector& operator=(SmallVector&& other) noexcept(
+        (alloc_traits::propagate_on_container_move_assignment::value || alloc_traits::is_always_equal::value) &&
+        (std::is_nothrow_move_constructible_v<T> || trivial_relocate))
+    {
+        if (this != &other) {
+            clear();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                release_heap();
+                _allocator = std::move(other._allocator);
+                take(other);
+            } else if (alloc_traits::is_always_equal::value || _allocator == other._allocator) {
+                release_heap();
+                take(other);
+            } else {
+                // the heap buffer cannot change hands, so every element moves
+                reserve(other._size);
+                move_elements(other, 0, other._size);
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // Exchanges contents with another vector, whichever storage each one is using. Heap buffers
+    // change hands, and inline elements are swapped only where both vectors hold one; the rest
+    // are relocated.
+    void swap(SmallVector& other) noexcept(
+        trivial_relocate || (std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>))
+    {
+        if (this == &other) return;
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(_allocator, other._allocator);
+        }
+        if (!is_inline() && !other.is_inline()) {
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+            std::swap(_capacity, other._capacity);
+        } else if (!is_inline()) {
+            hand_heap_to(other);
+        } else if (!other.is_inline()) {
+            other.hand_heap_to(*this);
+        } else {
+            swap_inline(other);
+        }
+    }
+
+    // Exchanges contents with another vector.
+    friend void swap(SmallVector& lhs, SmallVector& rhs) noexcept(noexcept(lhs.swap(rhs)))
+    {
+        lhs.swap(rhs);
+    }
+
+    // Releases all elements and frees any heap storage.
+    ~SmallVector()
+    {
+        destroy_range(0, _size);
+        release_heap();
+    }
+
+    // Returns a copy of the allocator used for heap storage.
+    [[nodiscard]] allocator_type get_allocator() const noexcept
+    {
+        return _allocator;
+    }
+
+    // Returns how many elements are currently stored.
+    [[nodiscard]] size_type size() const
+    {
+        return _size;
+    }
+
+    // Returns how many elements can be stored without further allocation.
+    [[nodiscard]] size_type capacity() const
+    {
+        return _capacity;
+    }
+
+    // Indicates whether the vector contains no elements.
+    [[nodiscard]] bool empty() const
+    {
+        return _size == 0;
+    }
+
+    // Indicates whether the elements currently live in the inline buffer.
+    [[nodiscard]] bool is_inline() const noexcept
+    {
+        return _data == inline_data();
+    }
+
+    // Provides direct access to the underlying mutable buffer.
+    pointer_type data()
+    {
+        return _data;
+    }
+
+    // Provides direct access to the underlying immutable buffer.
+    const_pointer_type data() const noexcept
+    {
+        return _data;
+    }
+
+    // Returns a reference to the element at the supplied index, throwing if it is out of range.
+    reference at(size_type index)
+    {
+        if (index >= _size) vector_detail::throw_out_of_range("index out of range");
+        return _data[index];
+    }
+
+    // Returns a const reference to the element at the supplied index, throwing if it is out of range.
+    const_reference at(size_type index) const
+    {
+        if (index >= _size) vector_detail::throw_out_of_range("index out of range");
+        return _data[index];
+    }
+
+    // Returns a reference to the element at the supplied index without a bounds check.
+    reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return _data[index];
+    }
+
+    // Returns a const reference to the element at the supplied index without a bounds check.
+    const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return _data[index];
+    }
+
+    // Returns a reference to the first element.
+    reference front()
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty vector");
+        return _data[0];
+    }
+
+    // Returns a const reference to the first element.
+    const_reference front() const
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty vector");
+        return _data[0];
+    }
+
+    // Returns a reference to the last element.
+    reference back()
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty vector");
+        return _data[_size - 1];
+    }
+
+    // Returns a const reference to the last element.
+    const_reference back() const
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty vector");
+        return _data[_size - 1];
+    }
+
+    // Destroys all elements while retaining the current storage.
+    void clear()
+    {
+        destroy_range(0, _size);
+        _size = 0;
+    }
+
+    // Appends a copy of the provided value to the end of the vector.
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    // Appends the provided value by moving it into the vector.
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    // Constructs a new element in place at the end using the supplied arguments, which may refer
+    // to an element of this vector.
+    template<typename... Args>
+    reference emplace_back(Args&& ... args)
+    {
+        if (_size == _capacity) return emplace_back_grow(std::forward<Args>(args)...);
+        alloc_traits::construct(_allocator, _data + _size, std::forward<Args>(args)...);
+        ++_size;
+        return _data[_size - 1];
+    }
+
+    // Removes the last element if the vector is not empty.
+    void pop_back()
+    {
+        if (_size > 0)
+        {
+            alloc_traits::destroy(_allocator, _data + _size - 1);
+            --_size;
+        }
+    }
+
+    // Reserves memory for new_cap capacity, spilling to the heap past the inline buffer.
+    void reserve(size_type new_cap)
+    {
+        if (new_cap > _capacity) grow(new_cap);
+    }
+
+    // Grows or shrinks the vector to the requested size.
+    void resize(size_type new_size)
+    {
+        if (new_size < _size) {
+            destroy_range(new_size, _size);
+            _size = new_size;
+            return;
+        }
+
+        reserve(new_size);
+        size_type i = _size;
+        VECTOR_TRY {
+            for (; i < new_size; ++i) {
+                alloc_traits::construct(_allocator, _data + i);
+            }
+        } VECTOR_CATCH_ALL {
+            destroy_range(_size, i);
+            VECTOR_RETHROW;
+        }
+        _size = new_size;
+    }
+
+    // VectorIterators
+    // Returns an iterator to the first element.
+    iterator begin() noexcept
+    {
+        return iterator(_data);
+    }
+
+    // Returns an iterator one past the last element.
+    iterator end() noexcept
+    {
+        return iterator(_data + _size);
+    }
+
+    // Returns a const iterator to the first element.
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(_data);
+    }
+
+    // Returns a const iterator one past the last element.
+    const_iterator end() const noexcept
+    {
+        return const_iterator(_data + _size);
+    }
+
+    // Returns a const iterator to the first element (C++ standard naming).
+    const_iterator cbegin() const noexcept
+    {
+        return const_iterator(_data);
+    }
+
+    // Returns a const iterator one past the last element (C++ standard naming).
+    const_iterator cend() const noexcept
+    {
+        return const_iterator(_data + _size);
+    }
+
+private:
+    // Returns the start of the inline buffer.
+    pointer_type inline_data() noexcept
+    {
+        return reinterpret_cast<pointer_type>(_inline);
+    }
+
+    // Returns the start of the inline buffer (const).
+    const_pointer_type inline_data() const noexcept
+    {
+        return reinterpret_cast<const_pointer_type>(_inline);
+    }
+
+    // Moves the elements into a heap buffer of new_capacity, freeing any previous heap buffer.
+    void grow(size_type new_capacity)
+    {
+        move_storage(alloc_traits::allocate(_allocator, new_capacity), new_capacity);
+    }
+
+    // Grows for emplace_back(). The new element is constructed in the new buffer before the old
+    // elements move, since args may refer to one of them.
+    template <typename... Args>
+    reference emplace_back_grow(Args&&... args)
+    {
+        const size_type new_capacity = GrowthPolicy::next_capacity(_capacity, _size + 1, sizeof(T));
+        pointer_type new_data = alloc_traits::allocate(_allocator, new_capacity);
+        VECTOR_TRY {
+            alloc_traits::construct(_allocator, new_data + _size, std::forward<Args>(args)...);
+        } VECTOR_CATCH_ALL {
+            alloc_traits::deallocate(_allocator, new_data, new_capacity);
+            VECTOR_RETHROW;
+        }
+        move_storage(new_data, new_capacity, 1);
+        ++_size;
+        return _data[_size - 1];
+    }
+
+    // Moves the elements into new_data, a heap buffer of new_capacity, and frees any previous
+    // heap buffer. appended elements already constructed past the moved ones are destroyed if a
+    // move throws.
+    void move_storage(pointer_type new_data, size_type new_capacity, size_type appended = 0)
+    {
+        if constexpr (trivial_relocate) {
+            if (_size > 0) std::memcpy(static_cast<void*>(new_data), _data, _size * sizeof(T));
+        } else {
+            size_type i = 0;
+            VECTOR_TRY {
+                for (; i < _size; ++i) {
+                    alloc_traits::construct(_allocator, new_data + i, std::move_if_noexcept(_data[i]));
+                }
+            } VECTOR_CATCH_ALL {
+                for (size_type j = 0; j < i; ++j) {
+                    alloc_traits::destroy(_allocator, new_data + j);
+                }
+                for (size_type j = 0; j < appended; ++j) {
+                    alloc_traits::destroy(_allocator, new_data + _size + j);
+                }
+                alloc_traits::deallocate(_allocator, new_data, new_capacity);
+                VECTOR_RETHROW;
+            }
+            destroy_range(0, _size);
+        }
+
+        release_heap();
+        _data = new_data;
+        _capacity = new_capacity;
+    }
+
+    // Passes this vector's heap buffer to inline_vector, whose elements move into this vector's
+    // inline buffer.
+    void hand_heap_to(SmallVector& inline_vector) noexcept(trivial_relocate || std::is_nothrow_move_constructible_v<T>)
+    {
+        pointer_type buffer = _data;
+        const size_type size = _size;
+        const size_type capacity = _capacity;
+        _data = inline_data();
+        _size = 0;
+        _capacity = N;
+        take(inline_vector);
+        inline_vector._data = buffer;
+        inline_vector._size = size;
+        inline_vector._capacity = capacity;
+    }
+
+    // Exchanges the elements of two inline vectors: the common prefix is swapped in place and the
+    // longer one's tail moves across.
+    void swap_inline(SmallVector& other) noexcept(
+        trivial_relocate || (std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>))
+    {
+        if constexpr (trivial_relocate) {
+            const size_type bytes = (_size > other._size ? _size : other._size) * sizeof(T);
+            std::byte* mine = reinterpret_cast<std::byte*>(_data);
+            std::swap_ranges(mine, mine + bytes, reinterpret_cast<std::byte*>(other._data));
+            std::swap(_size, other._size);
+        } else {
+            SmallVector& shorter = _size < other._size ? *this : other;
+            SmallVector& longer = _size < other._size ? other : *this;
+            const size_type common = shorter._size;
+            const size_type total = longer._size;
+            std::swap_ranges(shorter._data, shorter._data + common, longer._data);
+            shorter.move_elements(longer, common, total);
+            longer.destroy_range(common, total);
+            longer._size = common;
+        }
+    }
+
+    // Copy-constructs other's elements after the current ones.
+    void append_copies(const SmallVector& other)
+    {
+        reserve(other._size);
+        size_type i = 0;
+        VECTOR_TRY {
+            for (; i < other._size; ++i) {
+                alloc_traits::construct(_allocator, _data + _size + i, other._data[i]);
+            }
+        } VECTOR_CATCH_ALL {
+            destroy_range(_size, _size + i);
+            VECTOR_RETHROW;
+        }
+        _size += other._size;
+    }
+
+    // Move-constructs other's elements in [first, last) after the current ones.
+    void move_elements(SmallVector& other, size_type first, size_type last)
+    {
+        for (size_type i = first; i < last; ++i) {
+            alloc_traits::construct(_allocator, _data + _size, std::move(other._data[i]));
+            ++_size;
+        }
+    }
+
+    // Adopts other's contents into an empty, inline this, leaving other empty and inline.
+    void take(SmallVector& other)
+    {
+        if (!other.is_inline()) {
+            _data = other._data;
+            _size = other._size;
+            _capacity = other._capacity;
+            other._data = other.inline_data();
+            other._size = 0;
+            other._capacity = N;
+            return;
+        }
+
+        // inline elements cannot change hands, so they are relocated one by one
+        if constexpr (trivial_relocate) {
+            if (other._size > 0) std::memcpy(static_cast<void*>(_data), other._data, other._size * sizeof(T));
+            _size = other._size;
+            other._size = 0;
+        } else {
+            move_elements(other, 0, other._size);
+            other.clear();
+        }
+    }
+
+    // Destroys the elements in [first, last).
+    void destroy_range(size_type first, size_type last) noexcept
+    {
+        if constexpr (!trivial_destroy) {
+            for (size_type i = first; i < last; ++i) {
+                alloc_traits::destroy(_allocator, _data + i);
+            }
+        }
+    }
+
+    // Returns an empty heap buffer to the allocator and switches back to the inline buffer.
+    void release_heap() noexcept
+    {
+        if (!is_inline()) {
+            alloc_traits::deallocate(_allocator, _data, _capacity);
+            _data = inline_data();
+            _capacity = N;
+        }
+    }
+
+private:
+    alignas(alignment) std::byte _inline[N * sizeof(T)];
+    size_t _capacity = N;
+    size_t _size = 0;
+    T* _data;
+    [[no_unique_address]] Allocator _allocator;
+
+};
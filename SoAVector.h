@@ -0,0 +1,502 @@
+#pragma once
+
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "Allocator.h"
+#include "GrowthPolicy.h"
+#include "Vector.h"
+#include "VectorView.h"
+
+// Structure-of-arrays sequence: one contiguous column per field, all sharing a single size and
+// capacity and carved out of a single allocation. A scan that reads two fields of a row streams
+// just those two columns through the cache, and each column is a plain array the compiler can
+// vectorize. Columns start on column_alignment boundaries within the block.
+//
+// Rows are added and read as tuples: push_back/emplace_back take one value per field, and
+// operator[] and the row iterators yield a tuple of references into the columns. column<I>()
+// returns a VectorView over one field, which converts to std::span.
+template <typename... Fields>
+class SoAVector
+{
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+    static_assert(sizeof...(Fields) <= 64, "SoAVector supports at most 64 fields");
+    static_assert((std::is_object_v<Fields> && ...) && (!std::is_const_v<Fields> && ...),
+                  "SoAVector fields must be non-const object types");
+
+    static constexpr std::size_t column_count = sizeof...(Fields);
+
+    template <std::size_t I>
+    using field_t = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    template <typename F>
+    static constexpr bool trivial_relocate = is_trivially_relocatable_v<F>;
+
+    // Columns whose elements can move to a new block without any chance of throwing.
+    template <typename F>
+    static constexpr bool nothrow_relocate = trivial_relocate<F> || std::is_nothrow_move_constructible_v<F>;
+
+    using byte_allocator = AlignedAllocator<std::byte, 64>;
+    using Columns = std::tuple<Fields*...>;
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using reference = std::tuple<Fields&...>;
+    using const_reference = std::tuple<const Fields&...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+private:
+    // Random access iterator over rows; dereferencing yields a tuple of references.
+    template <bool Const>
+    class RowIterator
+    {
+        using Owner = std::conditional_t<Const, const SoAVector, SoAVector>;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::input_iterator_tag; // proxy references are not real references
+        using value_type = SoAVector::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, SoAVector::const_reference, SoAVector::reference>;
+
+        RowIterator() noexcept = default;
+
+        RowIterator(Owner* owner, std::size_t index) noexcept
+            : _owner(owner), _index(index) {}
+
+        // Converts a mutable row iterator into a const one.
+        template <bool OtherConst>
+            requires(Const && !OtherConst)
+        RowIterator(const RowIterator<OtherConst>& other) noexcept
+            : _owner(other._owner), _index(other._index) {}
+
+        reference operator*() const { return (*_owner)[_index]; }
+        reference operator[](difference_type offset) const { return (*_owner)[_index + offset]; }
+
+        RowIterator& operator++() noexcept { ++_index; return *this; }
+        RowIterator operator++(int) noexcept { RowIterator old = *this; ++_index; return old; }
+        RowIterator& operator--() noexcept { --_index; return *this; }
+        RowIterator operator--(int) noexcept { RowIterator old = *this; --_index; return old; }
+        RowIterator& operator+=(difference_type offset) noexcept { _index += offset; return *this; }
+        RowIterator& operator-=(difference_type offset) noexcept { _index -= offset; return *this; }
+
+        friend RowIterator operator+(RowIterator it, difference_type offset) noexcept { return it += offset; }
+        friend RowIterator operator+(difference_type offset, RowIterator it) noexcept { return it += offset; }
+        friend RowIterator operator-(RowIterator it, difference_type offset) noexcept { return it -= offset; }
+        friend difference_type operator-(const RowIterator& lhs, const RowIterator& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+        }
+        friend bool operator==(const RowIterator& lhs, const RowIterator& rhs) noexcept { return lhs._index == rhs._index; }
+        friend std::strong_ordering operator<=>(const RowIterator& lhs, const RowIterator& rhs) noexcept
+        {
+            return lhs._index <=> rhs._index;
+        }
+
+    private:
+        template <bool>
+        friend class RowIterator;
+
+        Owner* _owner = nullptr;
+        std::size_t _index = 0;
+    };
+
+public:
+    using iterator = RowIterator<false>;
+    using const_iterator = RowIterator<true>;
+
+    // Alignment of every column's first element.
+    static constexpr size_type column_alignment = 64;
+
+    static_assert(((alignof(Fields) <= column_alignment) && ...), "SoAVector fields cannot be over-aligned beyond 64");
+
+    // Constructs an empty container with zero capacity.
+    SoAVector() noexcept = default;
+
+    // Copies every row of other into a block of exactly its size. Delegating to the default
+    // constructor lets the destructor free the rows built so far if a copy throws.
+    SoAVector(const SoAVector& other)
+        : SoAVector()
+    {
+        reserve(other._size);
+        for (size_type i = 0; i < other._size; ++i) {
+            emplace_row(other[i]);
+        }
+    }
+
+    // Takes ownership of other's block without touching any element.
+    SoAVector(SoAVector&& other) noexcept
+        : _block(std::exchange(other._block, nullptr)), _columns(std::exchange(other._columns, Columns{})),
+          _size(std::exchange(other._size, 0)), _capacity(std::exchange(other._capacity, 0)) {}
+
+    // Replaces the contents with a copy of other.
+    SoAVector& operator=(const SoAVector& other)
+    {
+        if (this != &other) {
+            SoAVector temp(other);
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Replaces the contents with other's block.
+    SoAVector& operator=(SoAVector&& other) noexcept
+    {
+        if (this != &other) {
+            SoAVector temp(std::move(other));
+            swap(temp);
+        }
+        return *this;
+    }
+
+    // Destroys every row and frees the block.
+    ~SoAVector()
+    {
+        clear();
+        release_block(_block, _capacity);
+    }
+
+    // Exchanges all with another container.
+    void swap(SoAVector& other) noexcept
+    {
+        std::swap(_block, other._block);
+        std::swap(_columns, other._columns);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    // Returns how many rows are stored.
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // Returns how many rows fit before the block is reallocated.
+    [[nodiscard]] size_type capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    // Indicates whether the container holds no rows.
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // Returns a view over every value of field I.
+    template <std::size_t I>
+    VectorView<field_t<I>> column() noexcept
+    {
+        return {std::get<I>(_columns), _size};
+    }
+
+    // Returns a read-only view over every value of field I.
+    template <std::size_t I>
+    VectorView<const field_t<I>> column() const noexcept
+    {
+        return {std::get<I>(_columns), _size};
+    }
+
+    // Returns references to every field of the row at index without a bounds check.
+    reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return row<reference>(index, std::index_sequence_for<Fields...>{});
+    }
+
+    // Returns const references to every field of the row at index without a bounds check.
+    const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return row<const_reference>(index, std::index_sequence_for<Fields...>{});
+    }
+
+    // Returns references to the row at index, throwing if it is out of range.
+    reference at(size_type index)
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return (*this)[index];
+    }
+
+    // Returns const references to the row at index, throwing if it is out of range.
+    const_reference at(size_type index) const
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return (*this)[index];
+    }
+
+    // Returns references to the first row.
+    reference front()
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty SoAVector");
+        return (*this)[0];
+    }
+
+    // Returns references to the last row.
+    reference back()
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty SoAVector");
+        return (*this)[_size - 1];
+    }
+
+    // Appends a copy of row.
+    void push_back(const value_type& row)
+    {
+        emplace_row(row);
+    }
+
+    // Appends row, moving each field into its column.
+    void push_back(value_type&& row)
+    {
+        emplace_row(std::move(row));
+    }
+
+    // Appends a row whose field I is constructed from the I-th argument, and returns references
+    // to it. If a field's constructor throws, the fields already built are destroyed again.
+    template <typename... Args>
+        requires(sizeof...(Args) == column_count)
+    reference emplace_back(Args&&... args)
+    {
+        emplace_row(std::forward_as_tuple(std::forward<Args>(args)...));
+        return (*this)[_size - 1];
+    }
+
+    // Destroys the last row.
+    void pop_back()
+    {
+        VECTOR_ASSERT(_size > 0, "pop_back() on empty SoAVector");
+        --_size;
+        destroy_rows(_size, _size + 1, std::index_sequence_for<Fields...>{});
+    }
+
+    // Destroys every row, keeping the block.
+    void clear() noexcept
+    {
+        destroy_rows(0, _size, std::index_sequence_for<Fields...>{});
+        _size = 0;
+    }
+
+    // Grows or shrinks to count rows; new rows are value-initialized.
+    void resize(size_type count)
+    {
+        if (count < _size) {
+            destroy_rows(count, _size, std::index_sequence_for<Fields...>{});
+            _size = count;
+            return;
+        }
+        reserve(count);
+        while (_size < count) {
+            emplace_back(Fields()...);
+        }
+    }
+
+    // Moves every column into a block for at least new_capacity rows. Columns that might throw
+    // while moving are copied first, so a throw leaves the container untouched.
+    void reserve(size_type new_capacity)
+    {
+        if (new_capacity <= _capacity) return;
+        reallocate(new_capacity);
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, _size); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator end() const noexcept { return const_iterator(this, _size); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // Compares row by row.
+    friend bool operator==(const SoAVector& lhs, const SoAVector& rhs)
+    {
+        if (lhs._size != rhs._size) return false;
+        for (size_type i = 0; i < lhs._size; ++i) {
+            if (lhs[i] != rhs[i]) return false;
+        }
+        return true;
+    }
+
+private:
+    // Byte offset of every column in a block for capacity rows, plus the block size at the end.
+    static constexpr std::array<std::size_t, column_count + 1> layout(size_type capacity) noexcept
+    {
+        constexpr std::size_t sizes[] = {sizeof(Fields)...};
+        std::array<std::size_t, column_count + 1> offsets{};
+        std::size_t offset = 0;
+        for (std::size_t i = 0; i < column_count; ++i) {
+            offsets[i] = offset;
+            offset += (capacity * sizes[i] + column_alignment - 1) / column_alignment * column_alignment;
+        }
+        offsets[column_count] = offset;
+        return offsets;
+    }
+
+    // Largest row count whose block size still fits in size_t.
+    static constexpr size_type max_rows() noexcept
+    {
+        return (static_cast<size_type>(-1) - column_count * column_alignment) / (sizeof(Fields) + ...);
+    }
+
+    template <typename Ref, std::size_t... Is>
+    Ref row(size_type index, std::index_sequence<Is...>) const noexcept
+    {
+        return Ref(std::get<Is>(_columns)[index]...);
+    }
+
+    // Appends one row built from the fields of values, a tuple of one argument per column. When
+    // the block is full the row is built in the new block before any old row moves, since values
+    // may refer to one of them.
+    template <typename Tuple>
+    void emplace_row(Tuple&& values)
+    {
+        if (_size == _capacity) {
+            reallocate(DoublingGrowth::next_capacity(_capacity, _size + 1, (sizeof(Fields) + ...)), 1,
+                       [&](const Columns& columns) {
+                           construct_row(columns, std::forward<Tuple>(values), std::index_sequence_for<Fields...>{});
+                       });
+        } else {
+            construct_row(_columns, std::forward<Tuple>(values), std::index_sequence_for<Fields...>{});
+        }
+        ++_size;
+    }
+
+    // Builds row _size of columns from values, or nothing if a field throws.
+    template <typename Tuple, std::size_t... Is>
+    void construct_row(const Columns& columns, Tuple&& values, std::index_sequence<Is...>)
+    {
+        std::uint64_t built = 0;
+        try {
+            ((::new (static_cast<void*>(std::get<Is>(columns) + _size))
+                  field_t<Is>(std::get<Is>(std::forward<Tuple>(values))),
+              built |= std::uint64_t{1} << Is),
+             ...);
+        } catch (...) {
+            ((built >> Is & 1 ? std::destroy_at(std::get<Is>(columns) + _size) : void()), ...);
+            throw;
+        }
+    }
+
+    template <std::size_t... Is>
+    void destroy_rows(size_type first, size_type last, std::index_sequence<Is...> fields) noexcept
+    {
+        destroy_rows_in(_columns, first, last, fields);
+    }
+
+    template <std::size_t... Is>
+    static void destroy_rows_in(const Columns& columns, size_type first, size_type last, std::index_sequence<Is...>) noexcept
+    {
+        (std::destroy(std::get<Is>(columns) + first, std::get<Is>(columns) + last), ...);
+    }
+
+    void reallocate(size_type new_capacity)
+    {
+        reallocate(new_capacity, 0, [](const Columns&) {});
+    }
+
+    // Moves every row into a block for new_capacity rows after build has constructed appended
+    // further rows past them in the new block; nothing changes if either step throws.
+    template <typename Build>
+    void reallocate(size_type new_capacity, size_type appended, Build&& build)
+    {
+        if (new_capacity > max_rows()) throw std::length_error("SoAVector capacity overflows");
+        const auto offsets = layout(new_capacity);
+        std::byte* block = byte_allocator().allocate(offsets[column_count]);
+        Columns columns = columns_in(block, offsets, std::index_sequence_for<Fields...>{});
+        try {
+            build(columns);
+        } catch (...) {
+            release_block(block, new_capacity);
+            throw;
+        }
+
+        // columns that may throw are copied while every old element is still intact
+        std::uint64_t copied = 0;
+        try {
+            copy_throwing_columns(columns, copied, std::index_sequence_for<Fields...>{});
+        } catch (...) {
+            destroy_copied_columns(columns, copied, std::index_sequence_for<Fields...>{});
+            destroy_rows_in(columns, _size, _size + appended, std::index_sequence_for<Fields...>{});
+            release_block(block, new_capacity);
+            throw;
+        }
+        move_nothrow_columns(columns, std::index_sequence_for<Fields...>{});
+        destroy_old_columns(std::index_sequence_for<Fields...>{});
+
+        release_block(_block, _capacity);
+        _block = block;
+        _columns = columns;
+        _capacity = new_capacity;
+    }
+
+    template <std::size_t... Is>
+    static Columns columns_in(std::byte* block, const std::array<std::size_t, column_count + 1>& offsets,
+                              std::index_sequence<Is...>) noexcept
+    {
+        return Columns(reinterpret_cast<field_t<Is>*>(block + offsets[Is])...);
+    }
+
+    template <std::size_t... Is>
+    void copy_throwing_columns(const Columns& columns, std::uint64_t& copied, std::index_sequence<Is...>)
+    {
+        (copy_column<Is>(columns, copied), ...);
+    }
+
+    template <std::size_t I>
+    void copy_column(const Columns& columns, std::uint64_t& copied)
+    {
+        if constexpr (!nothrow_relocate<field_t<I>>) {
+            std::uninitialized_copy_n(std::get<I>(_columns), _size, std::get<I>(columns));
+            copied |= std::uint64_t{1} << I;
+        }
+    }
+
+    template <std::size_t... Is>
+    void destroy_copied_columns(const Columns& columns, std::uint64_t copied, std::index_sequence<Is...>) noexcept
+    {
+        ((copied >> Is & 1 ? void(std::destroy_n(std::get<Is>(columns), _size)) : void()), ...);
+    }
+
+    template <std::size_t... Is>
+    void move_nothrow_columns(const Columns& columns, std::index_sequence<Is...>) noexcept
+    {
+        (move_column<Is>(columns), ...);
+    }
+
+    template <std::size_t I>
+    void move_column(const Columns& columns) noexcept
+    {
+        using F = field_t<I>;
+        if constexpr (trivial_relocate<F>) {
+            if (_size > 0) std::memcpy(static_cast<void*>(std::get<I>(columns)), std::get<I>(_columns), _size * sizeof(F));
+        } else if constexpr (nothrow_relocate<F>) {
+            std::uninitialized_move_n(std::get<I>(_columns), _size, std::get<I>(columns));
+        }
+    }
+
+    // Ends the lifetime of every old element except trivially relocated ones, whose bytes moved.
+    template <std::size_t... Is>
+    void destroy_old_columns(std::index_sequence<Is...>) noexcept
+    {
+        ((trivial_relocate<field_t<Is>> ? void() : void(std::destroy_n(std::get<Is>(_columns), _size))), ...);
+    }
+
+    static void release_block(std::byte* block, size_type capacity) noexcept
+    {
+        if (block) byte_allocator().deallocate(block, layout(capacity)[column_count]);
+    }
+
+    std::byte* _block = nullptr;
+    Columns _columns{};
+    size_type _size = 0;
+    size_type _capacity = 0;
+};
@@ -1,40 +1,179 @@
 #pragma once
 
+#include <algorithm>
+#include <compare>
+#include <concepts>
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <expected>
+#include <functional>
+#include <initializer_list>
 #include <iterator>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
 #include <memory>
+#include <new>
+#include <type_traits>
+
+#include "GrowthPolicy.h"
+#include "VectorStats.h"
+
+// operator[], front() and back() are unchecked. Defining VECTOR_HARDENED turns their
+// preconditions into assert()s, which, like any assert, compile away under NDEBUG.
+#if defined(VECTOR_HARDENED)
+#include <cassert>
+#define VECTOR_ASSERT(condition, message) assert((condition) && (message))
+#else
+#define VECTOR_ASSERT(condition, message) ((void)0)
+#endif
+
+// Vector also builds without exceptions, e.g. under -fno-exceptions, or with VECTOR_NO_EXCEPTIONS
+// defined. Then the rollback handlers compile away and at() prints its message and aborts where it
+// would throw. Allocation failure is whatever the allocator does on its own, usually
+// terminating, unless it goes through try_reserve(), try_push_back() or try_emplace_back(),
+// which report it as an AllocError instead.
+#if !defined(VECTOR_NO_EXCEPTIONS) && !defined(__cpp_exceptions) && !defined(__EXCEPTIONS)
+#define VECTOR_NO_EXCEPTIONS
+#endif
+
+#if defined(VECTOR_NO_EXCEPTIONS)
+#define VECTOR_TRY if (true)
+#define VECTOR_CATCH_ALL else
+#define VECTOR_RETHROW ((void)0)
+#else
+#define VECTOR_TRY try
+#define VECTOR_CATCH_ALL catch (...)
+#define VECTOR_RETHROW throw
+#endif
+
+// Why a try_* member of Vector could not get the storage it needed.
+enum class AllocError {
+    capacity_overflow, // more elements than max_size()
+    out_of_memory,     // the allocator had no block of that size
+};
+
+// Opt-in trait for types whose objects can be moved to a new address by copying their bytes,
+// without running the move constructor and destructor. Trivially copyable types qualify
+// automatically; specialize this for handle types that only own a pointer.
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+// Owning pointers with the default deleter hold nothing but the pointer itself.
+template <typename T>
+struct is_trivially_relocatable<std::unique_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+namespace vector_detail {
+
+// True when an allocator leaves construction to placement new, i.e. has no construct() of its own.
+template <typename Allocator, typename T>
+inline constexpr bool uses_default_construct = !requires(Allocator& allocator, T* pointer) {
+    allocator.construct(pointer, std::declval<const T&>());
+};
+
+// True when an allocator leaves destruction to the destructor, i.e. has no destroy() of its own.
+template <typename Allocator, typename T>
+inline constexpr bool uses_default_destroy = !requires(Allocator& allocator, T* pointer) {
+    allocator.destroy(pointer);
+};
+
+// True when an allocator can resize a block it handed out, possibly without moving it.
+// Such allocators provide T* reallocate(T* pointer, size_t old_n, size_t new_n), which keeps
+// the block's bytes and leaves the old block untouched if it throws.
+template <typename Allocator, typename T>
+inline constexpr bool has_reallocate = requires(Allocator& allocator, T* pointer, std::size_t n) {
+    { allocator.reallocate(pointer, n, n) } -> std::same_as<T*>;
+};
+
+// True when an allocator can report how much it really handed out.
+// Such allocators provide allocate_at_least(n) returning an object with ptr and count members,
+// the same shape as std::allocation_result.
+template <typename Allocator, typename T>
+inline constexpr bool has_allocate_at_least = requires(Allocator& allocator, std::size_t n) {
+    { allocator.allocate_at_least(n).ptr } -> std::convertible_to<T*>;
+    { allocator.allocate_at_least(n).count } -> std::convertible_to<std::size_t>;
+};
+
+// True when an allocator can fail without throwing.
+// Such allocators provide T* try_allocate(size_t n), which returns nullptr when it has no block
+// and otherwise a block that deallocate() accepts.
+template <typename Allocator, typename T>
+inline constexpr bool has_try_allocate = requires(Allocator& allocator, std::size_t n) {
+    { allocator.try_allocate(n) } -> std::same_as<T*>;
+};
+
+// Reports an out-of-range index: throws std::out_of_range, or without exceptions prints message
+// and aborts.
+[[noreturn]] inline void throw_out_of_range(const char* message)
+{
+#if defined(VECTOR_NO_EXCEPTIONS)
+    std::fprintf(stderr, "%s\n", message);
+    std::abort();
+#else
+    throw std::out_of_range(message);
+#endif
+}
+
+// Alignment every block from an allocator is guaranteed to have. Allocators that over-align
+// advertise it with a static alignment member; all others are only relied on for alignof(T).
+template <typename Allocator, typename T>
+constexpr std::size_t allocator_alignment() noexcept
+{
+    if constexpr (requires { { Allocator::alignment } -> std::convertible_to<std::size_t>; }) {
+        return Allocator::alignment > alignof(T) ? Allocator::alignment : alignof(T);
+    } else {
+        return alignof(T);
+    }
+}
+
+} // namespace vector_detail
 
 template <typename T>
 class VectorIterator
 {
 public:
     using iterator_concept  = std::contiguous_iterator_tag;
-    using value_type = T;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using element_type = T;
     using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
     using pointer_type = T*;
     using const_pointer_type = const T*;
     using reference_type = T&;
     using const_reference = const T&;
 
     // Creates an iterator that does not point to any element.
-    VectorIterator()
+    constexpr VectorIterator()
         : _pointer(nullptr){}
 
     // Creates an iterator bound to the given raw pointer.
-    explicit VectorIterator(pointer_type pointer)
+    explicit constexpr VectorIterator(pointer_type pointer)
         : _pointer(pointer) {}
 
+    // Converts an iterator over mutable elements into one over const elements.
+    template <typename U>
+        requires std::is_same_v<const U, T> && (!std::is_same_v<U, T>)
+    constexpr VectorIterator(const VectorIterator<U>& other)
+        : _pointer(other.operator->()) {}
+
     // Moves the iterator forward to the next element (prefix).
-    VectorIterator& operator++()
+    constexpr VectorIterator& operator++()
     {
         ++_pointer;
         return *this;
     }
 
     // Moves the iterator forward and returns the previous position (postfix).
-    VectorIterator operator++(int)
+    constexpr VectorIterator operator++(int)
     {
         VectorIterator iterator(*this);
         ++(*this);
@@ -42,71 +181,192 @@ public:
     }
 
     // Moves the iterator backward to the previous element (prefix).
-    VectorIterator& operator--()
+    constexpr VectorIterator& operator--()
     {
         --_pointer;
         return *this;
     }
 
     // Moves the iterator backward and returns the previous position (postfix).
-    VectorIterator operator--(int)
+    constexpr VectorIterator operator--(int)
     {
         VectorIterator iterator(*this);
         --(*this);
         return iterator;
     }
 
-    // Provides indexed access relative to the current iterator.
-    reference_type operator[](size_t index) const
+    // Advances the iterator by offset elements.
+    constexpr VectorIterator& operator+=(difference_type offset)
     {
-        return _pointer[index];
+        _pointer += offset;
+        return *this;
     }
 
-    // Exposes the underlying pointer to access members.
-    pointer_type operator->()
+    // Moves the iterator back by offset elements.
+    constexpr VectorIterator& operator-=(difference_type offset)
     {
-        return _pointer;
+        _pointer -= offset;
+        return *this;
     }
 
-    // Exposes the underlying pointer for const access to members.
-    const_pointer_type operator->() const
+    // Returns an iterator offset elements ahead.
+    friend constexpr VectorIterator operator+(VectorIterator iterator, difference_type offset)
     {
-        return _pointer;
+        return iterator += offset;
     }
 
-    // Dereferences the iterator to obtain the referenced element.
-    reference_type operator*()
+    // Returns an iterator offset elements ahead (offset first).
+    friend constexpr VectorIterator operator+(difference_type offset, VectorIterator iterator)
     {
-        return *_pointer;
+        return iterator += offset;
+    }
+
+    // Returns an iterator offset elements behind.
+    friend constexpr VectorIterator operator-(VectorIterator iterator, difference_type offset)
+    {
+        return iterator -= offset;
+    }
+
+    // Returns the number of elements between two iterators.
+    friend constexpr difference_type operator-(const VectorIterator& lhs, const VectorIterator& rhs)
+    {
+        return lhs._pointer - rhs._pointer;
+    }
+
+    // Provides indexed access relative to the current iterator.
+    constexpr reference_type operator[](difference_type index) const
+    {
+        return _pointer[index];
     }
 
-    // Dereferences the iterator to obtain the referenced element (const).
-    const_reference operator*() const
+    // Exposes the underlying pointer to access members.
+    constexpr pointer_type operator->() const
+    {
+        return _pointer;
+    }
+
+    // Dereferences the iterator to obtain the referenced element.
+    constexpr reference_type operator*() const
     {
         return *_pointer;
     }
 
     // Checks whether two iterators refer to the same element.
-    bool operator==(const VectorIterator& other) const
+    friend constexpr bool operator==(const VectorIterator& lhs, const VectorIterator& rhs)
     {
-        return _pointer == other._pointer;
+        return lhs._pointer == rhs._pointer;
     }
 
-    // Checks whether two iterators refer to different elements.
-    bool operator!=(const VectorIterator& other) const
+    // Orders iterators by the position of the elements they refer to.
+    friend constexpr std::strong_ordering operator<=>(const VectorIterator& lhs, const VectorIterator& rhs)
     {
-        return _pointer != other._pointer;
+        return lhs._pointer <=> rhs._pointer;
     }
 
 private:
     pointer_type _pointer;
 };
 
-template<typename T> // declare allocator in header for future
+// Random access iterator for containers whose elements are not contiguous: it holds the
+// container and an index and dereferences through the container's operator[], so it survives
+// anything that keeps that index valid.
+template <typename Owner, typename T>
+class IndexIterator
+{
+public:
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    // Creates an iterator that does not point into any container.
+    constexpr IndexIterator() noexcept = default;
+
+    // Creates an iterator to the element at index of owner.
+    constexpr IndexIterator(Owner* owner, std::size_t index) noexcept
+        : _owner(owner), _index(index) {}
+
+    // Converts an iterator over mutable elements into one over const elements.
+    template <typename OtherOwner, typename U>
+        requires(std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+    constexpr IndexIterator(const IndexIterator<OtherOwner, U>& other) noexcept
+        : _owner(other._owner), _index(other._index) {}
+
+    constexpr reference operator*() const { return (*_owner)[_index]; }
+    constexpr pointer operator->() const { return &(*_owner)[_index]; }
+    constexpr reference operator[](difference_type offset) const { return (*_owner)[_index + offset]; }
+
+    constexpr IndexIterator& operator++() noexcept { ++_index; return *this; }
+    constexpr IndexIterator operator++(int) noexcept { IndexIterator old = *this; ++_index; return old; }
+    constexpr IndexIterator& operator--() noexcept { --_index; return *this; }
+    constexpr IndexIterator operator--(int) noexcept { IndexIterator old = *this; --_index; return old; }
+    constexpr IndexIterator& operator+=(difference_type offset) noexcept { _index += offset; return *this; }
+    constexpr IndexIterator& operator-=(difference_type offset) noexcept { _index -= offset; return *this; }
+
+    friend constexpr IndexIterator operator+(IndexIterator it, difference_type offset) noexcept { return it += offset; }
+    friend constexpr IndexIterator operator+(difference_type offset, IndexIterator it) noexcept { return it += offset; }
+    friend constexpr IndexIterator operator-(IndexIterator it, difference_type offset) noexcept { return it -= offset; }
+    friend constexpr difference_type operator-(const IndexIterator& lhs, const IndexIterator& rhs) noexcept
+    {
+        return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+    }
+    friend constexpr bool operator==(const IndexIterator& lhs, const IndexIterator& rhs) noexcept { return lhs._index == rhs._index; }
+    friend constexpr std::strong_ordering operator<=>(const IndexIterator& lhs, const IndexIterator& rhs) noexcept
+    {
+        return lhs._index <=> rhs._index;
+    }
+
+private:
+    template <typename, typename>
+    friend class IndexIterator;
+
+    Owner* _owner = nullptr;
+    std::size_t _index = 0;
+};
+
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
 class Vector
 {
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+    static_assert(std::is_same_v<typename alloc_traits::value_type, T>,
+                  "Vector requires Allocator::value_type to match T");
+    static_assert(std::is_same_v<typename alloc_traits::pointer, T*>,
+                  "Vector requires an allocator with raw pointers");
+
+    // Element lifetimes that can be handled with memcpy or skipped without observable difference.
+    static constexpr bool trivial_copy =
+        std::is_trivially_copyable_v<T> && vector_detail::uses_default_construct<Allocator, T>;
+    static constexpr bool trivial_destroy =
+        std::is_trivially_destructible_v<T> && vector_detail::uses_default_destroy<Allocator, T>;
+    static constexpr bool trivial_default_init =
+        std::is_trivially_default_constructible_v<T> && vector_detail::uses_default_construct<Allocator, T>;
+    static constexpr bool trivial_relocate =
+        is_trivially_relocatable_v<T> &&
+        vector_detail::uses_default_construct<Allocator, T> &&
+        vector_detail::uses_default_destroy<Allocator, T>;
+
+    // The same shortcuts for the evaluation at hand: constant evaluation cannot copy object
+    // representations or read objects it never constructed, so it takes the per-element paths.
+    static constexpr bool copy_bytes() noexcept
+    {
+        if consteval { return false; } else { return trivial_copy; }
+    }
+    static constexpr bool relocate_bytes() noexcept
+    {
+        if consteval { return false; } else { return trivial_relocate; }
+    }
+    static constexpr bool skip_default_init() noexcept
+    {
+        if consteval { return false; } else { return trivial_default_init; }
+    }
+
 public:
     using value_type = T;
+    using allocator_type = Allocator;
+    using growth_policy = GrowthPolicy;
     using size_type = std::size_t;
     using pointer_type = T*;
     using const_pointer_type = const T*;
@@ -115,36 +375,52 @@ public:
     using iterator = VectorIterator<T>;
     using const_iterator = VectorIterator<const T>;
 
+    // Alignment of data() whenever the vector holds storage.
+    static constexpr size_type alignment = vector_detail::allocator_alignment<Allocator, T>();
+
+    // Buffer handed out by release(): elements [0, size) are constructed in a block obtained
+    // from the vector's allocator for capacity elements.
+    struct ReleasedBuffer {
+        pointer_type data;
+        size_type size;
+        size_type capacity;
+    };
+
     // Constructs an empty vector with zero capacity.
-    Vector() noexcept
-        : _capacity(0), _size(0), _data(nullptr) {}
+    constexpr Vector(VECTOR_STATS_SITE_ONLY_PARAM) noexcept(noexcept(Allocator()))
+        : _capacity(0), _size(0), _data(nullptr), _allocator() VECTOR_STATS_INIT {}
+
+    // Constructs an empty vector that allocates from the given allocator.
+    explicit constexpr Vector(const Allocator& allocator VECTOR_STATS_SITE_PARAM) noexcept
+        : _capacity(0), _size(0), _data(nullptr), _allocator(allocator) VECTOR_STATS_INIT {}
+
+    // Copies the elements of [first, last), allocating once when the length is known up front.
+    template <std::input_iterator InputIt>
+    constexpr Vector(InputIt first, InputIt last, const Allocator& allocator = Allocator() VECTOR_STATS_SITE_PARAM)
+        : Vector(allocator VECTOR_STATS_SITE_ARG)
+    {
+        assign(first, last);
+    }
+
+    // Copies the elements of an initializer list.
+    constexpr Vector(std::initializer_list<T> init, const Allocator& allocator = Allocator() VECTOR_STATS_SITE_PARAM)
+        : Vector(init.begin(), init.end(), allocator VECTOR_STATS_SITE_ARG) {}
 
     // Copies elements from another vector, allocating exactly enough storage.
-    Vector(const Vector& other)
-        : _capacity(other._size), _size(0), _data(nullptr)
+    constexpr Vector(const Vector& other VECTOR_STATS_SITE_PARAM)
+        : Vector(other, alloc_traits::select_on_container_copy_construction(other._allocator) VECTOR_STATS_SITE_ARG) {}
+
+    // Copies elements from another vector into storage from the given allocator.
+    constexpr Vector(const Vector& other, const Allocator& allocator VECTOR_STATS_SITE_PARAM)
+        : _capacity(0), _size(0), _data(nullptr), _allocator(allocator) VECTOR_STATS_INIT
     {
-        if (_capacity > 0) {
-            _data = static_cast<pointer_type>(::operator new(_capacity * sizeof(T)));
-            try {
-                for (; _size < other._size; ++_size) {
-                    new (&_data[_size]) T(other._data[_size]);
-                }
-            } catch (...) {
-                for (size_type i = 0; i < _size; ++i) {
-                    _data[i].~T();
-                }
-                ::operator delete(_data);
-                _data = nullptr;
-                _size = 0;
-                _capacity = 0;
-                throw;
-            }
-        }
+        copy_from(other);
     }
 
     // Takes ownership of another vector's storage without copying elements.
-    Vector(Vector&& other) noexcept
-        : _capacity(other._capacity), _size(other._size), _data(other._data)
+    constexpr Vector(Vector&& other VECTOR_STATS_SITE_PARAM) noexcept
+        : _capacity(other._capacity), _size(other._size), _data(other._data),
+          _allocator(std::move(other._allocator)) VECTOR_STATS_INIT
     {
         // leave other in a valid, empty state
         other._data = nullptr;
@@ -152,170 +428,569 @@ public:
         other._capacity  = 0;
     }
 
+    // Takes another vector's storage if the allocators match, otherwise moves each element.
+    constexpr Vector(Vector&& other, const Allocator& allocator VECTOR_STATS_SITE_PARAM)
+        : _capacity(0), _size(0), _data(nullptr), _allocator(allocator) VECTOR_STATS_INIT
+    {
+        if (_allocator == other._allocator) {
+            steal(other);
+        } else {
+            move_from(other);
+        }
+    }
+
     // Assigns from another vector by making a deep copy.
-    Vector& operator=(const Vector& other)
+    constexpr Vector& operator=(const Vector& other)
     {
         if (this != &other) {
-            Vector temp(other);
-            swap(temp);
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                // storage from the old allocator must be released before it is replaced
+                if (!alloc_traits::is_always_equal::value && _allocator != other._allocator) {
+                    destroy_and_deallocate();
+                }
+                _allocator = other._allocator;
+            }
+            Vector temp(other, _allocator);
+            swap_storage(temp);
         }
         return *this;
     }
 
     // Assigns from another vector by transferring ownership of its storage.
-    Vector& operator=(Vector&& other) noexcept
+    constexpr Vector& operator=(Vector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value)
     {
         if (this != &other) {
-            clear();
-            ::operator delete(_data);
-            _data = other._data;
-            _size = other._size;
-            _capacity = other._capacity;
-            other._data = nullptr;
-            other._size = other._capacity = 0;
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                destroy_and_deallocate();
+                _allocator = std::move(other._allocator);
+                steal(other);
+            } else if (alloc_traits::is_always_equal::value || _allocator == other._allocator) {
+                destroy_and_deallocate();
+                steal(other);
+            } else {
+                // storage cannot change hands, so the elements move one by one
+                Vector temp(std::move(other), _allocator);
+                swap_storage(temp);
+            }
         }
         return *this;
     }
 
+    // Replaces the contents with the elements of an initializer list.
+    constexpr Vector& operator=(std::initializer_list<T> init)
+    {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
     // Exchanges all with another vector.
-    void swap(Vector& other) noexcept
+    constexpr void swap(Vector& other) noexcept
     {
-        std::swap(_data, other._data);
-        std::swap(_size, other._size);
-        std::swap(_capacity, other._capacity);
+        if constexpr (alloc_traits::propagate_on_container_swap::value) {
+            using std::swap;
+            swap(_allocator, other._allocator);
+        }
+        swap_storage(other);
     }
 
     // Releases all elements and frees any owned storage.
-    ~Vector()
+    constexpr ~Vector()
     {
-        for (size_type i = 0; i < _size; i++)
-        {
-            _data[i].~T();
-        }
-        ::operator delete(_data);
+        _stats.on_destroy((_capacity - _size) * sizeof(T));
+        destroy_and_deallocate();
+    }
+
+    // Returns a copy of the allocator used for element storage.
+    [[nodiscard]] constexpr allocator_type get_allocator() const noexcept
+    {
+        return _allocator;
     }
 
     // Returns how many elements are currently stored.
-    [[nodiscard]] size_type size() const
+    [[nodiscard]] constexpr size_type size() const
     {
         return _size;
     }
 
     // Returns how many elements can be stored without further allocation.
-    [[nodiscard]] size_type capacity() const
+    [[nodiscard]] constexpr size_type capacity() const
     {
         return _capacity;
     }
 
+    // Returns the largest number of elements the allocator can provide room for.
+    [[nodiscard]] constexpr size_type max_size() const noexcept
+    {
+        return alloc_traits::max_size(_allocator);
+    }
+
     // Indicates whether the vector contains no elements.
-    [[nodiscard]] bool empty() const
+    [[nodiscard]] constexpr bool empty() const
     {
         return _size == 0;
     }
 
     // Provides direct access to the underlying mutable buffer.
-    pointer_type data()
+    constexpr pointer_type data()
     {
         return _data;
     }
 
     // Provides direct access to the underlying immutable buffer.
-    const_pointer_type data() const noexcept
+    constexpr const_pointer_type data() const noexcept
     {
         return _data;
     }
 
-    // Returns a reference to the element at the supplied index.
-    reference operator[](size_type index)
+    // Returns a reference to the element at the supplied index, throwing if it is out of range.
+    constexpr reference at(size_type index)
     {
-        if (index >= _size) throw std::out_of_range("index out of range");
+        if (index >= _size) vector_detail::throw_out_of_range("index out of range");
         return _data[index];
     }
 
-    // Returns a const reference to the element at the supplied index.
-    const_reference operator[](size_type index) const
+    // Returns a const reference to the element at the supplied index, throwing if it is out of range.
+    constexpr const_reference at(size_type index) const
     {
-        if (index >= _size) throw std::out_of_range("index out of range");
+        if (index >= _size) vector_detail::throw_out_of_range("index out of range");
+        return _data[index];
+    }
+
+    // Returns a reference to the element at the supplied index without a bounds check.
+    constexpr reference operator[](size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return _data[index];
+    }
+
+    // Returns a const reference to the element at the supplied index without a bounds check.
+    constexpr const_reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
         return _data[index];
     }
 
     // Returns a reference to the first element.
-    reference front()
+    constexpr reference front()
     {
+        VECTOR_ASSERT(_size > 0, "front() on empty vector");
         return _data[0];
     }
 
     // Returns a const reference to the first element.
-    const_reference front() const
+    constexpr const_reference front() const
     {
+        VECTOR_ASSERT(_size > 0, "front() on empty vector");
         return _data[0];
     }
 
     // Returns a reference to the last element.
-    reference back()
+    constexpr reference back()
     {
+        VECTOR_ASSERT(_size > 0, "back() on empty vector");
         return _data[_size - 1];
     }
 
     // Returns a const reference to the last element.
-    const_reference back() const
+    constexpr const_reference back() const
     {
+        VECTOR_ASSERT(_size > 0, "back() on empty vector");
         return _data[_size - 1];
     }
 
     // Destroys all elements while retaining allocated storage.
-    void clear() {
-        for (size_type i = 0; i < _size; ++i) {
-            _data[i].~T();
-        }
+    constexpr void clear() {
+        destroy_range(0, _size);
         _size = 0;
     }
 
     // Appends a copy of the provided value to the end of the vector.
-    void push_back(const T& value)
+    constexpr void push_back(const T& value)
     {
-        ensure_capacity();
-        new (&_data[_size]) T((value));
-        ++_size;
+        emplace_back(value);
     }
 
     // Appends the provided value by moving it into the vector.
-    void push_back(T&& value)
+    constexpr void push_back(T&& value)
     {
-        ensure_capacity();
-        new (&_data[_size]) T(std::move(value)); // move-construct
-        ++_size;
+        emplace_back(std::move(value));
     }
 
-    // Constructs a new element in place at the end using the supplied arguments.
+    // Constructs a new element in place at the end using the supplied arguments, which may refer
+    // to an element of this vector.
     template<typename... Args>
-    reference emplace_back(Args&& ... args)
+    constexpr reference emplace_back(Args&& ... args)
     {
-        ensure_capacity();
-        new (&_data[_size]) T(std::forward<Args>(args)...);
+        if (_size == _capacity) return emplace_back_grow(std::forward<Args>(args)...);
+        alloc_traits::construct(_allocator, _data + _size, std::forward<Args>(args)...);
         _size++;
         return _data[_size - 1]; // size was incremented previously
     }
 
+    // Appends a copy of value, returning a reference to it, or the reason growing failed with the
+    // vector unchanged. Only allocation failure is reported; a throwing copy still throws.
+    constexpr std::expected<std::reference_wrapper<T>, AllocError> try_push_back(const T& value)
+    {
+        return try_emplace_back(value);
+    }
+
+    // Appends value by moving it, or reports why growing failed and leaves value untouched.
+    constexpr std::expected<std::reference_wrapper<T>, AllocError> try_push_back(T&& value)
+    {
+        return try_emplace_back(std::move(value));
+    }
+
+    // Constructs an element from args at the end, or reports why growing failed without
+    // constructing anything. As with emplace_back(), args may refer to an element.
+    template <typename... Args>
+    constexpr std::expected<std::reference_wrapper<T>, AllocError> try_emplace_back(Args&&... args)
+    {
+        if (_size == _capacity) {
+            if (_size == max_size()) return std::unexpected(AllocError::capacity_overflow);
+            const size_type grown = GrowthPolicy::next_capacity(_capacity, _size + 1, sizeof(T));
+            auto block = try_allocate_storage(std::min(grown, max_size()));
+            if (!block) return std::unexpected(block.error());
+            emplace_into_storage(block->first, block->second, std::forward<Args>(args)...);
+            return std::ref(_data[_size - 1]);
+        }
+        alloc_traits::construct(_allocator, _data + _size, std::forward<Args>(args)...);
+        ++_size;
+        return std::ref(_data[_size - 1]);
+    }
+
     // Removes the last element if the vector is not empty.
-    void pop_back()
+    constexpr void pop_back()
     {
         if (_size > 0)
         {
-            _data[_size - 1].~T();
+            alloc_traits::destroy(_allocator, _data + _size - 1);
             --_size;
         }
     }
 
+    // Appends every element of range, growing at most once when its length is known.
+    template <std::ranges::input_range Range>
+    constexpr void append_range(Range&& range)
+    {
+        if constexpr (std::ranges::forward_range<Range> || std::ranges::sized_range<Range>) {
+            const auto count = static_cast<size_type>(std::ranges::distance(range));
+            ensure_capacity(count);
+            construct_at_end(std::ranges::begin(range), count);
+        } else {
+            for (auto&& value : range) {
+                emplace_back(std::forward<decltype(value)>(value));
+            }
+        }
+    }
+
+    // Inserts copies of [first, last) before pos and returns an iterator to the first of them.
+    template <std::input_iterator InputIt>
+    constexpr iterator insert(const_iterator pos, InputIt first, InputIt last)
+    {
+        const size_type index = static_cast<size_type>(std::to_address(pos) - _data);
+
+        if constexpr (std::forward_iterator<InputIt>) {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            if (count == 0) return iterator(_data + index);
+            ensure_capacity(count);
+
+            if (relocate_bytes()) {
+                // open a gap with one memmove and construct straight into it
+                pointer_type gap = _data + index;
+                const size_type tail = _size - index;
+                if (tail > 0) std::memmove(static_cast<void*>(gap + count), gap, tail * sizeof(T));
+                VECTOR_TRY {
+                    construct_range(gap, first, count);
+                } VECTOR_CATCH_ALL {
+                    if (tail > 0) std::memmove(static_cast<void*>(gap), gap + count, tail * sizeof(T));
+                    VECTOR_RETHROW;
+                }
+                _size += count;
+                return iterator(gap);
+            } else {
+                const size_type old_size = _size;
+                construct_at_end(first, count);
+                std::rotate(_data + index, _data + old_size, _data + _size);
+            }
+        } else {
+            const size_type old_size = _size;
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+            std::rotate(_data + index, _data + old_size, _data + _size);
+        }
+        return iterator(_data + index);
+    }
+
+    // Inserts copies of an initializer list's elements before pos.
+    constexpr iterator insert(const_iterator pos, std::initializer_list<T> init)
+    {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    // Inserts a copy of value before pos and returns an iterator to it.
+    constexpr iterator insert(const_iterator pos, const T& value)
+    {
+        return emplace(pos, value);
+    }
+
+    // Inserts value before pos by moving it and returns an iterator to it.
+    constexpr iterator insert(const_iterator pos, T&& value)
+    {
+        return emplace(pos, std::move(value));
+    }
+
+    // Inserts count copies of value before pos and returns an iterator to the first of them.
+    constexpr iterator insert(const_iterator pos, size_type count, const T& value)
+    {
+        const size_type index = static_cast<size_type>(std::to_address(pos) - _data);
+        if (count == 0) return iterator(_data + index);
+        const T copy(value); // value may be an element that is about to move
+        ensure_capacity(count);
+
+        if (relocate_bytes()) {
+            pointer_type gap = open_gap(index, count);
+            size_type i = 0;
+            VECTOR_TRY {
+                for (; i < count; ++i) {
+                    alloc_traits::construct(_allocator, gap + i, copy);
+                }
+            } VECTOR_CATCH_ALL {
+                for (size_type j = 0; j < i; ++j) {
+                    alloc_traits::destroy(_allocator, gap + j);
+                }
+                close_gap(index, count, _size - index);
+                VECTOR_RETHROW;
+            }
+            _size += count;
+        } else {
+            const size_type old_size = _size;
+            for (size_type i = 0; i < count; ++i) {
+                emplace_back(copy);
+            }
+            std::rotate(_data + index, _data + old_size, _data + _size);
+        }
+        return iterator(_data + index);
+    }
+
+    // Constructs an element from args before pos and returns an iterator to it.
+    template <typename... Args>
+    constexpr iterator emplace(const_iterator pos, Args&&... args)
+    {
+        const size_type index = static_cast<size_type>(std::to_address(pos) - _data);
+        if (index == _size) {
+            emplace_back(std::forward<Args>(args)...);
+            return iterator(_data + index);
+        }
+
+        T value(std::forward<Args>(args)...); // args may refer to an element that is about to move
+        ensure_capacity();
+        if (relocate_bytes()) {
+            pointer_type gap = open_gap(index, 1);
+            VECTOR_TRY {
+                alloc_traits::construct(_allocator, gap, std::move(value));
+            } VECTOR_CATCH_ALL {
+                close_gap(index, 1, _size - index);
+                VECTOR_RETHROW;
+            }
+            ++_size;
+        } else {
+            alloc_traits::construct(_allocator, _data + _size, std::move(_data[_size - 1]));
+            ++_size;
+            std::move_backward(_data + index, _data + _size - 2, _data + _size - 1);
+            _data[index] = std::move(value);
+        }
+        return iterator(_data + index);
+    }
+
+    // Removes the element at pos and returns an iterator to the element that followed it.
+    constexpr iterator erase(const_iterator pos)
+    {
+        VECTOR_ASSERT(pos != cend(), "erase() of end()");
+        return erase(pos, pos + 1);
+    }
+
+    // Removes [first, last) and returns an iterator to the element that followed the range.
+    constexpr iterator erase(const_iterator first, const_iterator last)
+    {
+        const size_type index = static_cast<size_type>(std::to_address(first) - _data);
+        const auto count = static_cast<size_type>(last - first);
+        if (count == 0) return iterator(_data + index);
+
+        if (relocate_bytes()) {
+            // the tail slides down over the destroyed range in one memmove
+            destroy_range(index, index + count);
+            close_gap(index, count, _size - index - count);
+        } else {
+            std::move(_data + index + count, _data + _size, _data + index);
+            destroy_range(_size - count, _size);
+        }
+        _size -= count;
+        return iterator(_data + index);
+    }
+
+    // Removes the element at index in O(1) by moving the last element into its place, so the
+    // order of the remaining elements is not preserved.
+    constexpr void swap_remove(size_type index)
+    {
+        VECTOR_ASSERT(index < _size, "swap_remove() index out of range");
+        const size_type last = _size - 1;
+        if (relocate_bytes()) {
+            alloc_traits::destroy(_allocator, _data + index);
+            if (index != last) std::memcpy(static_cast<void*>(_data + index), _data + last, sizeof(T));
+        } else {
+            if (index != last) _data[index] = std::move(_data[last]);
+            alloc_traits::destroy(_allocator, _data + last);
+        }
+        _size = last;
+    }
+
+    // Removes every element for which pred returns true, keeping the others in order, and
+    // returns how many were removed. Survivors that are trivially relocatable but not trivially
+    // copyable, e.g. unique_ptr, are relocated bytewise instead of move-assigned, and removed
+    // ones are destroyed where they lie.
+    template <typename Predicate>
+    constexpr size_type remove_if(Predicate pred)
+    {
+        const size_type old_size = _size;
+        if (relocate_bytes() && !trivial_copy) {
+            // [0, write) is compacted, [write, read) is dead, [read, _size) is untouched
+            size_type write = 0;
+            size_type read = 0;
+            VECTOR_TRY {
+                for (; read < _size; ++read) {
+                    if (pred(std::as_const(_data[read]))) {
+                        alloc_traits::destroy(_allocator, _data + read);
+                    } else {
+                        // a fixed-size copy compiles to plain loads and stores
+                        if (write != read) std::memcpy(static_cast<void*>(_data + write), _data + read, sizeof(T));
+                        ++write;
+                    }
+                }
+            } VECTOR_CATCH_ALL {
+                // close the dead gap so every remaining element is live and contiguous
+                if (write != read) std::memmove(static_cast<void*>(_data + write), _data + read, (_size - read) * sizeof(T));
+                _size = write + (_size - read);
+                VECTOR_RETHROW;
+            }
+            _size = write;
+        } else {
+            pointer_type new_end = std::remove_if(_data, _data + _size, [&](const T& value) { return pred(value); });
+            const auto new_size = static_cast<size_type>(new_end - _data);
+            destroy_range(new_size, _size);
+            _size = new_size;
+        }
+        return old_size - _size;
+    }
+
+    // Replaces the contents with copies of [first, last), allocating exactly once if it has to grow.
+    template <std::input_iterator InputIt>
+    constexpr void assign(InputIt first, InputIt last)
+    {
+        if constexpr (std::forward_iterator<InputIt>) {
+            const auto count = static_cast<size_type>(std::distance(first, last));
+            clear();
+            if (count > _capacity) {
+                destroy_and_deallocate();
+                std::tie(_data, _capacity) = allocate_storage(count);
+            }
+            construct_at_end(first, count);
+        } else {
+            clear();
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    // Replaces the contents with count copies of value.
+    constexpr void assign(size_type count, const T& value)
+    {
+        if (aliases(value)) {
+            // value lives in this vector and would be destroyed by clear()
+            const T copy(value);
+            assign(count, copy);
+            return;
+        }
+        clear();
+        if (count > _capacity) {
+            destroy_and_deallocate();
+            std::tie(_data, _capacity) = allocate_storage(count);
+        }
+        size_type i = 0;
+        VECTOR_TRY {
+            for (; i < count; ++i) {
+                alloc_traits::construct(_allocator, _data + i, value);
+            }
+        } VECTOR_CATCH_ALL {
+            destroy_range(0, i);
+            VECTOR_RETHROW;
+        }
+        _size = count;
+    }
+
+    // Replaces the contents with the elements of an initializer list.
+    constexpr void assign(std::initializer_list<T> init)
+    {
+        assign(init.begin(), init.end());
+    }
+
     // Reserves memory for new_cap capacity, preserving existing elements.
-    void reserve(size_type new_cap)
+    constexpr void reserve(size_type new_cap)
     {
         if (new_cap < _size) return;
         if (new_cap > _capacity) reallocate(new_cap);
     }
 
+    // Reserves memory like reserve(), but reports why it could not instead of throwing, leaving
+    // the vector unchanged.
+    constexpr std::expected<void, AllocError> try_reserve(size_type new_cap)
+    {
+        if (new_cap <= _capacity) return {};
+        if (new_cap > max_size()) return std::unexpected(AllocError::capacity_overflow);
+        return try_reallocate(new_cap);
+    }
+
+    // Returns unused capacity to the allocator: the elements move into a block of size() elements,
+    // or the buffer is freed when the vector is empty. Trivially relocatable elements are carried
+    // over with memcpy, or by the allocator's reallocate() when it has one, which can shrink the
+    // block in place.
+    constexpr void shrink_to_fit()
+    {
+        if (_size == _capacity) return;
+        if (_size == 0) {
+            destroy_and_deallocate();
+            return;
+        }
+        reallocate(_size);
+    }
+
+    // Gives up the buffer without touching the elements and leaves the vector empty. The caller
+    // owns the result: destroy the elements and return the block with
+    // get_allocator().deallocate(data, capacity), or hand it back to a vector through adopt().
+    [[nodiscard]] constexpr ReleasedBuffer release() noexcept
+    {
+        _stats.on_destroy((_capacity - _size) * sizeof(T));
+        ReleasedBuffer buffer{_data, _size, _capacity};
+        _data = nullptr;
+        _size = _capacity = 0;
+        return buffer;
+    }
+
+    // Takes ownership of a buffer from release(); allocator must be able to free its block.
+    static constexpr Vector adopt(ReleasedBuffer buffer, const Allocator& allocator = Allocator() VECTOR_STATS_SITE_PARAM) noexcept
+    {
+        Vector vec(allocator VECTOR_STATS_SITE_ARG);
+        vec._data = buffer.data;
+        vec._size = buffer.size;
+        vec._capacity = buffer.capacity;
+        return vec;
+    }
+
     // Grows or shrinks the vector to the requested size.
-    void resize(size_type new_size)
+    constexpr void resize(size_type new_size)
     {
         size_type curr_size = size();
 
@@ -323,9 +998,7 @@ public:
         if (curr_size > new_size)
         {
             // destroy trailing elements
-            for (size_type i = new_size; i < _size; ++i) {
-                _data[i].~T();
-            }
+            destroy_range(new_size, _size);
             _size = new_size;
             return;
         }
@@ -334,112 +1007,450 @@ public:
         if (curr_size < new_size)
         {
             reserve(new_size);
-            try
+            size_type i = curr_size;
+            VECTOR_TRY
             {
-                for (size_type i = curr_size; i < new_size; ++i)
+                for (; i < new_size; ++i)
                 {
-                    new (&_data[i]) T(); // init
+                    alloc_traits::construct(_allocator, _data + i); // init
                 }
-            } catch (...)
+            } VECTOR_CATCH_ALL
             {
                 // destroy constructed elements if throws
-                for (size_type j = curr_size; j < new_size; ++j)
-                {
-                    _data[j].~T(); // clean up if throw
-                }
-                throw;
+                destroy_range(curr_size, i);
+                VECTOR_RETHROW;
             }
         }
         _size = new_size;
     }
 
+    // Grows or shrinks the vector like resize(), but default-initializes new elements,
+    // so for trivial types the new tail is left unwritten for the caller to overwrite.
+    constexpr void resize_for_overwrite(size_type new_size)
+    {
+        if (new_size <= _size) {
+            destroy_range(new_size, _size);
+            _size = new_size;
+            return;
+        }
+        reserve(new_size);
+        default_construct_at_end(new_size - _size);
+    }
+
+    // Appends count default-initialized elements and returns them for the caller to fill,
+    // e.g. as the destination of a read() or recv().
+    constexpr std::span<T> append_uninitialized(size_type count)
+    {
+        ensure_capacity(count);
+        const size_type first = _size;
+        default_construct_at_end(count);
+        return std::span<T>(_data + first, count);
+    }
+
     // VectorIterators
     // Returns an iterator to the first element.
-    iterator begin() noexcept
+    constexpr iterator begin() noexcept
     {
         return iterator(_data);
     }
 
     // Returns an iterator one past the last element.
-    iterator end() noexcept
+    constexpr iterator end() noexcept
     {
         return iterator(_data + _size);
     }
 
     // Returns a const iterator to the first element.
-    const_iterator begin() const noexcept
+    constexpr const_iterator begin() const noexcept
     {
         return const_iterator(_data);
     }
 
     // Returns a const iterator one past the last element.
-    const_iterator end() const noexcept
+    constexpr const_iterator end() const noexcept
     {
         return const_iterator(_data + _size);
     }
 
     // Returns a const iterator to the first element (C++ standard naming).
-    const_iterator cbegin() const noexcept
+    constexpr const_iterator cbegin() const noexcept
     {
         return const_iterator(_data);
     }
 
     // Returns a const iterator one past the last element (C++ standard naming).
-    const_iterator cend() const noexcept
+    constexpr const_iterator cend() const noexcept
     {
         return const_iterator(_data + _size);
     }
 
 private:
-    // Eventually move to an Allocator (?)
     // Allocates new storage and moves existing elements into it.
-    void reallocate(const size_t new_capacity)
+    constexpr void reallocate(const size_t new_capacity)
     {
+        if constexpr (trivial_relocate && vector_detail::has_reallocate<Allocator, T>) {
+            // let the allocator extend the block in place when it can
+            if (_data) {
+                _stats.on_reallocate(0); // whatever the allocator copies is invisible here
+                _stats.on_allocate(new_capacity * sizeof(T));
+                _data = _allocator.reallocate(_data, _capacity, new_capacity);
+                _capacity = new_capacity;
+                return;
+            }
+        }
+
         // allocate new mem
-        auto new_data = static_cast<pointer_type>(::operator new(new_capacity * sizeof(T)));
+        auto [new_data, allocated] = allocate_storage(new_capacity);
+        move_storage(new_data, allocated);
+    }
 
-        // try-catch to roll back potential throws for memory leakage
-        size_type i = 0;
+    // Reallocates like reallocate(), except that running out of memory is returned rather than
+    // thrown. Allocators with try_allocate(), and std::allocator through nothrow operator new,
+    // are asked without any exception in flight; other allocators' std::bad_alloc is caught.
+    constexpr std::expected<void, AllocError> try_reallocate(size_type new_capacity)
+    {
+        if constexpr (vector_detail::has_try_allocate<Allocator, T> || std::is_same_v<Allocator, std::allocator<T>>) {
+            auto block = try_allocate_storage(new_capacity);
+            if (!block) return std::unexpected(block.error());
+            move_storage(block->first, block->second);
+            return {};
+        }
+#if defined(VECTOR_NO_EXCEPTIONS)
+        reallocate(new_capacity);
+#else
         try {
-            // move to new mem
-            for (; i < _size; i++)
-            {
-                new (&new_data[i]) T(std::move_if_noexcept(_data[i]));
+            reallocate(new_capacity);
+        } catch (const std::bad_alloc&) {
+            return std::unexpected(AllocError::out_of_memory);
+        }
+#endif
+        return {};
+    }
+
+    // Allocates like allocate_storage(), except that running out of memory is returned rather
+    // than thrown, asking the allocator the same way try_reallocate() does.
+    constexpr std::expected<std::pair<pointer_type, size_type>, AllocError> try_allocate_storage(size_type n)
+    {
+        if constexpr (vector_detail::has_try_allocate<Allocator, T> || std::is_same_v<Allocator, std::allocator<T>>) {
+            if !consteval {
+                pointer_type new_data = nullptr;
+                if constexpr (vector_detail::has_try_allocate<Allocator, T>) {
+                    new_data = _allocator.try_allocate(n);
+                } else if (n <= max_size()) {
+                    // std::allocator::deallocate() hands this block to the matching operator delete
+                    if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                        new_data = static_cast<pointer_type>(::operator new(
+                            n * sizeof(T), std::align_val_t(alignof(T)), std::nothrow));
+                    } else {
+                        new_data = static_cast<pointer_type>(::operator new(n * sizeof(T), std::nothrow));
+                    }
+                }
+                if (new_data == nullptr) return std::unexpected(AllocError::out_of_memory);
+                _stats.on_allocate(n * sizeof(T));
+                return std::pair{new_data, n};
             }
-        } catch (...) {
-            // destroy constructed elements and mem if throw
-            for (size_type j = 0; j < i; ++j)
-            {
-                new_data[j].~T();
+        }
+#if defined(VECTOR_NO_EXCEPTIONS)
+        return allocate_storage(n);
+#else
+        try {
+            return allocate_storage(n);
+        } catch (const std::bad_alloc&) {
+            return std::unexpected(AllocError::out_of_memory);
+        }
+#endif
+    }
+
+    // Grows for emplace_back(). The new element is constructed before the old elements are moved
+    // or freed, since args may refer to one of them.
+    template <typename... Args>
+    constexpr reference emplace_back_grow(Args&&... args)
+    {
+        const size_type grown = GrowthPolicy::next_capacity(_capacity, _size + 1, sizeof(T));
+        if constexpr (trivial_relocate && vector_detail::has_reallocate<Allocator, T>) {
+            if (_data) {
+                // the allocator may move the block itself, so the value is built beforehand
+                T value(std::forward<Args>(args)...);
+                reallocate(grown);
+                alloc_traits::construct(_allocator, _data + _size, std::move(value));
+                _size++;
+                return _data[_size - 1];
             }
-            ::operator delete(new_data);
-            throw;
         }
+        auto [new_data, allocated] = allocate_storage(grown);
+        emplace_into_storage(new_data, allocated, std::forward<Args>(args)...);
+        return _data[_size - 1];
+    }
 
-        // destroy old elements and point to new
-        for (size_type k = 0; k < _size; k++)
-        {
-            _data[k].~T();
+    // Constructs an element from args at new_data[_size], then moves the elements over as
+    // move_storage() does. new_data is freed if either step throws.
+    template <typename... Args>
+    constexpr void emplace_into_storage(pointer_type new_data, size_type allocated, Args&&... args)
+    {
+        VECTOR_TRY {
+            alloc_traits::construct(_allocator, new_data + _size, std::forward<Args>(args)...);
+        } VECTOR_CATCH_ALL {
+            alloc_traits::deallocate(_allocator, new_data, allocated);
+            VECTOR_RETHROW;
         }
+        move_storage(new_data, allocated, 1);
+        ++_size;
+    }
 
-        ::operator delete(_data);
+    // Moves the elements into new_data, a block of allocated elements, and frees the old block.
+    // appended elements already constructed past the moved ones are destroyed if a move throws.
+    constexpr void move_storage(pointer_type new_data, size_type allocated, size_type appended = 0)
+    {
+        if (relocate_bytes()) {
+            // bytes carry the objects over; the old copies are never destroyed
+            if (_size > 0) std::memcpy(static_cast<void*>(new_data), _data, _size * sizeof(T));
+        } else {
+            // try-catch to roll back potential throws for memory leakage
+            size_type i = 0;
+            VECTOR_TRY {
+                // move to new mem
+                for (; i < _size; i++)
+                {
+                    alloc_traits::construct(_allocator, new_data + i, std::move_if_noexcept(_data[i]));
+                }
+            } VECTOR_CATCH_ALL {
+                // destroy constructed elements and mem if throw
+                for (size_type j = 0; j < i; ++j)
+                {
+                    alloc_traits::destroy(_allocator, new_data + j);
+                }
+                for (size_type j = 0; j < appended; ++j)
+                {
+                    alloc_traits::destroy(_allocator, new_data + _size + j);
+                }
+                alloc_traits::deallocate(_allocator, new_data, allocated);
+                VECTOR_RETHROW;
+            }
+
+            // destroy old elements
+            destroy_range(0, _size);
+        }
+
+        // point to new
+        if (_data) {
+            _stats.on_reallocate(_size * sizeof(T));
+            alloc_traits::deallocate(_allocator, _data, _capacity);
+        }
         _data = new_data;
-        _capacity = new_capacity;
+        _capacity = allocated;
+    }
+
+    // Returns whether value is one of this vector's elements. Constant evaluation cannot order
+    // pointers into different objects, so there each element's address is compared for equality.
+    constexpr bool aliases(const T& value) const noexcept
+    {
+        if consteval {
+            for (size_type i = 0; i < _size; ++i) {
+                if (&value == _data + i) return true;
+            }
+            return false;
+        } else {
+            return &value >= _data && &value < _data + _size;
+        }
     }
 
-    // Expands capacity when additional space is required.
-    void ensure_capacity()
+    // Shifts [index, _size) up by count with memmove, returning the uninitialized gap; capacity
+    // must suffice and _size is left unchanged.
+    constexpr pointer_type open_gap(size_type index, size_type count) noexcept
     {
-        if (_size == _capacity)
+        pointer_type gap = _data + index;
+        if (index < _size) std::memmove(static_cast<void*>(gap + count), gap, (_size - index) * sizeof(T));
+        return gap;
+    }
+
+    // Slides tail elements starting at index + count down to index with memmove.
+    constexpr void close_gap(size_type index, size_type count, size_type tail) noexcept
+    {
+        if (tail > 0) std::memmove(static_cast<void*>(_data + index), _data + index + count, tail * sizeof(T));
+    }
+
+    // Expands capacity when room for extra more elements is required.
+    constexpr void ensure_capacity(size_type extra = 1)
+    {
+        if (extra > _capacity - _size)
         {
-            const size_type new_capacity = (_capacity == 0) ? 1 : (_capacity * 2);
-            reallocate(new_capacity);
+            reallocate(GrowthPolicy::next_capacity(_capacity, _size + extra, sizeof(T)));
         }
     }
 
+    // Copy-constructs count elements starting at first into raw storage at destination.
+    // Contiguous sources of trivially copyable elements are copied with a single memcpy.
+    template <typename InputIt>
+    constexpr void construct_range(pointer_type destination, InputIt first, size_type count)
+    {
+        using source_type = std::remove_cv_t<std::iter_value_t<InputIt>>;
+        if constexpr (std::contiguous_iterator<InputIt> && std::is_same_v<source_type, T>) {
+            if (copy_bytes()) {
+                if (count > 0) std::memcpy(static_cast<void*>(destination), std::to_address(first), count * sizeof(T));
+                return;
+            }
+        }
+        size_type i = 0;
+        VECTOR_TRY {
+            for (; i < count; ++i, ++first) {
+                alloc_traits::construct(_allocator, destination + i, *first);
+            }
+        } VECTOR_CATCH_ALL {
+            for (size_type j = 0; j < i; ++j) {
+                alloc_traits::destroy(_allocator, destination + j);
+            }
+            VECTOR_RETHROW;
+        }
+    }
+
+    // Default-initializes count elements after the last element; capacity must suffice.
+    constexpr void default_construct_at_end(size_type count)
+    {
+        if (skip_default_init()) {
+            // nothing to run; the bytes stay as the allocator left them
+            _size += count;
+        } else {
+            size_type i = _size;
+            VECTOR_TRY {
+                for (; i < _size + count; ++i) {
+                    if constexpr (vector_detail::uses_default_construct<Allocator, T>) {
+                        if consteval {
+                            std::construct_at(_data + i); // placement new is not constexpr
+                        } else {
+                            ::new (static_cast<void*>(_data + i)) T;
+                        }
+                    } else {
+                        // an allocator that constructs must see every element it will later destroy
+                        alloc_traits::construct(_allocator, _data + i);
+                    }
+                }
+            } VECTOR_CATCH_ALL {
+                destroy_range(_size, i);
+                VECTOR_RETHROW;
+            }
+            _size += count;
+        }
+    }
+
+    // Copy-constructs count elements starting at first after the last element; capacity must suffice.
+    template <typename InputIt>
+    constexpr void construct_at_end(InputIt first, size_type count)
+    {
+        construct_range(_data + _size, first, count);
+        _size += count;
+    }
+
+    // Copy-constructs every element of other into freshly allocated storage of exactly its size.
+    constexpr void copy_from(const Vector& other)
+    {
+        if (other._size == 0) return;
+        std::tie(_data, _capacity) = allocate_storage(other._size);
+        if (copy_bytes()) {
+            std::memcpy(static_cast<void*>(_data), other._data, other._size * sizeof(T));
+            _size = other._size;
+        } else {
+            VECTOR_TRY {
+                for (; _size < other._size; ++_size) {
+                    alloc_traits::construct(_allocator, _data + _size, other._data[_size]);
+                }
+            } VECTOR_CATCH_ALL {
+                destroy_and_deallocate();
+                VECTOR_RETHROW;
+            }
+        }
+    }
+
+    // Move-constructs every element of other into storage owned by this vector's allocator.
+    constexpr void move_from(Vector& other)
+    {
+        if (other._size == 0) return;
+        std::tie(_data, _capacity) = allocate_storage(other._size);
+        if (copy_bytes()) {
+            std::memcpy(static_cast<void*>(_data), other._data, other._size * sizeof(T));
+            _size = other._size;
+        } else {
+            VECTOR_TRY {
+                for (; _size < other._size; ++_size) {
+                    alloc_traits::construct(_allocator, _data + _size, std::move(other._data[_size]));
+                }
+            } VECTOR_CATCH_ALL {
+                destroy_and_deallocate();
+                VECTOR_RETHROW;
+            }
+        }
+    }
+
+    // Allocates room for at least n elements, returning the buffer and its usable capacity.
+    constexpr std::pair<pointer_type, size_type> allocate_storage(size_type n)
+    {
+        if constexpr (vector_detail::has_allocate_at_least<Allocator, T>) {
+            auto result = _allocator.allocate_at_least(n);
+            _stats.on_allocate(result.count * sizeof(T));
+            return {result.ptr, result.count};
+        } else {
+            pointer_type data = alloc_traits::allocate(_allocator, n);
+            _stats.on_allocate(n * sizeof(T));
+            return {data, n};
+        }
+    }
+
+    // Adopts other's buffer, leaving it empty; the allocators must already compare equal.
+    constexpr void steal(Vector& other) noexcept
+    {
+        _data = other._data;
+        _size = other._size;
+        _capacity = other._capacity;
+        other._data = nullptr;
+        other._size = other._capacity = 0;
+    }
+
+    // Exchanges buffers with other without touching either allocator.
+    constexpr void swap_storage(Vector& other) noexcept
+    {
+        std::swap(_data, other._data);
+        std::swap(_size, other._size);
+        std::swap(_capacity, other._capacity);
+    }
+
+    // Destroys the elements in [first, last).
+    constexpr void destroy_range(size_type first, size_type last) noexcept
+    {
+        if constexpr (!trivial_destroy) {
+            for (size_type i = first; i < last; ++i) {
+                alloc_traits::destroy(_allocator, _data + i);
+            }
+        }
+    }
+
+    // Destroys every element and returns the buffer to the allocator.
+    constexpr void destroy_and_deallocate() noexcept
+    {
+        destroy_range(0, _size);
+        if (_data) alloc_traits::deallocate(_allocator, _data, _capacity);
+        _data = nullptr;
+        _size = 0;
+        _capacity = 0;
+    }
+
 private:
     size_t _capacity = 0;
     size_t _size = 0;
     T* _data = nullptr;
+    [[no_unique_address]] Allocator _allocator;
+    [[no_unique_address]] VectorStatsHandle _stats;
 
 };
+
+// Removes every element of vec for which pred returns true and returns how many were removed.
+template <typename T, typename Allocator, typename GrowthPolicy, typename Predicate>
+constexpr typename Vector<T, Allocator, GrowthPolicy>::size_type erase_if(Vector<T, Allocator, GrowthPolicy>& vec, Predicate pred)
+{
+    return vec.remove_if(pred);
+}
+
+// Removes every element of vec equal to value and returns how many were removed.
+template <typename T, typename Allocator, typename GrowthPolicy, typename U>
+constexpr typename Vector<T, Allocator, GrowthPolicy>::size_type erase(Vector<T, Allocator, GrowthPolicy>& vec, const U& value)
+{
+    return vec.remove_if([&](const T& element) { return element == value; });
+}
@@ -0,0 +1,463 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Vector.h"
+
+// Data-parallel algorithms over the contiguous storage of a Vector (or any sized contiguous
+// range). Work is cut into chunks aligned to cache lines, spread over a ThreadPool whose
+// participants steal chunks from each other, and run serially below a size threshold.
+
+// Fork-join pool in which every participant owns a range of chunk indices and steals from the
+// back of the others' ranges once its own is empty. The calling thread always participates.
+class ThreadPool
+{
+public:
+    // Starts worker_count threads; with zero workers every job runs on the caller alone.
+    explicit ThreadPool(std::size_t worker_count = default_worker_count())
+    {
+        _workers.reserve(worker_count);
+        for (std::size_t i = 0; i < worker_count; ++i) {
+            _workers.emplace_back([this, i] { worker_loop(i + 1); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Stops and joins every worker.
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (std::thread& worker : _workers) {
+            worker.join();
+        }
+    }
+
+    // Returns the process-wide pool with one worker per additional hardware thread.
+    static ThreadPool& shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Returns how many threads take part in a job, including the caller.
+    [[nodiscard]] std::size_t concurrency() const noexcept
+    {
+        return _workers.size() + 1;
+    }
+
+    // Runs body(i) for every i in [0, count) and returns once all calls have finished.
+    // The first exception thrown by body is rethrown here after the remaining chunks are skipped.
+    // Calls made from inside a running job execute serially on the calling thread.
+    template <typename Body>
+    void run(std::size_t count, Body&& body)
+    {
+        if (count == 0) return;
+        if (_workers.empty() || count == 1 || inside_job()) {
+            for (std::size_t i = 0; i < count; ++i) {
+                body(i);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> submit(_submit_mutex); // one job at a time
+        Job job(count, concurrency(), &body, [](void* target, std::size_t index) {
+            (*static_cast<std::remove_reference_t<Body>*>(target))(index);
+        });
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _job = &job;
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        participate(job, 0);
+
+        {
+            // no worker may join once the job is withdrawn; wait for those already inside
+            std::unique_lock<std::mutex> lock(_mutex);
+            _job = nullptr;
+            _done.wait(lock, [&] { return job.active == 0; });
+        }
+        if (job.error) std::rethrow_exception(job.error);
+    }
+
+private:
+    // Default worker count: every hardware thread except the caller's.
+    static std::size_t default_worker_count() noexcept
+    {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+    // A participant's remaining chunk indices, packed as (begin << 32 | end) so the owner taking
+    // from the front and thieves taking from the back agree through one compare-and-swap.
+    struct alignas(64) ChunkRange
+    {
+        std::atomic<std::uint64_t> bounds{0};
+    };
+
+    struct Job
+    {
+        Job(std::size_t chunk_count, std::size_t participants, void* target, void (*call)(void*, std::size_t))
+            : ranges(participants), pending(chunk_count), body(target), invoke(call)
+        {
+            // deal the chunks out in contiguous runs so owners walk memory in order
+            for (std::size_t p = 0; p < participants; ++p) {
+                const std::uint64_t begin = chunk_count * p / participants;
+                const std::uint64_t end = chunk_count * (p + 1) / participants;
+                ranges[p].bounds.store((begin << 32) | end, std::memory_order_relaxed);
+            }
+        }
+
+        std::vector<ChunkRange> ranges;
+        std::atomic<std::size_t> pending;
+        std::size_t active = 0; // guarded by the pool mutex
+        void* body;
+        void (*invoke)(void*, std::size_t);
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+    };
+
+    // Marks the threads that are currently executing chunks.
+    static bool& inside_job() noexcept
+    {
+        thread_local bool inside = false;
+        return inside;
+    }
+
+    // Takes the next chunk from the front of the participant's own range.
+    static std::optional<std::size_t> take_own(ChunkRange& range) noexcept
+    {
+        std::uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::uint64_t begin = bounds >> 32;
+            const std::uint64_t end = bounds & 0xffffffffu;
+            if (begin >= end) return std::nullopt;
+            if (range.bounds.compare_exchange_weak(bounds, ((begin + 1) << 32) | end, std::memory_order_acq_rel)) {
+                return static_cast<std::size_t>(begin);
+            }
+        }
+    }
+
+    // Steals the last chunk of another participant's range.
+    static std::optional<std::size_t> steal(ChunkRange& range) noexcept
+    {
+        std::uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+        for (;;) {
+            const std::uint64_t begin = bounds >> 32;
+            const std::uint64_t end = bounds & 0xffffffffu;
+            if (begin >= end) return std::nullopt;
+            if (range.bounds.compare_exchange_weak(bounds, (begin << 32) | (end - 1), std::memory_order_acq_rel)) {
+                return static_cast<std::size_t>(end - 1);
+            }
+        }
+    }
+
+    // Executes chunks until every range in the job is empty.
+    void participate(Job& job, std::size_t self) noexcept
+    {
+        inside_job() = true;
+        const std::size_t participants = job.ranges.size();
+        for (;;) {
+            std::optional<std::size_t> chunk = take_own(job.ranges[self]);
+            for (std::size_t offset = 1; !chunk && offset < participants; ++offset) {
+                chunk = steal(job.ranges[(self + offset) % participants]);
+            }
+            if (!chunk) break;
+
+            if (!job.failed.load(std::memory_order_relaxed)) {
+                try {
+                    job.invoke(job.body, *chunk);
+                } catch (...) {
+                    if (!job.failed.exchange(true)) job.error = std::current_exception();
+                }
+            }
+            job.pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+        inside_job() = false;
+
+        // the caller leaves only when nothing is still executing elsewhere
+        while (self == 0 && job.pending.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Sleeps until a job is published, helps with it, and repeats until the pool stops.
+    void worker_loop(std::size_t self)
+    {
+        std::uint64_t seen = 0;
+        for (;;) {
+            Job* job = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _wake.wait(lock, [&] { return _stopping || (_job && _generation != seen); });
+                if (_stopping) return;
+                seen = _generation;
+                job = _job;
+                ++job->active;
+            }
+
+            participate(*job, self);
+
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                --job->active;
+            }
+            _done.notify_all();
+        }
+    }
+
+    std::vector<std::thread> _workers;
+    std::mutex _submit_mutex;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    Job* _job = nullptr;
+    std::uint64_t _generation = 0;
+    bool _stopping = false;
+};
+
+// Tuning knobs shared by the parallel algorithms.
+struct ParallelOptions
+{
+    // Pool to run on; nullptr selects ThreadPool::shared().
+    ThreadPool* pool = nullptr;
+    // Inputs shorter than this many elements run serially on the caller.
+    std::size_t serial_threshold = 1 << 14;
+    // Smallest number of elements worth handing to one chunk.
+    std::size_t min_chunk = 1 << 12;
+};
+
+namespace parallel_detail {
+
+inline constexpr std::size_t cache_line = 64;
+
+// Splits [0, total) into chunks whose inner boundaries fall on cache-line boundaries of the
+// buffer at base, so no two chunks write to the same line.
+class ChunkPlan
+{
+public:
+    ChunkPlan(const void* base, std::size_t element_size, std::size_t total, std::size_t target_chunks,
+              std::size_t min_chunk) noexcept
+        : _total(total)
+    {
+        std::size_t step = total / (target_chunks == 0 ? 1 : target_chunks);
+        if (step < min_chunk) step = min_chunk;
+        if (step == 0) step = 1;
+
+        // element boundaries meet line boundaries every lcm(element_size, cache_line) bytes, so
+        // the step is rounded to that many elements and the first chunk ends on the first meeting
+        const std::size_t period = cache_line / std::gcd(element_size, cache_line);
+        step = (step + period - 1) / period * period;
+        const std::size_t misalignment = reinterpret_cast<std::uintptr_t>(base) % cache_line;
+        std::size_t lead = 0;
+        if (misalignment != 0) {
+            // none exists when base is misaligned even for the element size's own alignment
+            for (std::size_t i = 1; i < period; ++i) {
+                if ((misalignment + i * element_size) % cache_line == 0) {
+                    lead = i;
+                    break;
+                }
+            }
+        }
+        _head = lead + step;
+        _step = step;
+        _count = total <= _head ? 1 : 1 + (total - _head + _step - 1) / _step;
+    }
+
+    // Returns how many chunks the plan produced.
+    [[nodiscard]] std::size_t count() const noexcept
+    {
+        return _count;
+    }
+
+    // Returns the first element index of chunk i.
+    [[nodiscard]] std::size_t begin(std::size_t i) const noexcept
+    {
+        return i == 0 ? 0 : std::min(_total, _head + (i - 1) * _step);
+    }
+
+    // Returns one past the last element index of chunk i.
+    [[nodiscard]] std::size_t end(std::size_t i) const noexcept
+    {
+        return std::min(_total, _head + i * _step);
+    }
+
+private:
+    std::size_t _total;
+    std::size_t _head = 0;
+    std::size_t _step = 1;
+    std::size_t _count = 1;
+};
+
+// Resolves the pool an algorithm runs on.
+inline ThreadPool& pool_for(const ParallelOptions& options)
+{
+    return options.pool ? *options.pool : ThreadPool::shared();
+}
+
+// Runs chunk(begin, end) over a plan for the buffer at base, serially when the input is small.
+template <typename Chunk>
+void for_chunks(const void* base, std::size_t element_size, std::size_t total, const ParallelOptions& options,
+                Chunk&& chunk)
+{
+    if (total < options.serial_threshold) {
+        if (total > 0) chunk(std::size_t{0}, total);
+        return;
+    }
+    ThreadPool& pool = pool_for(options);
+    const ChunkPlan plan(base, element_size, total, pool.concurrency() * 4, options.min_chunk);
+    pool.run(plan.count(), [&](std::size_t i) { chunk(plan.begin(i), plan.end(i)); });
+}
+
+template <typename Range>
+concept contiguous_sized_range = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range>;
+
+} // namespace parallel_detail
+
+// Calls f on every element of range, in no particular order across chunks.
+template <parallel_detail::contiguous_sized_range Range, typename Function>
+void parallel_for_each(Range&& range, Function f, const ParallelOptions& options = {})
+{
+    auto* data = std::ranges::data(range);
+    const auto size = static_cast<std::size_t>(std::ranges::size(range));
+    parallel_detail::for_chunks(data, sizeof(*data), size, options, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            f(data[i]);
+        }
+    });
+}
+
+// Stores f(input[i]) into output[i], resizing output to input's size first if it is smaller.
+// Chunks are aligned on output, the side being written.
+template <parallel_detail::contiguous_sized_range Input, typename Output, typename Function>
+void parallel_transform(const Input& input, Output& output, Function f, const ParallelOptions& options = {})
+{
+    const auto size = static_cast<std::size_t>(std::ranges::size(input));
+    if (static_cast<std::size_t>(std::ranges::size(output)) < size) output.resize(size);
+
+    const auto* source = std::ranges::data(input);
+    auto* destination = std::ranges::data(output);
+    parallel_detail::for_chunks(destination, sizeof(*destination), size, options,
+                                [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            destination[i] = f(source[i]);
+        }
+    });
+}
+
+// Folds every element into init with op, which must be associative; each chunk is folded
+// separately and the partial results are combined left to right.
+template <parallel_detail::contiguous_sized_range Range, typename Result, typename BinaryOp = std::plus<>>
+Result parallel_reduce(const Range& range, Result init, BinaryOp op = {}, const ParallelOptions& options = {})
+{
+    const auto* data = std::ranges::data(range);
+    const auto size = static_cast<std::size_t>(std::ranges::size(range));
+    if (size < options.serial_threshold) {
+        for (std::size_t i = 0; i < size; ++i) {
+            init = op(std::move(init), data[i]);
+        }
+        return init;
+    }
+
+    ThreadPool& pool = parallel_detail::pool_for(options);
+    const parallel_detail::ChunkPlan plan(data, sizeof(*data), size, pool.concurrency() * 4, options.min_chunk);
+    // one line per slot, so workers storing neighbouring partials do not share a line
+    struct alignas(parallel_detail::cache_line) Partial
+    {
+        std::optional<Result> value;
+    };
+    std::vector<Partial> partials(plan.count());
+    pool.run(plan.count(), [&](std::size_t chunk) {
+        const std::size_t begin = plan.begin(chunk);
+        const std::size_t end = plan.end(chunk);
+        if (begin == end) return;
+        Result partial(data[begin]);
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            partial = op(std::move(partial), data[i]);
+        }
+        partials[chunk].value.emplace(std::move(partial));
+    });
+
+    for (auto& partial : partials) {
+        if (partial.value) init = op(std::move(init), std::move(*partial.value));
+    }
+    return init;
+}
+
+// Sorts range by comp: chunks are sorted in parallel, then neighbouring runs are merged pairwise
+// in parallel rounds. The last rounds have fewer merges than threads and bound the speed-up.
+template <parallel_detail::contiguous_sized_range Range, typename Compare = std::less<>>
+void parallel_sort(Range&& range, Compare comp = {}, const ParallelOptions& options = {})
+{
+    auto* data = std::ranges::data(range);
+    const auto size = static_cast<std::size_t>(std::ranges::size(range));
+    if (size < options.serial_threshold) {
+        std::sort(data, data + size, comp);
+        return;
+    }
+
+    ThreadPool& pool = parallel_detail::pool_for(options);
+    const parallel_detail::ChunkPlan plan(data, sizeof(*data), size, pool.concurrency(), options.min_chunk);
+    const std::size_t runs = plan.count();
+    pool.run(runs, [&](std::size_t i) { std::sort(data + plan.begin(i), data + plan.end(i), comp); });
+
+    for (std::size_t width = 1; width < runs; width *= 2) {
+        const std::size_t merges = (runs + 2 * width - 1) / (2 * width);
+        pool.run(merges, [&](std::size_t m) {
+            const std::size_t first = m * 2 * width;
+            const std::size_t middle = std::min(runs, first + width);
+            const std::size_t last = std::min(runs, first + 2 * width);
+            if (middle == last) return;
+            std::inplace_merge(data + plan.begin(first), data + plan.begin(middle), data + plan.end(last - 1), comp);
+        });
+    }
+}
+
+// Resizes vec to count elements like resize(count, value), but writes the new elements on the
+// pool's threads in the chunks the other parallel algorithms use. Under first-touch placement,
+// e.g. NumaPolicy::first_touch() or plain large mallocs, each fresh page then lands on the NUMA
+// node of the thread that wrote it, instead of all of them on the resizing thread's node.
+// Later passes with the same pool find most of their chunks local. Stealing can move some
+// chunks to other threads, and the pages of elements that already existed stay where they were.
+template <typename T, typename Allocator, typename GrowthPolicy>
+    requires std::is_trivially_copyable_v<T> && std::is_trivially_default_constructible_v<T>
+void parallel_resize(Vector<T, Allocator, GrowthPolicy>& vec, std::size_t count, const T& value = T(),
+                     const ParallelOptions& options = {})
+{
+    if (count <= vec.size()) {
+        vec.resize_for_overwrite(count);
+        return;
+    }
+    const T fill = value; // value may live in the buffer that reserve() frees
+    vec.reserve(count);
+    const std::span<T> tail = vec.append_uninitialized(count - vec.size());
+    T* data = tail.data();
+    parallel_detail::for_chunks(data, sizeof(T), tail.size(), options, [&](std::size_t begin, std::size_t end) {
+        std::fill(data + begin, data + end, fill);
+    });
+}
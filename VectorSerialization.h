@@ -0,0 +1,244 @@
+#pragma once
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <bit>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "Vector.h"
+
+// Versioned binary format for vectors of trivially copyable elements: a fixed 32-byte header,
+// zero padding up to the payload alignment, then the elements' bytes exactly as they sit in
+// memory. Writing and reading move the payload with one writev()/readv() pass instead of touching
+// each element, and from_buffer() reads a received blob in place.
+
+namespace vector_io {
+
+// Leading bytes of every blob, "VECB" in file order.
+inline constexpr std::uint32_t format_magic = 0x42434556;
+inline constexpr std::uint16_t format_version = 1;
+// Payloads start on this boundary (or the element's alignment, if larger) within a blob.
+inline constexpr std::size_t payload_alignment = 64;
+// read_from() trusts a header's count for this many payload bytes; a larger payload is read in
+// chunks that double as they arrive, so a forged count cannot allocate far more than is sent.
+inline constexpr std::size_t trusted_read_bytes = std::size_t{16} << 20;
+
+// On-disk header, stored in the writer's byte order.
+struct Header
+{
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint8_t endianness; // 1 little, 2 big
+    std::uint8_t reserved;
+    std::uint32_t element_size;
+    std::uint32_t alignment;
+    std::uint64_t count;
+    std::uint64_t payload_offset;
+};
+
+static_assert(sizeof(Header) == 32 && std::is_trivially_copyable_v<Header>, "Header must stay a fixed 32-byte layout");
+
+// Thrown when a blob is not in this format or does not match the requested element type.
+class FormatError : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+namespace detail {
+
+constexpr std::uint8_t native_endianness() noexcept
+{
+    return std::endian::native == std::endian::little ? 1 : 2;
+}
+
+template <typename T>
+constexpr std::size_t alignment_for() noexcept
+{
+    return alignof(T) > payload_alignment ? alignof(T) : payload_alignment;
+}
+
+// Builds the header describing count elements of T.
+template <typename T>
+Header make_header(std::uint64_t count) noexcept
+{
+    constexpr std::size_t alignment = alignment_for<T>();
+    return {format_magic, format_version, native_endianness(), 0, static_cast<std::uint32_t>(sizeof(T)),
+            static_cast<std::uint32_t>(alignment),
+            count, (sizeof(Header) + alignment - 1) / alignment * alignment};
+}
+
+// Checks that a header describes a payload of T this process can use as is.
+template <typename T>
+void validate(const Header& header)
+{
+    // a byte-swapped magic is a blob from a machine of the other byte order, not garbage
+    if (header.magic == std::byteswap(format_magic)) throw FormatError("vector_io: payload has foreign byte order");
+    if (header.magic != format_magic) throw FormatError("vector_io: not a serialized vector");
+    if (header.version != format_version) throw FormatError("vector_io: unsupported format version");
+    if (header.endianness != native_endianness()) throw FormatError("vector_io: payload has foreign byte order");
+    if (header.element_size != sizeof(T)) throw FormatError("vector_io: element size mismatch");
+    if (header.count > std::numeric_limits<std::size_t>::max() / sizeof(T)) throw FormatError("vector_io: element count overflows");
+    // the layout is a function of T alone, so anything else is corruption
+    const Header expected = make_header<T>(header.count);
+    if (header.alignment != expected.alignment || header.payload_offset != expected.payload_offset) {
+        throw FormatError("vector_io: corrupt payload layout");
+    }
+}
+
+[[noreturn]] inline void throw_errno(const char* call)
+{
+    throw std::system_error(errno, std::system_category(), call);
+}
+
+// Drains an iovec list with writev(), resuming after partial writes and EINTR.
+inline void write_all(int fd, iovec* parts, int count)
+{
+    while (count > 0) {
+        const ssize_t written = ::writev(fd, parts, count < IOV_MAX ? count : IOV_MAX);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            throw_errno("vector_io: writev");
+        }
+        auto remaining = static_cast<std::size_t>(written);
+        while (count > 0 && remaining >= parts->iov_len) {
+            remaining -= parts->iov_len;
+            ++parts;
+            --count;
+        }
+        if (count > 0) {
+            parts->iov_base = static_cast<std::byte*>(parts->iov_base) + remaining;
+            parts->iov_len -= remaining;
+        }
+    }
+}
+
+// Fills an iovec list with readv(), resuming after partial reads and EINTR; end of file is an error.
+inline void read_all(int fd, iovec* parts, int count)
+{
+    while (count > 0 && parts->iov_len == 0) {
+        ++parts;
+        --count;
+    }
+    while (count > 0) {
+        const ssize_t got = ::readv(fd, parts, count < IOV_MAX ? count : IOV_MAX);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            throw_errno("vector_io: readv");
+        }
+        if (got == 0) throw FormatError("vector_io: unexpected end of input");
+        auto remaining = static_cast<std::size_t>(got);
+        while (count > 0 && remaining >= parts->iov_len) {
+            remaining -= parts->iov_len;
+            ++parts;
+            --count;
+        }
+        if (count > 0) {
+            parts->iov_base = static_cast<std::byte*>(parts->iov_base) + remaining;
+            parts->iov_len -= remaining;
+        }
+    }
+}
+
+template <typename Range>
+concept trivially_copyable_range = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range> &&
+    std::is_trivially_copyable_v<std::ranges::range_value_t<Range>>;
+
+} // namespace detail
+
+// Returns how many bytes write_to() emits for count elements of T.
+template <typename T>
+constexpr std::size_t serialized_size(std::size_t count) noexcept
+{
+    return detail::make_header<T>(count).payload_offset + count * sizeof(T);
+}
+
+// Writes header, padding and payload of range to fd in a single writev() pass.
+template <detail::trivially_copyable_range Range>
+void write_to(int fd, const Range& range)
+{
+    using T = std::ranges::range_value_t<Range>;
+    const std::size_t count = std::ranges::size(range);
+    Header header = detail::make_header<T>(count);
+    static constexpr std::byte padding[detail::alignment_for<T>()] = {};
+
+    iovec parts[3] = {
+        {&header, sizeof(Header)},
+        {const_cast<std::byte*>(padding), header.payload_offset - sizeof(Header)},
+        {const_cast<T*>(std::ranges::data(range)), count * sizeof(T)},
+    };
+    detail::write_all(fd, parts, 3);
+}
+
+// Reads one serialized vector from fd; works on pipes and sockets as well as files. Payloads up
+// to trusted_read_bytes arrive in one readv() pass; beyond that the vector grows as data does.
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth>
+Vector<T, Allocator, GrowthPolicy> read_from(int fd, const Allocator& allocator = Allocator())
+{
+    static_assert(std::is_trivially_copyable_v<T>, "vector_io requires trivially copyable elements");
+
+    Header header{};
+    iovec head = {&header, sizeof(Header)};
+    detail::read_all(fd, &head, 1);
+    detail::validate<T>(header);
+
+    const auto count = static_cast<std::size_t>(header.count);
+    constexpr std::size_t trusted = trusted_read_bytes / sizeof(T) > 0 ? trusted_read_bytes / sizeof(T) : 1;
+    Vector<T, Allocator, GrowthPolicy> vec(allocator);
+    vec.resize_for_overwrite(count < trusted ? count : trusted);
+    std::byte padding[detail::alignment_for<T>()];
+    iovec parts[2] = {
+        {padding, static_cast<std::size_t>(header.payload_offset) - sizeof(Header)},
+        {vec.data(), vec.size() * sizeof(T)},
+    };
+    detail::read_all(fd, parts, 2);
+
+    while (vec.size() < count) {
+        const std::size_t done = vec.size();
+        const std::size_t chunk = count - done < done ? count - done : done;
+        vec.resize_for_overwrite(done + chunk);
+        iovec part = {vec.data() + done, chunk * sizeof(T)};
+        detail::read_all(fd, &part, 1);
+    }
+    return vec;
+}
+
+// Returns the elements of a serialized blob without copying them; the span points into buffer,
+// which must outlive it. Throws FormatError if the blob is truncated, does not hold T, or its
+// payload is not suitably aligned in memory.
+template <typename T>
+std::span<const T> from_buffer(std::span<const std::byte> buffer)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "vector_io requires trivially copyable elements");
+
+    Header header{};
+    if (buffer.size() < sizeof(Header)) throw FormatError("vector_io: buffer shorter than the header");
+    std::memcpy(&header, buffer.data(), sizeof(Header));
+    detail::validate<T>(header);
+
+    const auto offset = static_cast<std::size_t>(header.payload_offset);
+    const auto count = static_cast<std::size_t>(header.count);
+    if (buffer.size() < offset || buffer.size() - offset < count * sizeof(T)) {
+        throw FormatError("vector_io: buffer shorter than the payload");
+    }
+    const std::byte* payload = buffer.data() + offset;
+    if (reinterpret_cast<std::uintptr_t>(payload) % alignof(T) != 0) throw FormatError("vector_io: payload is misaligned");
+    return {reinterpret_cast<const T*>(payload), count};
+}
+
+} // namespace vector_io
+
+#endif
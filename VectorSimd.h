@@ -0,0 +1,368 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Vector.h"
+
+// Vectorized numeric kernels over the contiguous storage of a Vector (or any sized contiguous
+// range of arithmetic values). Each kernel is written once with GCC/Clang vector extensions and
+// compiled for several register widths under #pragma GCC target; the widest one the CPU supports
+// is picked at first use. Other compilers get the scalar loops only.
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define VECTOR_SIMD_X86 1
+#elif defined(__GNUC__) && (defined(__aarch64__) || defined(__ARM_NEON))
+#define VECTOR_SIMD_NEON 1
+#endif
+
+namespace simd {
+
+// Instruction sets a kernel table can be built for.
+enum class Isa { scalar, sse2, neon, avx2, avx512 };
+
+// Element types the kernels accept: integers and floating point with 1, 2, 4 or 8 byte lanes.
+template <typename T>
+concept arithmetic = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, long double> &&
+    (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+// Sized contiguous range of arithmetic values.
+template <typename Range>
+concept numeric_range = std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range> &&
+    arithmetic<std::ranges::range_value_t<Range>>;
+
+// Returns whether the running CPU can execute kernels built for isa.
+inline bool supported(Isa isa) noexcept
+{
+    switch (isa) {
+    case Isa::scalar:
+        return true;
+#if defined(VECTOR_SIMD_X86)
+    case Isa::sse2:
+        return true;
+    case Isa::avx2:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case Isa::avx512:
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+            __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl");
+#elif defined(VECTOR_SIMD_NEON)
+    case Isa::neon:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+// Returns the widest instruction set supported by the running CPU, detected once.
+inline Isa detected_isa() noexcept
+{
+    static const Isa best = [] {
+        for (Isa isa : {Isa::avx512, Isa::avx2, Isa::neon, Isa::sse2}) {
+            if (supported(isa)) return isa;
+        }
+        return Isa::scalar;
+    }();
+    return best;
+}
+
+// Returns a printable name for isa.
+constexpr const char* isa_name(Isa isa) noexcept
+{
+    switch (isa) {
+    case Isa::sse2: return "sse2";
+    case Isa::neon: return "neon";
+    case Isa::avx2: return "avx2";
+    case Isa::avx512: return "avx512";
+    default: return "scalar";
+    }
+}
+
+namespace detail {
+
+// Arithmetic in the lane type with integer overflow wrapping instead of being undefined.
+template <typename T>
+struct Wrapping
+{
+    using Acc = typename std::conditional_t<std::is_integral_v<T>, std::make_unsigned<T>, std::type_identity<T>>::type;
+    // Small integers promote to int in scalar code, so compute in unsigned int and truncate.
+    using Wide = std::conditional_t<std::is_integral_v<T> && (sizeof(T) < sizeof(unsigned)), unsigned, Acc>;
+
+    static constexpr Acc add(Acc a, Acc b) noexcept
+    {
+        return static_cast<Acc>(static_cast<Wide>(a) + static_cast<Wide>(b));
+    }
+
+    static constexpr Acc mul(Acc a, Acc b) noexcept
+    {
+        return static_cast<Acc>(static_cast<Wide>(a) * static_cast<Wide>(b));
+    }
+};
+
+// Reference loops, also the fallback when no vector unit is available.
+template <typename T>
+struct ScalarKernels
+{
+    using W = Wrapping<T>;
+    using Acc = typename W::Acc;
+
+    static T sum(const T* data, std::size_t n) noexcept
+    {
+        Acc total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            total = W::add(total, static_cast<Acc>(data[i]));
+        }
+        return static_cast<T>(total);
+    }
+
+    static std::pair<T, T> minmax(const T* data, std::size_t n) noexcept
+    {
+        T lo = data[0];
+        T hi = data[0];
+        for (std::size_t i = 1; i < n; ++i) {
+            lo = data[i] < lo ? data[i] : lo;
+            hi = data[i] > hi ? data[i] : hi;
+        }
+        return {lo, hi};
+    }
+
+    static T dot(const T* a, const T* b, std::size_t n) noexcept
+    {
+        Acc total = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            total = W::add(total, W::mul(static_cast<Acc>(a[i]), static_cast<Acc>(b[i])));
+        }
+        return static_cast<T>(total);
+    }
+
+    static void axpy(T alpha, const T* x, T* y, std::size_t n) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            y[i] = static_cast<T>(W::add(W::mul(static_cast<Acc>(alpha), static_cast<Acc>(x[i])), static_cast<Acc>(y[i])));
+        }
+    }
+
+    static void add(const T* a, const T* b, T* out, std::size_t n) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<T>(W::add(static_cast<Acc>(a[i]), static_cast<Acc>(b[i])));
+        }
+    }
+
+    static void mul(const T* a, const T* b, T* out, std::size_t n) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = static_cast<T>(W::mul(static_cast<Acc>(a[i]), static_cast<Acc>(b[i])));
+        }
+    }
+
+    static std::size_t find(const T* data, std::size_t n, T value) noexcept
+    {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (data[i] == value) return i;
+        }
+        return n;
+    }
+
+    static std::size_t count(const T* data, std::size_t n, T value) noexcept
+    {
+        std::size_t matches = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            matches += data[i] == value;
+        }
+        return matches;
+    }
+};
+
+// One entry per kernel, all built for the same instruction set.
+template <typename T>
+struct KernelTable
+{
+    T (*sum)(const T*, std::size_t) noexcept;
+    std::pair<T, T> (*minmax)(const T*, std::size_t) noexcept;
+    T (*dot)(const T*, const T*, std::size_t) noexcept;
+    void (*axpy)(T, const T*, T*, std::size_t) noexcept;
+    void (*add)(const T*, const T*, T*, std::size_t) noexcept;
+    void (*mul)(const T*, const T*, T*, std::size_t) noexcept;
+    std::size_t (*find)(const T*, std::size_t, T) noexcept;
+    std::size_t (*count)(const T*, std::size_t, T) noexcept;
+};
+
+// Collects the entry points of one kernel set.
+template <typename T, typename K>
+inline constexpr KernelTable<T> table_of{&K::sum, &K::minmax, &K::dot, &K::axpy, &K::add, &K::mul, &K::find, &K::count};
+
+} // namespace detail
+} // namespace simd
+
+// x86-64 always has SSE2 and AArch64 always has NEON; the AVX sets are built in target regions.
+#if defined(VECTOR_SIMD_X86)
+#define VECTOR_SIMD_KERNEL_NAMESPACE sse2
+#define VECTOR_SIMD_KERNEL_BYTES 16
+#include "VectorSimdKernels.inc"
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#define VECTOR_SIMD_KERNEL_NAMESPACE avx2
+#define VECTOR_SIMD_KERNEL_BYTES 32
+#include "VectorSimdKernels.inc"
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx512bw,avx512dq,avx512vl")
+#define VECTOR_SIMD_KERNEL_NAMESPACE avx512
+#define VECTOR_SIMD_KERNEL_BYTES 64
+#include "VectorSimdKernels.inc"
+#pragma GCC pop_options
+#elif defined(VECTOR_SIMD_NEON)
+#define VECTOR_SIMD_KERNEL_NAMESPACE neon
+#define VECTOR_SIMD_KERNEL_BYTES 16
+#include "VectorSimdKernels.inc"
+#endif
+
+namespace simd {
+namespace detail {
+
+// Returns the kernels built for isa, or the scalar ones when isa was not compiled in.
+template <arithmetic T>
+const KernelTable<T>& kernels_for(Isa isa) noexcept
+{
+    switch (isa) {
+#if defined(VECTOR_SIMD_X86)
+    case Isa::sse2: return table_of<T, sse2::Kernels<T>>;
+    case Isa::avx2: return table_of<T, avx2::Kernels<T>>;
+    case Isa::avx512: return table_of<T, avx512::Kernels<T>>;
+#elif defined(VECTOR_SIMD_NEON)
+    case Isa::neon: return table_of<T, neon::Kernels<T>>;
+#endif
+    default: return table_of<T, ScalarKernels<T>>;
+    }
+}
+
+// Returns the kernels for the running CPU.
+template <arithmetic T>
+const KernelTable<T>& kernels() noexcept
+{
+    static const KernelTable<T>& table = kernels_for<T>(detected_isa());
+    return table;
+}
+
+template <typename Range>
+using value_t = std::ranges::range_value_t<Range>;
+
+// Throws unless two operands have the same length.
+inline void require_same_size(std::size_t a, std::size_t b, const char* what)
+{
+    if (a != b) throw std::invalid_argument(what);
+}
+
+// Sizes out to n elements that are about to be overwritten.
+template <typename Output>
+void size_for_overwrite(Output& out, std::size_t n)
+{
+    if constexpr (requires { out.resize_for_overwrite(n); }) {
+        out.resize_for_overwrite(n);
+    } else {
+        out.resize(n);
+    }
+}
+
+} // namespace detail
+
+// Returns the sum of every element; integers wrap around in the element type.
+template <numeric_range Range>
+detail::value_t<Range> sum(const Range& range) noexcept
+{
+    return detail::kernels<detail::value_t<Range>>().sum(std::ranges::data(range), std::ranges::size(range));
+}
+
+// Returns the smallest and largest element. Throws std::out_of_range on an empty range.
+// Ranges holding NaN give unspecified results.
+template <numeric_range Range>
+std::pair<detail::value_t<Range>, detail::value_t<Range>> minmax(const Range& range)
+{
+    if (std::ranges::empty(range)) throw std::out_of_range("simd::minmax of an empty range");
+    return detail::kernels<detail::value_t<Range>>().minmax(std::ranges::data(range), std::ranges::size(range));
+}
+
+// Returns the smallest element. Throws std::out_of_range on an empty range.
+template <numeric_range Range>
+detail::value_t<Range> min(const Range& range)
+{
+    return minmax(range).first;
+}
+
+// Returns the largest element. Throws std::out_of_range on an empty range.
+template <numeric_range Range>
+detail::value_t<Range> max(const Range& range)
+{
+    return minmax(range).second;
+}
+
+// Returns the sum of a[i] * b[i]. Throws std::invalid_argument if the lengths differ.
+template <numeric_range A, numeric_range B>
+    requires std::same_as<detail::value_t<A>, detail::value_t<B>>
+detail::value_t<A> dot(const A& a, const B& b)
+{
+    detail::require_same_size(std::ranges::size(a), std::ranges::size(b), "simd::dot of ranges with different sizes");
+    return detail::kernels<detail::value_t<A>>().dot(std::ranges::data(a), std::ranges::data(b), std::ranges::size(a));
+}
+
+// Computes y[i] += alpha * x[i]. Throws std::invalid_argument if the lengths differ.
+template <numeric_range X, numeric_range Y>
+    requires std::same_as<detail::value_t<X>, detail::value_t<Y>>
+void axpy(detail::value_t<X> alpha, const X& x, Y&& y)
+{
+    detail::require_same_size(std::ranges::size(x), std::ranges::size(y), "simd::axpy of ranges with different sizes");
+    detail::kernels<detail::value_t<X>>().axpy(alpha, std::ranges::data(x), std::ranges::data(y), std::ranges::size(x));
+}
+
+// Stores a[i] + b[i] into out, sizing it to match; out may alias a or b.
+// Throws std::invalid_argument if the inputs' lengths differ.
+template <numeric_range A, numeric_range B, typename Output>
+    requires std::same_as<detail::value_t<A>, detail::value_t<B>>
+void add(const A& a, const B& b, Output& out)
+{
+    const std::size_t n = std::ranges::size(a);
+    detail::require_same_size(n, std::ranges::size(b), "simd::add of ranges with different sizes");
+    if (static_cast<std::size_t>(std::ranges::size(out)) != n) detail::size_for_overwrite(out, n);
+    detail::kernels<detail::value_t<A>>().add(std::ranges::data(a), std::ranges::data(b), std::ranges::data(out), n);
+}
+
+// Stores a[i] * b[i] into out, sizing it to match; out may alias a or b.
+// Throws std::invalid_argument if the inputs' lengths differ.
+template <numeric_range A, numeric_range B, typename Output>
+    requires std::same_as<detail::value_t<A>, detail::value_t<B>>
+void mul(const A& a, const B& b, Output& out)
+{
+    const std::size_t n = std::ranges::size(a);
+    detail::require_same_size(n, std::ranges::size(b), "simd::mul of ranges with different sizes");
+    if (static_cast<std::size_t>(std::ranges::size(out)) != n) detail::size_for_overwrite(out, n);
+    detail::kernels<detail::value_t<A>>().mul(std::ranges::data(a), std::ranges::data(b), std::ranges::data(out), n);
+}
+
+// Returns an iterator to the first element equal to value, or end() if there is none.
+template <numeric_range Range>
+std::ranges::borrowed_iterator_t<Range> find(Range&& range, detail::value_t<Range> value) noexcept
+{
+    const std::size_t n = std::ranges::size(range);
+    const std::size_t index = detail::kernels<detail::value_t<Range>>().find(std::ranges::data(range), n, value);
+    return std::ranges::begin(range) + static_cast<std::ranges::range_difference_t<Range>>(index);
+}
+
+// Returns how many elements equal value.
+template <numeric_range Range>
+std::size_t count(const Range& range, detail::value_t<Range> value) noexcept
+{
+    return detail::kernels<detail::value_t<Range>>().count(std::ranges::data(range), std::ranges::size(range), value);
+}
+
+} // namespace simd
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <cstddef>
+
+// Allocation and growth statistics for Vector, compiled in only when VECTOR_STATS is defined.
+// Every Vector records the call site that constructed it and reports reallocations, bytes
+// moved by reallocate(), peak capacity and capacity left unused at destruction into a
+// per-site entry of VectorStatsRegistry. Without VECTOR_STATS the hooks are empty inline
+// functions on an empty member and cost nothing.
+
+#if defined(VECTOR_STATS)
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <source_location>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+// Counters shared by every Vector constructed at one call site.
+struct VectorSiteStats
+{
+    std::string_view file;
+    std::uint_least32_t line = 0;
+    std::uint_least32_t column = 0;
+    std::string_view function;
+
+    std::atomic<std::uint64_t> constructions{0};
+    std::atomic<std::uint64_t> destructions{0};
+    std::atomic<std::uint64_t> reallocations{0};
+    std::atomic<std::uint64_t> bytes_moved{0};
+    std::atomic<std::uint64_t> peak_capacity_bytes{0};
+    std::atomic<std::uint64_t> wasted_bytes_at_destruction{0};
+};
+
+// Plain copy of one site's counters, safe to hand to a metrics exporter.
+struct VectorSiteSnapshot
+{
+    std::string_view file;
+    std::uint_least32_t line;
+    std::uint_least32_t column;
+    std::string_view function;
+    std::uint64_t constructions;
+    std::uint64_t destructions;
+    std::uint64_t reallocations;
+    std::uint64_t bytes_moved;
+    std::uint64_t peak_capacity_bytes;
+    std::uint64_t wasted_bytes_at_destruction;
+};
+
+// Process-wide table of call sites; entries live until the process exits.
+class VectorStatsRegistry
+{
+public:
+    // Returns the registry every Vector reports to.
+    static VectorStatsRegistry& instance()
+    {
+        static VectorStatsRegistry registry;
+        return registry;
+    }
+
+    // Returns the entry for a call site, creating it on first use.
+    // Each thread caches the lookup, so only a thread's first visit to a site takes the lock.
+    VectorSiteStats& site(const std::source_location& location) noexcept
+    {
+        thread_local std::unordered_map<const void*, std::unordered_map<std::uint64_t, VectorSiteStats*>> cache;
+        const std::uint64_t position = (static_cast<std::uint64_t>(location.line()) << 32) | location.column();
+        try {
+            VectorSiteStats*& cached = cache[location.file_name()][position];
+            if (!cached) cached = &lookup(location);
+            return *cached;
+        } catch (...) {
+            return _unknown;
+        }
+    }
+
+    // Copies every site's counters.
+    [[nodiscard]] std::vector<VectorSiteSnapshot> snapshot() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        std::vector<VectorSiteSnapshot> result;
+        result.reserve(_sites.size());
+        for (const VectorSiteStats& site : _sites) {
+            result.push_back(read(site));
+        }
+        return result;
+    }
+
+    // Calls visit with a snapshot of each site, e.g. to publish them as metrics.
+    template <typename Visitor>
+    void for_each(Visitor&& visit) const
+    {
+        for (const VectorSiteSnapshot& site : snapshot()) {
+            visit(site);
+        }
+    }
+
+    // Zeroes every counter while keeping the sites registered.
+    void reset() noexcept
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (VectorSiteStats& site : _sites) {
+            site.constructions = 0;
+            site.destructions = 0;
+            site.reallocations = 0;
+            site.bytes_moved = 0;
+            site.peak_capacity_bytes = 0;
+            site.wasted_bytes_at_destruction = 0;
+        }
+    }
+
+private:
+    VectorStatsRegistry() = default;
+
+    // Finds or inserts the shared entry for a location under the lock.
+    VectorSiteStats& lookup(const std::source_location& location)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // the same header line seen from different translation units must land on one entry
+        auto key = std::make_tuple(std::string_view(location.file_name()), location.line(), location.column());
+        auto found = _index.find(key);
+        if (found != _index.end()) return *found->second;
+
+        VectorSiteStats& site = _sites.emplace_back();
+        site.file = location.file_name();
+        site.line = location.line();
+        site.column = location.column();
+        site.function = location.function_name();
+        _index.emplace(key, &site);
+        return site;
+    }
+
+    // Copies one site's counters.
+    static VectorSiteSnapshot read(const VectorSiteStats& site) noexcept
+    {
+        return {site.file, site.line, site.column, site.function,
+                site.constructions.load(std::memory_order_relaxed),
+                site.destructions.load(std::memory_order_relaxed),
+                site.reallocations.load(std::memory_order_relaxed),
+                site.bytes_moved.load(std::memory_order_relaxed),
+                site.peak_capacity_bytes.load(std::memory_order_relaxed),
+                site.wasted_bytes_at_destruction.load(std::memory_order_relaxed)};
+    }
+
+    mutable std::mutex _mutex;
+    std::deque<VectorSiteStats> _sites; // deque keeps entry addresses stable
+    std::map<std::tuple<std::string_view, std::uint_least32_t, std::uint_least32_t>, VectorSiteStats*> _index;
+    VectorSiteStats _unknown;
+};
+
+// Per-vector link to its call site's counters.
+class VectorStatsHandle
+{
+public:
+    // Registers a construction at the given call site.
+    explicit VectorStatsHandle(const std::source_location& location) noexcept
+        : _site(&VectorStatsRegistry::instance().site(location))
+    {
+        _site->constructions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Records that a buffer of capacity_bytes was obtained, raising the site's peak.
+    void on_allocate(std::size_t capacity_bytes) noexcept
+    {
+        std::uint64_t peak = _site->peak_capacity_bytes.load(std::memory_order_relaxed);
+        while (peak < capacity_bytes &&
+               !_site->peak_capacity_bytes.compare_exchange_weak(peak, capacity_bytes, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Records one growth that carried moved_bytes of elements to the new buffer.
+    void on_reallocate(std::size_t moved_bytes) noexcept
+    {
+        _site->reallocations.fetch_add(1, std::memory_order_relaxed);
+        _site->bytes_moved.fetch_add(moved_bytes, std::memory_order_relaxed);
+    }
+
+    // Records a destruction that left wasted_bytes of capacity unused.
+    void on_destroy(std::size_t wasted_bytes) noexcept
+    {
+        _site->destructions.fetch_add(1, std::memory_order_relaxed);
+        _site->wasted_bytes_at_destruction.fetch_add(wasted_bytes, std::memory_order_relaxed);
+    }
+
+    // Returns the counters this vector reports to.
+    [[nodiscard]] const VectorSiteStats& site() const noexcept
+    {
+        return *_site;
+    }
+
+private:
+    VectorSiteStats* _site;
+};
+
+// Extra trailing constructor parameter that captures the caller's location.
+#define VECTOR_STATS_SITE_PARAM , std::source_location site = std::source_location::current()
+// The same parameter for constructors that otherwise take none.
+#define VECTOR_STATS_SITE_ONLY_PARAM std::source_location site = std::source_location::current()
+// Forwards the captured location to a delegated-to constructor.
+#define VECTOR_STATS_SITE_ARG , site
+// Initializes the stats member from the captured location.
+#define VECTOR_STATS_INIT , _stats(site)
+
+#else
+
+// Stand-in with the same hooks that compiles to nothing.
+struct VectorStatsHandle
+{
+    constexpr void on_allocate(std::size_t) noexcept {}
+    constexpr void on_reallocate(std::size_t) noexcept {}
+    constexpr void on_destroy(std::size_t) noexcept {}
+};
+
+#define VECTOR_STATS_SITE_PARAM
+#define VECTOR_STATS_SITE_ONLY_PARAM
+#define VECTOR_STATS_SITE_ARG
+#define VECTOR_STATS_INIT
+
+#endif
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Vector.h"
+
+// Non-owning window onto contiguous elements: a pointer and a length, cheap to copy and pass by
+// value. Views of a Vector stay valid until the Vector reallocates or is destroyed, like its
+// iterators. VectorView<const T> is the read-only form; a VectorView<T> converts to it.
+template <typename T>
+class VectorView
+{
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer_type = T*;
+    using reference = T&;
+    using iterator = VectorIterator<T>;
+
+    // Length argument of slice() that stands for "to the end".
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    // Creates an empty view.
+    constexpr VectorView() noexcept = default;
+
+    // Creates a view of count elements starting at data.
+    constexpr VectorView(T* data, size_type count) noexcept
+        : _data(data), _size(count) {}
+
+    // Views every element of a Vector, SmallVector, std::span or any other contiguous range whose
+    // elements convert to T by qualification only. Temporary containers are rejected, since the
+    // view would dangle at once; temporary views such as std::span are borrowed and accepted.
+    template <typename Range>
+        requires(!std::is_same_v<std::remove_cvref_t<Range>, VectorView> &&
+                 std::ranges::contiguous_range<Range> && std::ranges::sized_range<Range> &&
+                 std::ranges::borrowed_range<Range> &&
+                 std::is_convertible_v<std::remove_reference_t<std::ranges::range_reference_t<Range>> (*)[], T (*)[]>)
+    constexpr VectorView(Range&& range) noexcept
+        : _data(std::ranges::data(range)), _size(static_cast<size_type>(std::ranges::size(range))) {}
+
+    // Converts a view of mutable elements into a view of const ones.
+    template <typename U>
+        requires(std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+    constexpr VectorView(const VectorView<U>& other) noexcept
+        : _data(other.data()), _size(other.size()) {}
+
+    // Converts to a std::span over the same elements.
+    constexpr operator std::span<T>() const noexcept
+    {
+        return {_data, _size};
+    }
+
+    // Returns the number of elements in view.
+    [[nodiscard]] constexpr size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    // Returns whether the view holds no elements.
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    // Returns a pointer to the first element in view.
+    [[nodiscard]] constexpr T* data() const noexcept
+    {
+        return _data;
+    }
+
+    // Returns a reference to the element at the supplied index, throwing if it is out of range.
+    constexpr reference at(size_type index) const
+    {
+        if (index >= _size) throw std::out_of_range("index out of range");
+        return _data[index];
+    }
+
+    // Returns a reference to the element at the supplied index without a bounds check.
+    constexpr reference operator[](size_type index) const
+    {
+        VECTOR_ASSERT(index < _size, "index out of range");
+        return _data[index];
+    }
+
+    // Returns a reference to the first element.
+    constexpr reference front() const
+    {
+        VECTOR_ASSERT(_size > 0, "front() on empty view");
+        return _data[0];
+    }
+
+    // Returns a reference to the last element.
+    constexpr reference back() const
+    {
+        VECTOR_ASSERT(_size > 0, "back() on empty view");
+        return _data[_size - 1];
+    }
+
+    // Returns the window of up to count elements starting at offset, clamped to the end of this
+    // view. Throws std::out_of_range if offset is past the end.
+    constexpr VectorView slice(size_type offset, size_type count = npos) const
+    {
+        if (offset > _size) throw std::out_of_range("slice offset out of range");
+        const size_type available = _size - offset;
+        return {_data + offset, count < available ? count : available};
+    }
+
+    // Returns the first count elements; throws std::out_of_range if there are fewer.
+    constexpr VectorView first(size_type count) const
+    {
+        if (count > _size) throw std::out_of_range("first() longer than view");
+        return {_data, count};
+    }
+
+    // Returns the last count elements; throws std::out_of_range if there are fewer.
+    constexpr VectorView last(size_type count) const
+    {
+        if (count > _size) throw std::out_of_range("last() longer than view");
+        return {_data + (_size - count), count};
+    }
+
+    // Returns an iterator to the first element in view.
+    constexpr iterator begin() const noexcept
+    {
+        return iterator(_data);
+    }
+
+    // Returns an iterator past the last element in view.
+    constexpr iterator end() const noexcept
+    {
+        return iterator(_data + _size);
+    }
+
+private:
+    T* _data = nullptr;
+    size_type _size = 0;
+};
+
+template <typename Range>
+    requires std::ranges::contiguous_range<Range> && std::ranges::borrowed_range<Range>
+VectorView(Range&&) -> VectorView<std::remove_reference_t<std::ranges::range_reference_t<Range>>>;
+
+template <typename T>
+VectorView(T*, std::size_t) -> VectorView<T>;
+
+// Views are cheap to copy and never own their elements.
+template <typename T>
+inline constexpr bool std::ranges::enable_borrowed_range<VectorView<T>> = true;
+
+template <typename T>
+inline constexpr bool std::ranges::enable_view<VectorView<T>> = true;
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "../ChunkedVector.h"
+#include "../IncrementalVector.h"
+#include "../Vector.h"
+
+// Per-call push_back latency while growing to state.range(0) elements. Vector's doublings show
+// up as a tail that grows with the container; ChunkedVector's tail is one chunk allocation and
+// IncrementalVector's is one buffer allocation plus a migration batch.
+// Counters are nanoseconds: p50/p99/p999 of single appends and the single slowest one.
+
+namespace {
+template <typename Container>
+void BM_AppendLatency(benchmark::State& state)
+{
+    using clock = std::chrono::steady_clock;
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<std::int64_t> samples;
+    samples.reserve(count * 4);
+
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto start = clock::now();
+            container.push_back(i);
+            const auto stop = clock::now();
+            samples.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        }
+        benchmark::DoNotOptimize(&container.back());
+    }
+
+    const auto percentile = [&](double fraction) {
+        auto nth = samples.begin() + static_cast<std::ptrdiff_t>(fraction * static_cast<double>(samples.size() - 1));
+        std::nth_element(samples.begin(), nth, samples.end());
+        return static_cast<double>(*nth);
+    };
+    state.counters["p50_ns"] = percentile(0.5);
+    state.counters["p99_ns"] = percentile(0.99);
+    state.counters["p999_ns"] = percentile(0.999);
+    state.counters["max_ns"] = static_cast<double>(*std::max_element(samples.begin(), samples.end()));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+}
+} // namespace
+
+BENCHMARK(BM_AppendLatency<Vector<std::uint64_t>>)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->Iterations(3);
+BENCHMARK(BM_AppendLatency<ChunkedVector<std::uint64_t>>)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->Iterations(3);
+BENCHMARK(BM_AppendLatency<IncrementalVector<std::uint64_t>>)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->Iterations(3);
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "../ConcurrentVector.h"
+
+// Many threads appending to one shared container: a mutex around Vector against the lock-free
+// ConcurrentVector. Thread 0 recreates the container before each run; the benchmark barrier
+// keeps the other threads off it until then.
+
+namespace {
+struct LockedVector
+{
+    std::mutex mutex;
+    Vector<std::uint64_t> vec;
+};
+
+std::unique_ptr<LockedVector> locked;
+std::unique_ptr<ConcurrentVector<std::uint64_t>> concurrent;
+
+void BM_MutexVectorPushBack(benchmark::State& state)
+{
+    if (state.thread_index() == 0) locked = std::make_unique<LockedVector>();
+    std::uint64_t value = 0;
+    for (auto _ : state) {
+        std::lock_guard lock(locked->mutex);
+        locked->vec.push_back(value++);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ConcurrentVectorPushBack(benchmark::State& state)
+{
+    if (state.thread_index() == 0) concurrent = std::make_unique<ConcurrentVector<std::uint64_t>>();
+    std::uint64_t value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(concurrent->push_back(value++));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ConcurrentVectorGrowBy(benchmark::State& state)
+{
+    if (state.thread_index() == 0) concurrent = std::make_unique<ConcurrentVector<std::uint64_t>>();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(concurrent->grow_by(64));
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+}
+} // namespace
+
+BENCHMARK(BM_MutexVectorPushBack)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ConcurrentVectorPushBack)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_ConcurrentVectorGrowBy)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,53 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../CowVector.h"
+#include "../Vector.h"
+
+// Handing a snapshot of a large table to a reader: a deep Vector copy against a CowVector copy,
+// and a publish/load round trip through AtomicCowVector.
+
+namespace {
+Vector<double> make_table(std::size_t count)
+{
+    Vector<double> table;
+    table.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        table.push_back(static_cast<double>(i));
+    }
+    return table;
+}
+
+void BM_SnapshotDeepCopy(benchmark::State& state)
+{
+    const Vector<double> table = make_table(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        Vector<double> snapshot(table);
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * static_cast<std::int64_t>(sizeof(double)));
+}
+
+void BM_SnapshotCow(benchmark::State& state)
+{
+    const CowVector<double> table(make_table(static_cast<std::size_t>(state.range(0))));
+    for (auto _ : state) {
+        const CowVector<double> snapshot(table);
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+}
+
+void BM_SnapshotPublishAndLoad(benchmark::State& state)
+{
+    AtomicCowVector<double> slot;
+    const CowVector<double> table(make_table(static_cast<std::size_t>(state.range(0))));
+    for (auto _ : state) {
+        slot.store(table);
+        const CowVector<double> snapshot = slot.load();
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+}
+} // namespace
+
+BENCHMARK(BM_SnapshotDeepCopy)->RangeMultiplier(32)->Range(1 << 10, 1 << 25);
+BENCHMARK(BM_SnapshotCow)->RangeMultiplier(32)->Range(1 << 10, 1 << 25);
+BENCHMARK(BM_SnapshotPublishAndLoad)->RangeMultiplier(32)->Range(1 << 10, 1 << 25);
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <map>
+#include <random>
+#include "../FlatMap.h"
+#include "../Vector.h"
+
+// Random successful lookups in a node-based std::map against FlatMap's branchless binary search
+// and its Eytzinger lookup index, at sizes from in-cache to well past the last-level cache.
+
+namespace {
+constexpr std::size_t lookups = 1 << 12;
+
+Vector<std::uint64_t> make_probes(std::size_t count)
+{
+    std::mt19937_64 random(42);
+    Vector<std::uint64_t> probes;
+    probes.reserve(lookups);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        probes.push_back(random() % count * 2);
+    }
+    return probes;
+}
+
+void BM_StdMapFind(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::map<std::uint64_t, std::uint64_t> map;
+    for (std::size_t i = 0; i < count; ++i) {
+        map.emplace(i * 2, i);
+    }
+    const Vector<std::uint64_t> probes = make_probes(count);
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (std::uint64_t key : probes) {
+            sum += map.find(key)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * lookups);
+}
+
+FlatMap<std::uint64_t, std::uint64_t> make_flat_map(std::size_t count)
+{
+    FlatMap<std::uint64_t, std::uint64_t> map;
+    Vector<std::pair<std::uint64_t, std::uint64_t>> sorted;
+    sorted.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        sorted.emplace_back(i * 2, i);
+    }
+    map.insert_sorted_range(sorted.begin(), sorted.end());
+    return map;
+}
+
+void run_flat_map(benchmark::State& state, bool indexed)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    FlatMap<std::uint64_t, std::uint64_t> map = make_flat_map(count);
+    if (indexed) map.build_lookup_index();
+    const Vector<std::uint64_t> probes = make_probes(count);
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (std::uint64_t key : probes) {
+            sum += map.find(key)->second;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * lookups);
+}
+
+void BM_FlatMapFind(benchmark::State& state)
+{
+    run_flat_map(state, false);
+}
+
+void BM_FlatMapIndexedFind(benchmark::State& state)
+{
+    run_flat_map(state, true);
+}
+} // namespace
+
+BENCHMARK(BM_StdMapFind)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_FlatMapFind)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_FlatMapIndexedFind)->RangeMultiplier(16)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../Allocator.h"
+#include "../Vector.h"
+
+namespace {
+// Grows a vector of floats from empty to state.range(0) elements one push_back at a time.
+template <typename Alloc>
+void BM_PushBackGrowth(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        Vector<float, Alloc> vec;
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.push_back(static_cast<float>(i));
+        }
+        benchmark::DoNotOptimize(vec.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * count));
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * count * sizeof(float)));
+}
+
+// Doubles an already-full vector once, isolating the cost of a single large reallocation.
+template <typename Alloc>
+void BM_SingleDoubling(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Vector<float, Alloc> vec;
+        vec.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.push_back(static_cast<float>(i));
+        }
+        state.ResumeTiming();
+
+        vec.push_back(0.0f); // triggers the doubling
+        benchmark::DoNotOptimize(vec.data());
+
+        state.PauseTiming();
+        vec = Vector<float, Alloc>();
+        state.ResumeTiming();
+    }
+}
+
+// Builds and drops short-lived vectors of up to state.range(0) ints, each passing through
+// every power-of-two capacity on the way, on every benchmark thread at once.
+template <typename Alloc>
+void BM_SmallVectorChurn(benchmark::State& state)
+{
+    const auto longest = static_cast<int>(state.range(0));
+    int length = 1;
+    for (auto _ : state) {
+        Vector<int, Alloc> vec;
+        for (int i = 0; i < length; ++i) {
+            vec.push_back(i);
+        }
+        benchmark::DoNotOptimize(vec.data());
+        length = length == longest ? 1 : length + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+BENCHMARK(BM_PushBackGrowth<std::allocator<float>>)->RangeMultiplier(8)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_PushBackGrowth<ReallocAllocator<float>>)->RangeMultiplier(8)->Range(1 << 12, 1 << 24);
+#if defined(__linux__)
+BENCHMARK(BM_PushBackGrowth<MremapAllocator<float>>)->RangeMultiplier(8)->Range(1 << 12, 1 << 24);
+#endif
+
+BENCHMARK(BM_SingleDoubling<std::allocator<float>>)->RangeMultiplier(4)->Range(1 << 18, 1 << 24)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SingleDoubling<ReallocAllocator<float>>)->RangeMultiplier(4)->Range(1 << 18, 1 << 24)->Unit(benchmark::kMicrosecond);
+#if defined(__linux__)
+BENCHMARK(BM_SingleDoubling<MremapAllocator<float>>)->RangeMultiplier(4)->Range(1 << 18, 1 << 24)->Unit(benchmark::kMicrosecond);
+#endif
+
+BENCHMARK(BM_SmallVectorChurn<std::allocator<int>>)->Arg(256)->Threads(1)->Threads(4);
+BENCHMARK(BM_SmallVectorChurn<RecyclingAllocator<int>>)->Arg(256)->Threads(1)->Threads(4);
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../PackedVector.h"
+#include "../Vector.h"
+
+// Bitmap intersection with a byte per flag against one bit per flag, and decoding 12-bit ids
+// one element at a time against the block decoder.
+
+namespace {
+void BM_ByteFlagsAndCount(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Vector<bool> a;
+    Vector<bool> b;
+    for (std::size_t i = 0; i < count; ++i) {
+        a.push_back(i % 3 == 0);
+        b.push_back(i % 5 == 0);
+    }
+    for (auto _ : state) {
+        std::size_t matches = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            matches += a[i] & b[i];
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_BitVectorAndPopcount(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    BitVector<> a(count);
+    BitVector<> b(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        a.set(i, i % 3 == 0);
+        b.set(i, i % 5 == 0);
+    }
+    BitVector<> scratch;
+    for (auto _ : state) {
+        scratch = a;
+        scratch &= b;
+        benchmark::DoNotOptimize(scratch.popcount());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+PackedIntVector<12> make_ids(std::size_t count)
+{
+    PackedIntVector<12> ids;
+    ids.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        ids.push_back(static_cast<std::uint16_t>(i * 37 % 4096));
+    }
+    return ids;
+}
+
+void BM_PackedIntElementwise(benchmark::State& state)
+{
+    const PackedIntVector<12> ids = make_ids(static_cast<std::size_t>(state.range(0)));
+    Vector<std::uint16_t> out;
+    out.resize(ids.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < ids.size(); ++i) {
+            out[i] = ids[i];
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_PackedIntUnpack(benchmark::State& state)
+{
+    const PackedIntVector<12> ids = make_ids(static_cast<std::size_t>(state.range(0)));
+    Vector<std::uint16_t> out;
+    out.resize(ids.size());
+    for (auto _ : state) {
+        ids.unpack(0, std::span<std::uint16_t>(out.data(), out.size()));
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_ByteFlagsAndCount)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_BitVectorAndPopcount)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_PackedIntElementwise)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
+BENCHMARK(BM_PackedIntUnpack)->RangeMultiplier(64)->Range(1 << 12, 1 << 24);
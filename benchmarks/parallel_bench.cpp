@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <random>
+#include "../VectorParallel.h"
+
+// Serial std:: algorithms against the VectorParallel adapters on the shared pool, so the
+// ratio between neighbouring rows is the speed-up.
+
+namespace {
+Vector<std::uint64_t> make_shuffled(std::size_t count)
+{
+    Vector<std::uint64_t> vec;
+    vec.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        vec.push_back(i);
+    }
+    std::shuffle(vec.begin(), vec.end(), std::mt19937_64(42));
+    return vec;
+}
+
+// Reports throughput as elements handled per second.
+void set_items(benchmark::State& state)
+{
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SerialTransform(benchmark::State& state)
+{
+    const auto input = make_shuffled(static_cast<std::size_t>(state.range(0)));
+    Vector<float> output;
+    output.resize(input.size());
+    for (auto _ : state) {
+        std::transform(input.begin(), input.end(), output.begin(), [](std::uint64_t v) { return static_cast<float>(v) * 0.5f; });
+        benchmark::DoNotOptimize(output.data());
+    }
+    set_items(state);
+}
+
+void BM_ParallelTransform(benchmark::State& state)
+{
+    const auto input = make_shuffled(static_cast<std::size_t>(state.range(0)));
+    Vector<float> output;
+    output.resize(input.size());
+    for (auto _ : state) {
+        parallel_transform(input, output, [](std::uint64_t v) { return static_cast<float>(v) * 0.5f; });
+        benchmark::DoNotOptimize(output.data());
+    }
+    set_items(state);
+}
+
+void BM_SerialReduce(benchmark::State& state)
+{
+    const auto input = make_shuffled(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::reduce(input.begin(), input.end(), std::uint64_t{0}));
+    }
+    set_items(state);
+}
+
+void BM_ParallelReduce(benchmark::State& state)
+{
+    const auto input = make_shuffled(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parallel_reduce(input, std::uint64_t{0}));
+    }
+    set_items(state);
+}
+
+void BM_SerialSort(benchmark::State& state)
+{
+    const auto source = make_shuffled(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto vec = source;
+        state.ResumeTiming();
+        std::sort(vec.begin(), vec.end());
+        benchmark::DoNotOptimize(vec.data());
+    }
+    set_items(state);
+}
+
+void BM_ParallelSort(benchmark::State& state)
+{
+    const auto source = make_shuffled(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto vec = source;
+        state.ResumeTiming();
+        parallel_sort(vec);
+        benchmark::DoNotOptimize(vec.data());
+    }
+    set_items(state);
+}
+} // namespace
+
+BENCHMARK(BM_SerialTransform)->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParallelTransform)->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SerialReduce)->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParallelReduce)->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SerialSort)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_ParallelSort)->RangeMultiplier(16)->Range(1 << 12, 1 << 22)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,229 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../VectorSimd.h"
+
+// Naive index loops over Vector against the dispatched simd:: kernels, one pair per operation.
+
+namespace {
+template <typename T>
+Vector<T> make_values(std::size_t count, std::size_t seed)
+{
+    Vector<T> vec;
+    vec.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        vec.push_back(static_cast<T>((i * 37 + seed) % 101));
+    }
+    return vec;
+}
+
+// Reports throughput as elements handled per second and labels the rows with the chosen ISA.
+void set_items(benchmark::State& state)
+{
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetLabel(simd::isa_name(simd::detected_isa()));
+}
+
+template <typename T>
+void BM_NaiveSum(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        T total = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            total += a[i];
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_SimdSum(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::sum(a));
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_NaiveMinMax(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        T lo = a[0];
+        T hi = a[0];
+        for (std::size_t i = 1; i < a.size(); ++i) {
+            lo = a[i] < lo ? a[i] : lo;
+            hi = a[i] > hi ? a[i] : hi;
+        }
+        benchmark::DoNotOptimize(lo);
+        benchmark::DoNotOptimize(hi);
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_SimdMinMax(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::minmax(a));
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_NaiveDot(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    const auto b = make_values<T>(static_cast<std::size_t>(state.range(0)), 2);
+    for (auto _ : state) {
+        T total = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            total += a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_SimdDot(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    const auto b = make_values<T>(static_cast<std::size_t>(state.range(0)), 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::dot(a, b));
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_NaiveAxpy(benchmark::State& state)
+{
+    const auto x = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    auto y = make_values<T>(static_cast<std::size_t>(state.range(0)), 2);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            y[i] = static_cast<T>(2) * x[i] + y[i];
+        }
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_SimdAxpy(benchmark::State& state)
+{
+    const auto x = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    auto y = make_values<T>(static_cast<std::size_t>(state.range(0)), 2);
+    for (auto _ : state) {
+        simd::axpy(static_cast<T>(2), x, y);
+        benchmark::DoNotOptimize(y.data());
+        benchmark::ClobberMemory();
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_NaiveAdd(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    const auto b = make_values<T>(static_cast<std::size_t>(state.range(0)), 2);
+    Vector<T> out;
+    out.resize(a.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            out[i] = a[i] + b[i];
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_SimdAdd(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    const auto b = make_values<T>(static_cast<std::size_t>(state.range(0)), 2);
+    Vector<T> out;
+    out.resize(a.size());
+    for (auto _ : state) {
+        simd::add(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    set_items(state);
+}
+
+// Searches for a value that only appears in the last element.
+template <typename T>
+void BM_NaiveFind(benchmark::State& state)
+{
+    auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    a.back() = static_cast<T>(1000);
+    for (auto _ : state) {
+        std::size_t i = 0;
+        while (i < a.size() && a[i] != static_cast<T>(1000)) {
+            ++i;
+        }
+        benchmark::DoNotOptimize(i);
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_SimdFind(benchmark::State& state)
+{
+    auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    a.back() = static_cast<T>(1000);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::find(a, static_cast<T>(1000)));
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_NaiveCount(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        std::size_t matches = 0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            matches += a[i] == static_cast<T>(7);
+        }
+        benchmark::DoNotOptimize(matches);
+    }
+    set_items(state);
+}
+
+template <typename T>
+void BM_SimdCount(benchmark::State& state)
+{
+    const auto a = make_values<T>(static_cast<std::size_t>(state.range(0)), 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(simd::count(a, static_cast<T>(7)));
+    }
+    set_items(state);
+}
+} // namespace
+
+#define SIMD_BENCH_PAIR(op, type)                                                      \
+    BENCHMARK_TEMPLATE(BM_Naive##op, type)->RangeMultiplier(16)->Range(256, 1 << 20); \
+    BENCHMARK_TEMPLATE(BM_Simd##op, type)->RangeMultiplier(16)->Range(256, 1 << 20)
+
+SIMD_BENCH_PAIR(Sum, float);
+SIMD_BENCH_PAIR(Sum, std::int32_t);
+SIMD_BENCH_PAIR(MinMax, float);
+SIMD_BENCH_PAIR(MinMax, std::int32_t);
+SIMD_BENCH_PAIR(Dot, float);
+SIMD_BENCH_PAIR(Dot, double);
+SIMD_BENCH_PAIR(Axpy, float);
+SIMD_BENCH_PAIR(Add, float);
+SIMD_BENCH_PAIR(Find, std::int32_t);
+SIMD_BENCH_PAIR(Count, std::uint8_t);
+SIMD_BENCH_PAIR(Count, float);
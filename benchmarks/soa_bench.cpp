@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include "../SoAVector.h"
+#include "../Vector.h"
+
+// A scan that reads two of nine fields: array-of-structs pulls whole 36-byte rows through the
+// cache, the structure-of-arrays container streams only the two columns it needs.
+
+namespace {
+struct Particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float mass;
+    float charge;
+    float age;
+};
+
+using ParticleColumns = SoAVector<float, float, float, float, float, float, float, float, float>;
+
+void BM_AoSTwoFieldScan(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Vector<Particle> particles;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i % 17);
+        particles.push_back({v, v, v, v, v, v, v, v, v});
+    }
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (const Particle& particle : particles) {
+            sum += particle.x * particle.vx;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SoATwoFieldScan(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    ParticleColumns particles;
+    particles.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto v = static_cast<float>(i % 17);
+        particles.emplace_back(v, v, v, v, v, v, v, v, v);
+    }
+
+    for (auto _ : state) {
+        const auto xs = particles.column<0>();
+        const auto vxs = particles.column<3>();
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            sum += xs[i] * vxs[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+} // namespace
+
+BENCHMARK(BM_AoSTwoFieldScan)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_SoATwoFieldScan)->RangeMultiplier(16)->Range(1 << 12, 1 << 22);
@@ -0,0 +1,298 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include "../Vector.h"
+
+// Every case is registered twice, once for std::vector and once for Vector, so the two
+// rows sit next to each other in the output.
+
+namespace {
+// Cache-line sized trivially copyable payload.
+struct Payload64 {
+    std::uint64_t fields[8];
+};
+
+// Move-only handle owning one heap allocation.
+using MoveOnlyHandle = std::unique_ptr<std::uint64_t>;
+
+// Builds the i-th test value of each element type.
+template <typename T>
+T make_value(std::size_t i);
+
+template <>
+int make_value<int>(std::size_t i)
+{
+    return static_cast<int>(i);
+}
+
+template <>
+std::string make_value<std::string>(std::size_t i)
+{
+    // long enough to defeat the small string optimization
+    return std::string(32, static_cast<char>('a' + i % 26));
+}
+
+template <>
+Payload64 make_value<Payload64>(std::size_t i)
+{
+    Payload64 payload{};
+    payload.fields[0] = i;
+    return payload;
+}
+
+template <>
+MoveOnlyHandle make_value<MoveOnlyHandle>(std::size_t i)
+{
+    return std::make_unique<std::uint64_t>(i);
+}
+
+// Collapses an element to a number so the optimizer cannot drop the loop that read it.
+std::uint64_t digest(int value) { return static_cast<std::uint64_t>(value); }
+std::uint64_t digest(const std::string& value) { return value.size(); }
+std::uint64_t digest(const Payload64& value) { return value.fields[0]; }
+std::uint64_t digest(const MoveOnlyHandle& value) { return *value; }
+
+// Fills a container with count values.
+template <typename Container>
+Container make_filled(std::size_t count)
+{
+    using T = typename Container::value_type;
+    Container container;
+    container.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        container.push_back(make_value<T>(i));
+    }
+    return container;
+}
+
+// Reports throughput as elements handled per second.
+void set_items(benchmark::State& state)
+{
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Grows from empty with push_back of a temporary.
+template <typename Container>
+void BM_PushBack(benchmark::State& state)
+{
+    using T = typename Container::value_type;
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < count; ++i) {
+            container.push_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container.data());
+    }
+    set_items(state);
+}
+
+// Grows from empty constructing each element in place.
+template <typename Container>
+void BM_EmplaceBack(benchmark::State& state)
+{
+    using T = typename Container::value_type;
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        Container container;
+        for (std::size_t i = 0; i < count; ++i) {
+            container.emplace_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container.data());
+    }
+    set_items(state);
+}
+
+// Reserves the final size up front, then fills without reallocating.
+template <typename Container>
+void BM_ReserveThenFill(benchmark::State& state)
+{
+    using T = typename Container::value_type;
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        Container container;
+        container.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            container.emplace_back(make_value<T>(i));
+        }
+        benchmark::DoNotOptimize(container.data());
+    }
+    set_items(state);
+}
+
+// Deep-copies a filled container.
+template <typename Container>
+void BM_Copy(benchmark::State& state)
+{
+    const auto source = make_filled<Container>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        Container copy(source);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    set_items(state);
+}
+
+// Moves a filled container back and forth, which should cost the same at every size.
+template <typename Container>
+void BM_Move(benchmark::State& state)
+{
+    auto first = make_filled<Container>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        Container second(std::move(first));
+        benchmark::DoNotOptimize(second.data());
+        first = std::move(second);
+    }
+}
+
+// Walks every element in order with a range-for.
+template <typename Container>
+void BM_Iterate(benchmark::State& state)
+{
+    const auto container = make_filled<Container>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const auto& value : container) {
+            sum += digest(value);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_items(state);
+}
+
+// Reads elements through operator[] in a shuffled order.
+template <typename Container>
+void BM_RandomAccess(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const auto container = make_filled<Container>(count);
+    std::vector<std::size_t> order(count);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(42));
+
+    for (auto _ : state) {
+        std::uint64_t sum = 0;
+        for (const std::size_t index : order) {
+            sum += digest(container[index]);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_items(state);
+}
+
+// Grows an empty container to the target size with value-initialized elements.
+template <typename Container>
+void BM_Resize(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        Container container;
+        container.resize(count);
+        benchmark::DoNotOptimize(container.data());
+    }
+    set_items(state);
+}
+
+// Index-based dot product, the loop unchecked operator[] is meant to let the compiler vectorize.
+template <typename Container>
+void BM_DotProduct(benchmark::State& state)
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Container a;
+    Container b;
+    for (std::size_t i = 0; i < count; ++i) {
+        a.push_back(static_cast<float>(i % 7));
+        b.push_back(static_cast<float>(i % 5));
+    }
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+        for (std::size_t i = 0; i < count; ++i) {
+            sum += a[i] * b[i];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    set_items(state);
+}
+
+// Inserts one element in the middle and erases it again, shifting half the elements twice.
+template <typename Container>
+void BM_InsertEraseMiddle(benchmark::State& state)
+{
+    using T = typename Container::value_type;
+    auto container = make_filled<Container>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        auto it = container.insert(container.begin() + container.size() / 2, make_value<T>(0));
+        container.erase(it);
+        benchmark::DoNotOptimize(container.data());
+    }
+    set_items(state);
+}
+
+// Drops every other element in one compaction pass over a fresh copy.
+template <typename Container>
+void BM_EraseIf(benchmark::State& state)
+{
+    const auto source = make_filled<Container>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        state.PauseTiming();
+        Container container = source;
+        state.ResumeTiming();
+        erase_if(container, [](const auto& value) { return digest(value) % 2 == 0; });
+        benchmark::DoNotOptimize(container.data());
+    }
+    set_items(state);
+}
+
+// Deletes from the middle of an entity table at high rate: order-preserving erase against the
+// unordered swap_remove, refilling at the back to keep the size steady.
+template <bool Unordered>
+void BM_MiddleDelete(benchmark::State& state)
+{
+    auto table = make_filled<Vector<Payload64>>(static_cast<std::size_t>(state.range(0)));
+    std::size_t victim = 0;
+    for (auto _ : state) {
+        victim = (victim + 7919) % table.size();
+        if constexpr (Unordered) {
+            table.swap_remove(victim);
+        } else {
+            table.erase(table.begin() + static_cast<std::ptrdiff_t>(victim));
+        }
+        table.push_back(make_value<Payload64>(victim));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+#define VECTOR_BENCH_PAIR(bench, type)                                                   \
+    BENCHMARK_TEMPLATE(bench, std::vector<type>)->RangeMultiplier(16)->Range(16, 1 << 16); \
+    BENCHMARK_TEMPLATE(bench, Vector<type>)->RangeMultiplier(16)->Range(16, 1 << 16)
+
+#define VECTOR_BENCH_ALL_TYPES(bench)       \
+    VECTOR_BENCH_PAIR(bench, int);          \
+    VECTOR_BENCH_PAIR(bench, std::string);  \
+    VECTOR_BENCH_PAIR(bench, Payload64);    \
+    VECTOR_BENCH_PAIR(bench, MoveOnlyHandle)
+
+#define VECTOR_BENCH_COPYABLE_TYPES(bench)  \
+    VECTOR_BENCH_PAIR(bench, int);          \
+    VECTOR_BENCH_PAIR(bench, std::string);  \
+    VECTOR_BENCH_PAIR(bench, Payload64)
+
+VECTOR_BENCH_ALL_TYPES(BM_PushBack);
+VECTOR_BENCH_ALL_TYPES(BM_EmplaceBack);
+VECTOR_BENCH_ALL_TYPES(BM_ReserveThenFill);
+VECTOR_BENCH_COPYABLE_TYPES(BM_Copy);
+VECTOR_BENCH_ALL_TYPES(BM_Move);
+VECTOR_BENCH_ALL_TYPES(BM_Iterate);
+VECTOR_BENCH_ALL_TYPES(BM_RandomAccess);
+VECTOR_BENCH_ALL_TYPES(BM_Resize);
+VECTOR_BENCH_PAIR(BM_DotProduct, float);
+VECTOR_BENCH_ALL_TYPES(BM_InsertEraseMiddle);
+VECTOR_BENCH_COPYABLE_TYPES(BM_EraseIf);
+BENCHMARK_TEMPLATE(BM_MiddleDelete, false)->RangeMultiplier(16)->Range(16, 1 << 16);
+BENCHMARK_TEMPLATE(BM_MiddleDelete, true)->RangeMultiplier(16)->Range(16, 1 << 16);
@@ -0,0 +1,533 @@
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../Vector.h"
+
+// Workload-level stress harness for Vector. Where vector_bench times one operation in a steady
+// state, each scenario here replays an allocation pattern end to end. For each scenario it
+// reports:
+//   - throughput;
+//   - the p50/p99/p999/max latency of individual operations;
+//   - the peak RSS while the scenario ran;
+//   - hardware counters from perf_event_open where the kernel allows it.
+// With --json it prints the same results in a stable schema, so that runs against two versions
+// of Vector.h can be compared in CI.
+//
+//     vector_stress [--scenarios=growth,churn,threaded_churn,reserve_exact,reserve_miss]
+//                   [--quick] [--threads=N] [--growth-elements=N] [--label=TEXT] [--json=FILE|-]
+//
+// Every operation is timed with one steady_clock read, and that read is included in the
+// reported throughput. --quick scales every scenario down by 1000 for smoke runs.
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+// Log-linear histogram of nanosecond latencies with 32 buckets per power of two, so percentiles
+// are exact below 64 ns and within about 3% above.
+class LatencyHistogram
+{
+public:
+    // Counts one latency.
+    void record(std::uint64_t nanoseconds) noexcept
+    {
+        ++_buckets[bucket_of(nanoseconds)];
+        ++_count;
+        _max = std::max(_max, nanoseconds);
+    }
+
+    // Adds other's counts to this histogram.
+    void merge(const LatencyHistogram& other) noexcept
+    {
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            _buckets[i] += other._buckets[i];
+        }
+        _count += other._count;
+        _max = std::max(_max, other._max);
+    }
+
+    // Returns the smallest latency that at least fraction of the recorded operations did not exceed.
+    [[nodiscard]] std::uint64_t percentile(double fraction) const noexcept
+    {
+        if (_count == 0) return 0;
+        const auto rank = static_cast<std::uint64_t>(fraction * static_cast<double>(_count - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < bucket_count; ++i) {
+            seen += _buckets[i];
+            if (seen >= rank) return std::min(upper_bound_of(i), _max);
+        }
+        return _max;
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return _count; }
+    [[nodiscard]] std::uint64_t max() const noexcept { return _max; }
+
+private:
+    static constexpr unsigned sub_bits = 5;
+    static constexpr std::uint64_t linear_limit = std::uint64_t{2} << sub_bits;
+    static constexpr std::size_t bucket_count = linear_limit + (64 - sub_bits - 1) * (std::size_t{1} << sub_bits);
+
+    static std::size_t bucket_of(std::uint64_t value) noexcept
+    {
+        if (value < linear_limit) return static_cast<std::size_t>(value);
+        const unsigned shift = static_cast<unsigned>(std::bit_width(value)) - (sub_bits + 1);
+        const std::uint64_t top = value >> shift; // in [32, 64)
+        return static_cast<std::size_t>(linear_limit + (shift - 1) * (std::uint64_t{1} << sub_bits) + (top - (linear_limit / 2)));
+    }
+
+    static std::uint64_t upper_bound_of(std::size_t bucket) noexcept
+    {
+        if (bucket < linear_limit) return bucket;
+        const std::size_t offset = bucket - linear_limit;
+        const unsigned shift = static_cast<unsigned>(offset >> sub_bits) + 1;
+        const std::uint64_t top = (linear_limit / 2) + (offset & ((std::size_t{1} << sub_bits) - 1));
+        return ((top + 1) << shift) - 1;
+    }
+
+    std::vector<std::uint64_t> _buckets = std::vector<std::uint64_t>(bucket_count);
+    std::uint64_t _count = 0;
+    std::uint64_t _max = 0;
+};
+
+// Times consecutive operations with one clock read each.
+class OperationTimer
+{
+public:
+    explicit OperationTimer(LatencyHistogram& histogram) noexcept
+        : _histogram(histogram), _last(Clock::now()) {}
+
+    // Records the time since the previous call, or since construction.
+    void lap() noexcept
+    {
+        const Clock::time_point now = Clock::now();
+        _histogram.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - _last).count()));
+        _last = now;
+    }
+
+private:
+    LatencyHistogram& _histogram;
+    Clock::time_point _last;
+};
+
+// Hardware counters for this process and the threads it starts while they are open. Each
+// counter that the kernel refuses, e.g. under perf_event_paranoid or in a container, reads as
+// absent.
+class PerfCounters
+{
+public:
+    enum Counter { instructions, cycles, cache_misses, dtlb_misses, counter_count };
+
+    PerfCounters()
+    {
+#if defined(__linux__)
+        open(instructions, PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+        open(cycles, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+        open(cache_misses, PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+        open(dtlb_misses, PERF_TYPE_HW_CACHE,
+             PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    ~PerfCounters()
+    {
+#if defined(__linux__)
+        for (int fd : _fds) {
+            if (fd >= 0) close(fd);
+        }
+#endif
+    }
+
+    // Zeroes and starts every open counter.
+    void start() noexcept
+    {
+#if defined(__linux__)
+        for (int fd : _fds) {
+            if (fd < 0) continue;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Stops every open counter.
+    void stop() noexcept
+    {
+#if defined(__linux__)
+        for (int fd : _fds) {
+            if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+#endif
+    }
+
+    // Returns a stopped counter's value, or nothing if it could not be opened.
+    [[nodiscard]] std::optional<std::uint64_t> read(Counter counter) const noexcept
+    {
+#if defined(__linux__)
+        std::uint64_t value = 0;
+        const int fd = _fds[counter];
+        if (fd >= 0 && ::read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) return value;
+#else
+        (void)counter;
+#endif
+        return std::nullopt;
+    }
+
+private:
+#if defined(__linux__)
+    void open(Counter counter, std::uint32_t type, std::uint64_t config) noexcept
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.inherit = 1; // threads started by a scenario count too
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        _fds[counter] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+#endif
+
+    int _fds[counter_count] = {-1, -1, -1, -1};
+};
+
+// Resets the kernel's peak-RSS mark, so that the next peak_rss_bytes() covers only what follows.
+void reset_peak_rss() noexcept
+{
+#if defined(__linux__)
+    if (std::FILE* file = std::fopen("/proc/self/clear_refs", "w")) {
+        std::fputs("5", file);
+        std::fclose(file);
+    }
+#endif
+}
+
+// Returns the resident set's high-water mark in bytes, or 0 where it is unknown.
+std::uint64_t peak_rss_bytes() noexcept
+{
+#if defined(__linux__)
+    if (std::FILE* file = std::fopen("/proc/self/status", "r")) {
+        char line[256];
+        unsigned long long kilobytes = 0;
+        while (std::fgets(line, sizeof(line), file)) {
+            if (std::sscanf(line, "VmHWM: %llu kB", &kilobytes) == 1) break;
+        }
+        std::fclose(file);
+        if (kilobytes > 0) return kilobytes * 1024;
+    }
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+#endif
+    return 0;
+}
+
+struct Config {
+    std::uint64_t growth_elements = 1'000'000'000;
+    std::uint64_t churn_operations = 20'000'000;
+    std::uint64_t reserve_operations = 200'000;
+    unsigned threads = std::max(2u, std::thread::hardware_concurrency());
+    std::string label;
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t operations = 0;
+    std::uint64_t elements = 0;
+    double seconds = 0;
+    LatencyHistogram latency;
+    std::uint64_t peak_rss = 0;
+    std::optional<std::uint64_t> counters[PerfCounters::counter_count];
+};
+
+// Grows one Vector<std::uint8_t> by push_back to the configured size, so every operation runs
+// ensure_capacity() and a few run reallocate() over a buffer of up to a gigabyte.
+void run_growth(const Config& config, Result& result)
+{
+    Vector<std::uint8_t> vec;
+    OperationTimer timer(result.latency);
+    for (std::uint64_t i = 0; i < config.growth_elements; ++i) {
+        vec.push_back(static_cast<std::uint8_t>(i));
+        timer.lap();
+    }
+    result.operations = result.elements = config.growth_elements;
+}
+
+// Keeps slots live Vector<int>s and, in each operation, replaces a random one with a new vector
+// of 1 to 256 elements: one allocation per power of two it passes through plus one free.
+void churn(std::uint64_t operations, std::uint32_t seed, LatencyHistogram& latency, std::uint64_t& elements)
+{
+    constexpr std::size_t slots = 4096;
+    std::vector<Vector<int>> live(slots);
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<std::size_t> slot(0, slots - 1);
+    std::uniform_int_distribution<int> length(1, 256);
+    OperationTimer timer(latency);
+    for (std::uint64_t op = 0; op < operations; ++op) {
+        const int count = length(random);
+        Vector<int> fresh;
+        for (int i = 0; i < count; ++i) {
+            fresh.push_back(i);
+        }
+        live[slot(random)] = std::move(fresh);
+        elements += static_cast<std::uint64_t>(count);
+        timer.lap();
+    }
+}
+
+void run_churn(const Config& config, Result& result)
+{
+    churn(config.churn_operations, 1, result.latency, result.elements);
+    result.operations = config.churn_operations;
+}
+
+// Runs the churn loop on several threads at once, so allocations and frees contend inside
+// ::operator new.
+void run_threaded_churn(const Config& config, Result& result)
+{
+    const std::uint64_t per_thread = config.churn_operations / config.threads;
+    std::vector<LatencyHistogram> latencies(config.threads);
+    std::vector<std::uint64_t> elements(config.threads);
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < config.threads; ++t) {
+        workers.emplace_back([&, t] { churn(per_thread, t + 1, latencies[t], elements[t]); });
+    }
+    for (unsigned t = 0; t < config.threads; ++t) {
+        workers[t].join();
+        result.latency.merge(latencies[t]);
+        result.elements += elements[t];
+    }
+    result.operations = per_thread * config.threads;
+}
+
+// Builds vectors of 1K to 64K doubles after reserving estimate times their final length. Below
+// 1.0 the reservation runs out and the last few pushes pay one reallocate() over most of the data.
+void reserve_and_fill(const Config& config, double estimate, Result& result)
+{
+    std::mt19937 random(7);
+    std::uniform_int_distribution<std::size_t> length(1 << 10, 1 << 16);
+    OperationTimer timer(result.latency);
+    for (std::uint64_t op = 0; op < config.reserve_operations; ++op) {
+        const std::size_t count = length(random);
+        Vector<double> vec;
+        vec.reserve(static_cast<std::size_t>(static_cast<double>(count) * estimate));
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.push_back(static_cast<double>(i));
+        }
+        result.elements += count;
+        timer.lap();
+    }
+    result.operations = config.reserve_operations;
+}
+
+void run_reserve_exact(const Config& config, Result& result)
+{
+    reserve_and_fill(config, 1.0, result);
+}
+
+void run_reserve_miss(const Config& config, Result& result)
+{
+    reserve_and_fill(config, 0.9, result);
+}
+
+struct Scenario {
+    std::string_view name;
+    void (*run)(const Config&, Result&);
+};
+
+constexpr Scenario scenarios[] = {
+    {"growth", run_growth},
+    {"churn", run_churn},
+    {"threaded_churn", run_threaded_churn},
+    {"reserve_exact", run_reserve_exact},
+    {"reserve_miss", run_reserve_miss},
+};
+
+Result run(const Scenario& scenario, const Config& config)
+{
+    Result result;
+    result.name = scenario.name;
+    reset_peak_rss();
+    PerfCounters counters;
+    counters.start();
+    const Clock::time_point start = Clock::now();
+    scenario.run(config, result);
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    counters.stop();
+    for (int c = 0; c < PerfCounters::counter_count; ++c) {
+        result.counters[c] = counters.read(static_cast<PerfCounters::Counter>(c));
+    }
+    result.peak_rss = peak_rss_bytes();
+    return result;
+}
+
+// Writes a JSON string literal; labels and scenario names are the only strings emitted.
+void write_string(std::FILE* out, std::string_view text)
+{
+    std::fputc('"', out);
+    for (char c : text) {
+        if (c == '"' || c == '\\') std::fputc('\\', out);
+        if (static_cast<unsigned char>(c) >= 0x20) std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+void write_optional(std::FILE* out, const std::optional<std::uint64_t>& value)
+{
+    if (value) {
+        std::fprintf(out, "%llu", static_cast<unsigned long long>(*value));
+    } else {
+        std::fputs("null", out);
+    }
+}
+
+void write_json(std::FILE* out, const Config& config, const std::vector<Result>& results)
+{
+    std::fputs("{\n  \"harness\": \"vector_stress\",\n  \"schema_version\": 1,\n  \"label\": ", out);
+    write_string(out, config.label);
+    std::fprintf(out, ",\n  \"threads\": %u,\n  \"scenarios\": [", config.threads);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fputs(i == 0 ? "\n    {\"name\": " : ",\n    {\"name\": ", out);
+        write_string(out, r.name);
+        std::fprintf(out,
+                     ", \"operations\": %llu, \"elements\": %llu, \"seconds\": %.6f, \"operations_per_second\": %.1f,"
+                     " \"latency_ns\": {\"p50\": %llu, \"p99\": %llu, \"p999\": %llu, \"max\": %llu},"
+                     " \"peak_rss_bytes\": %llu, \"counters\": {\"instructions\": ",
+                     static_cast<unsigned long long>(r.operations), static_cast<unsigned long long>(r.elements), r.seconds,
+                     static_cast<double>(r.operations) / r.seconds,
+                     static_cast<unsigned long long>(r.latency.percentile(0.5)),
+                     static_cast<unsigned long long>(r.latency.percentile(0.99)),
+                     static_cast<unsigned long long>(r.latency.percentile(0.999)),
+                     static_cast<unsigned long long>(r.latency.max()), static_cast<unsigned long long>(r.peak_rss));
+        write_optional(out, r.counters[PerfCounters::instructions]);
+        std::fputs(", \"cycles\": ", out);
+        write_optional(out, r.counters[PerfCounters::cycles]);
+        std::fputs(", \"cache_misses\": ", out);
+        write_optional(out, r.counters[PerfCounters::cache_misses]);
+        std::fputs(", \"dtlb_misses\": ", out);
+        write_optional(out, r.counters[PerfCounters::dtlb_misses]);
+        std::fputs(", \"instructions_per_element\": ", out);
+        if (const auto& instructions = r.counters[PerfCounters::instructions]; instructions && r.elements > 0) {
+            std::fprintf(out, "%.3f", static_cast<double>(*instructions) / static_cast<double>(r.elements));
+        } else {
+            std::fputs("null", out);
+        }
+        std::fputs("}}", out);
+    }
+    std::fputs("\n  ]\n}\n", out);
+}
+
+void print_table(std::FILE* out, const std::vector<Result>& results)
+{
+    std::fprintf(out, "%-16s %14s %10s %10s %10s %12s %10s %12s\n", "scenario", "ops/s", "p50 ns", "p99 ns", "p999 ns",
+                 "max ns", "peak MiB", "instr/elem");
+    for (const Result& r : results) {
+        char per_element[32] = "n/a";
+        if (const auto& instructions = r.counters[PerfCounters::instructions]; instructions && r.elements > 0) {
+            std::snprintf(per_element, sizeof(per_element), "%.2f", static_cast<double>(*instructions) / static_cast<double>(r.elements));
+        }
+        std::fprintf(out, "%-16s %14.0f %10llu %10llu %10llu %12llu %10.1f %12s\n", r.name.c_str(),
+                     static_cast<double>(r.operations) / r.seconds,
+                     static_cast<unsigned long long>(r.latency.percentile(0.5)),
+                     static_cast<unsigned long long>(r.latency.percentile(0.99)),
+                     static_cast<unsigned long long>(r.latency.percentile(0.999)),
+                     static_cast<unsigned long long>(r.latency.max()),
+                     static_cast<double>(r.peak_rss) / (1024.0 * 1024.0), per_element);
+    }
+}
+
+// Returns the value of --name=value, or nothing if argument is a different option.
+std::optional<std::string_view> option(std::string_view argument, std::string_view name)
+{
+    if (argument.size() > name.size() + 3 && argument.starts_with("--") && argument.substr(2, name.size()) == name &&
+        argument[name.size() + 2] == '=') {
+        return argument.substr(name.size() + 3);
+    }
+    return std::nullopt;
+}
+
+std::uint64_t parse_count(std::string_view text)
+{
+    return std::strtoull(std::string(text).c_str(), nullptr, 10);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Config config;
+    std::string selected;
+    std::string json_path;
+    bool quick = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        if (argument == "--quick") {
+            quick = true;
+        } else if (auto value = option(argument, "scenarios")) {
+            selected = *value;
+        } else if (auto value = option(argument, "threads")) {
+            config.threads = std::max<unsigned>(1, static_cast<unsigned>(parse_count(*value)));
+        } else if (auto value = option(argument, "growth-elements")) {
+            config.growth_elements = parse_count(*value);
+        } else if (auto value = option(argument, "label")) {
+            config.label = *value;
+        } else if (auto value = option(argument, "json")) {
+            json_path = *value;
+        } else {
+            std::fprintf(stderr, "unknown argument %s\n", argv[i]);
+            return 2;
+        }
+    }
+    if (quick) {
+        config.growth_elements /= 1000;
+        config.churn_operations /= 1000;
+        config.reserve_operations /= 1000;
+    }
+
+    std::vector<Result> results;
+    for (const Scenario& scenario : scenarios) {
+        if (!selected.empty() && ("," + selected + ",").find("," + std::string(scenario.name) + ",") == std::string::npos) {
+            continue;
+        }
+        results.push_back(run(scenario, config));
+    }
+    if (results.empty()) {
+        std::fprintf(stderr, "no scenario matches --scenarios=%s\n", selected.c_str());
+        return 2;
+    }
+
+    if (json_path == "-") {
+        write_json(stdout, config, results);
+        return 0;
+    }
+    print_table(stdout, results);
+    if (!json_path.empty()) {
+        std::FILE* out = std::fopen(json_path.c_str(), "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "cannot write %s\n", json_path.c_str());
+            return 1;
+        }
+        write_json(out, config, results);
+        std::fclose(out);
+    }
+    return 0;
+}
@@ -0,0 +1,470 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "../Allocator.h"
+#include "../Vector.h"
+
+// MonotonicArena
+TEST(MonotonicArenaTest, AllocationsAreAlignedAndDistinct)
+{
+    MonotonicArena arena(256);
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(16, 16);
+    void* c = arena.allocate(8, 8);
+
+    EXPECT_NE(a, b);
+    EXPECT_NE(b, c);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 16, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(c) % 8, 0u);
+    EXPECT_EQ(arena.bytes_allocated(), 27u);
+}
+
+TEST(MonotonicArenaTest, OversizedRequestsGetTheirOwnChunk)
+{
+    MonotonicArena arena(128);
+
+    void* big = arena.allocate(4096);
+    ASSERT_NE(big, nullptr);
+    EXPECT_GE(arena.bytes_reserved(), 4096u);
+}
+
+TEST(MonotonicArenaTest, ReleaseRewindsToInitialBuffer)
+{
+    alignas(std::max_align_t) std::byte buffer[64];
+    MonotonicArena arena(buffer, sizeof(buffer));
+
+    void* first = arena.allocate(32);
+    EXPECT_EQ(first, buffer);
+    EXPECT_EQ(arena.bytes_reserved(), 0u);
+
+    arena.allocate(128); // spills to the heap
+    EXPECT_GT(arena.bytes_reserved(), 0u);
+
+    arena.release();
+    EXPECT_EQ(arena.bytes_reserved(), 0u);
+    EXPECT_EQ(arena.bytes_allocated(), 0u);
+    EXPECT_EQ(arena.allocate(32), buffer);
+}
+
+TEST(MonotonicArenaTest, VectorGrowsInsideArena)
+{
+    MonotonicArena arena;
+    Vector<int, ArenaAllocator<int>> vec{ArenaAllocator<int>(arena)};
+
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(vec.size(), 100u);
+    EXPECT_EQ(vec[99], 99);
+    EXPECT_GE(arena.bytes_allocated(), 100 * sizeof(int));
+    EXPECT_EQ(vec.get_allocator().arena(), &arena);
+}
+
+TEST(MonotonicArenaTest, AssignmentAcrossArenasKeepsTargetArena)
+{
+    MonotonicArena first;
+    MonotonicArena second;
+    using StringVector = Vector<std::string, ArenaAllocator<std::string>>;
+
+    StringVector source{ArenaAllocator<std::string>(first)};
+    source.emplace_back("alpha");
+    source.emplace_back("beta");
+
+    StringVector target{ArenaAllocator<std::string>(second)};
+    target = std::move(source);
+
+    EXPECT_EQ(target.get_allocator().arena(), &second);
+    ASSERT_EQ(target.size(), 2u);
+    EXPECT_EQ(target[0], "alpha");
+    EXPECT_EQ(target[1], "beta");
+
+    StringVector copy{ArenaAllocator<std::string>(first)};
+    copy = target;
+    EXPECT_EQ(copy.get_allocator().arena(), &first);
+    EXPECT_EQ(copy[1], "beta");
+}
+
+TEST(MonotonicArenaTest, MoveBetweenSameArenaStealsStorage)
+{
+    MonotonicArena arena;
+    Vector<int, ArenaAllocator<int>> source{ArenaAllocator<int>(arena)};
+    source.push_back(1);
+    source.push_back(2);
+    auto* data = source.data();
+
+    Vector<int, ArenaAllocator<int>> target{ArenaAllocator<int>(arena)};
+    target = std::move(source);
+
+    EXPECT_EQ(target.data(), data);
+    EXPECT_EQ(source.size(), 0u);
+}
+
+// FixedPool
+TEST(FixedPoolTest, FreedBlocksAreReused)
+{
+    FixedPool pool(48, 4);
+
+    void* a = pool.allocate();
+    void* b = pool.allocate();
+    EXPECT_NE(a, b);
+    EXPECT_GE(pool.block_size(), 48u);
+
+    pool.deallocate(a);
+    EXPECT_EQ(pool.allocate(), a);
+}
+
+TEST(FixedPoolTest, RefillsAcrossChunks)
+{
+    FixedPool pool(16, 2);
+
+    void* blocks[5];
+    for (auto& block : blocks) {
+        block = pool.allocate();
+    }
+    for (int i = 0; i < 5; ++i) {
+        for (int j = i + 1; j < 5; ++j) {
+            EXPECT_NE(blocks[i], blocks[j]);
+        }
+    }
+}
+
+TEST(FixedPoolTest, VectorReservedToBlockSizeUsesPool)
+{
+    FixedPool pool(16 * sizeof(int));
+    using PoolVector = Vector<int, PoolAllocator<int>>;
+
+    void* recycled = nullptr;
+    {
+        PoolVector vec{PoolAllocator<int>(pool)};
+        vec.reserve(16);
+        recycled = vec.data();
+        for (int i = 0; i < 16; ++i) {
+            vec.push_back(i);
+        }
+        EXPECT_EQ(vec.data(), recycled);
+    }
+
+    PoolVector next{PoolAllocator<int>(pool)};
+    next.reserve(8);
+    EXPECT_EQ(next.data(), recycled);
+}
+
+TEST(FixedPoolTest, OversizedRequestsFallBackToHeap)
+{
+    FixedPool pool(4 * sizeof(int));
+    Vector<int, PoolAllocator<int>> vec{PoolAllocator<int>(pool)};
+
+    for (int i = 0; i < 64; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec.size(), 64u);
+    EXPECT_EQ(vec[63], 63);
+}
+
+// ReallocAllocator
+TEST(ReallocAllocatorTest, VectorGrowthPreservesContents)
+{
+    Vector<int, ReallocAllocator<int>> vec;
+    for (int i = 0; i < 10000; ++i) {
+        vec.push_back(i);
+    }
+
+    ASSERT_EQ(vec.size(), 10000u);
+    for (int i = 0; i < 10000; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+}
+
+TEST(ReallocAllocatorTest, NonRelocatableElementsStillMoveConstruct)
+{
+    Vector<std::string, ReallocAllocator<std::string>> vec;
+    for (int i = 0; i < 64; ++i) {
+        vec.push_back(std::string(32, static_cast<char>('a' + i % 26)));
+    }
+
+    EXPECT_EQ(vec[63], std::string(32, static_cast<char>('a' + 63 % 26)));
+}
+
+TEST(ReallocAllocatorTest, ShrinkToFitReallocatesInPlace)
+{
+    Vector<int, ReallocAllocator<int>> vec;
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+    vec.resize(10);
+
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+}
+
+// AlignedAllocator
+TEST(AlignedAllocatorTest, VectorDataStaysAlignedThroughGrowthAndCopy)
+{
+    using Aligned = Vector<float, AlignedAllocator<float, 64>>;
+    static_assert(Aligned::alignment == 64);
+    static_assert(Vector<float>::alignment == alignof(float));
+
+    Aligned vec;
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(static_cast<float>(i));
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % 64, 0u);
+    }
+
+    Aligned copy(vec);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(copy.data()) % 64, 0u);
+    EXPECT_EQ(copy[999], 999.0f);
+}
+
+TEST(AlignedAllocatorTest, CapacityCoversTheAlignmentPadding)
+{
+    Vector<float, AlignedAllocator<float, 64>> vec;
+    vec.reserve(3);
+    EXPECT_EQ(vec.capacity(), 16u); // one whole 64-byte line of floats
+
+    // an element size that does not divide the alignment still round-trips through deallocate
+    struct Triple { char bytes[12]; };
+    AlignedAllocator<Triple, 64> alloc;
+    const auto block = alloc.allocate_at_least(1);
+    EXPECT_EQ(block.count, 5u);
+    alloc.deallocate(block.ptr, block.count);
+}
+
+TEST(AlignedAllocatorTest, RebindKeepsAlignment)
+{
+    using Rebound = std::allocator_traits<AlignedAllocator<char, 128>>::rebind_alloc<double>;
+    static_assert(std::is_same_v<Rebound, AlignedAllocator<double, 128>>);
+    static_assert(AlignedAllocator<char, 1>::alignment == 1);
+    static_assert(AlignedAllocator<double, 1>::alignment == alignof(double));
+}
+
+#if defined(__linux__)
+// MremapAllocator
+TEST(MremapAllocatorTest, GrowthAcrossMapThresholdPreservesContents)
+{
+    using Alloc = MremapAllocator<std::uint64_t, 64 * 1024>;
+    Vector<std::uint64_t, Alloc> vec;
+
+    constexpr std::uint64_t count = 256 * 1024; // crosses the threshold and keeps doubling past it
+    for (std::uint64_t i = 0; i < count; ++i) {
+        vec.push_back(i * 3);
+    }
+
+    ASSERT_EQ(vec.size(), count);
+    for (std::uint64_t i = 0; i < count; i += 997) {
+        EXPECT_EQ(vec[i], i * 3);
+    }
+    EXPECT_EQ(vec.back(), (count - 1) * 3);
+}
+
+TEST(MremapAllocatorTest, ReallocateShrinksBackBelowThreshold)
+{
+    using Alloc = MremapAllocator<char, 4096>;
+    static_assert(std::allocator_traits<Alloc>::is_always_equal::value);
+    Alloc alloc;
+
+    char* block = alloc.allocate(8192);
+    std::memset(block, 'x', 8192);
+    block = alloc.reallocate(block, 8192, 16384);
+    EXPECT_EQ(block[8191], 'x');
+
+    block = alloc.reallocate(block, 16384, 100);
+    EXPECT_EQ(block[99], 'x');
+    alloc.deallocate(block, 100);
+}
+
+// HugePageAllocator
+TEST(HugePageAllocatorTest, LargeBlocksAreWholeAlignedHugePages)
+{
+    using Alloc = HugePageAllocator<std::uint64_t>;
+    Alloc alloc;
+    constexpr std::size_t huge = Alloc::huge_page_size;
+
+    auto block = alloc.allocate_at_least(huge / sizeof(std::uint64_t) + 1);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block.ptr) % huge, 0u);
+    EXPECT_EQ(block.count * sizeof(std::uint64_t), 2 * huge);
+    block.ptr[block.count - 1] = 7;
+    alloc.deallocate(block.ptr, block.count);
+
+    // small blocks stay on malloc
+    std::uint64_t* small = alloc.allocate(16);
+    small[15] = 1;
+    alloc.deallocate(small, 16);
+}
+
+TEST(HugePageAllocatorTest, VectorGrowsAndShrinksOnHugePages)
+{
+    Vector<std::uint32_t, HugePageAllocator<std::uint32_t>> vec;
+    constexpr std::uint32_t count = 3 * 1024 * 1024;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec.capacity() * sizeof(std::uint32_t) % HugePageAllocator<std::uint32_t>::huge_page_size, 0u);
+
+    vec.resize(1000);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 1000u);
+    EXPECT_EQ(vec[999], 999u);
+}
+
+// NumaAllocator
+namespace {
+// Returns the kernel's policy mode for the page holding address, or -1 without NUMA syscalls.
+int policy_at(const void* address, unsigned long& nodes)
+{
+    int mode = -1;
+    nodes = 0;
+    if (::syscall(SYS_get_mempolicy, &mode, &nodes, sizeof(nodes) * 8 + 1, address, MPOL_F_ADDR) != 0) return -1;
+    return mode;
+}
+} // namespace
+
+TEST(NumaAllocatorTest, MappedBlocksCarryThePolicyThroughGrowth)
+{
+    using Alloc = NumaAllocator<std::uint64_t, 64 * 1024>;
+    Vector<std::uint64_t, Alloc> vec{Alloc(NumaPolicy::interleave())};
+    constexpr std::uint64_t count = 256 * 1024; // remaps several times past the threshold
+    for (std::uint64_t i = 0; i < count; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec[count / 2], count / 2);
+    EXPECT_EQ(vec.back(), count - 1);
+
+    unsigned long nodes = 0;
+    const int mode = policy_at(vec.data() + count - 1, nodes);
+    if (mode < 0) GTEST_SKIP() << "get_mempolicy unavailable";
+    EXPECT_EQ(mode, MPOL_INTERLEAVE);
+    EXPECT_EQ(nodes, NumaPolicy::online_nodes());
+}
+
+TEST(NumaAllocatorTest, BlocksCrossingIntoMappedMemoryAreCopiedOntoThePolicyNodes)
+{
+    // bind to the highest online node, which the copying thread is least likely to run on
+    const unsigned long online = NumaPolicy::online_nodes();
+    const unsigned node = static_cast<unsigned>(std::bit_width(online) - 1);
+    using Alloc = NumaAllocator<char, 64 * 1024>;
+    Alloc alloc(NumaPolicy::bind(node));
+
+    constexpr std::size_t small = 32 * 1024;
+    constexpr std::size_t large = 1 << 20;
+    char* block = alloc.allocate(small);
+    std::memset(block, 'x', small);
+    block = alloc.reallocate(block, small, large); // malloc to mapping: every copied page is new
+
+    int page_node = -1;
+    const long status = ::syscall(SYS_get_mempolicy, &page_node, nullptr, 0, block, MPOL_F_NODE | MPOL_F_ADDR);
+    const bool kept = block[0] == 'x' && block[small - 1] == 'x';
+    alloc.deallocate(block, large);
+
+    EXPECT_TRUE(kept);
+    if (status != 0) GTEST_SKIP() << "get_mempolicy unavailable";
+    EXPECT_EQ(page_node, static_cast<int>(node));
+}
+
+TEST(NumaAllocatorTest, BindPolicyAppliesToLargeBlocksOnly)
+{
+    using Alloc = NumaAllocator<char, 64 * 1024>;
+    Alloc alloc(NumaPolicy::bind(0));
+    EXPECT_EQ(std::allocator_traits<Alloc>::rebind_alloc<int>(alloc).policy(), NumaPolicy::bind(0));
+
+    char* large = alloc.allocate(1 << 20);
+    std::memset(large, 1, 1 << 20);
+    char* small = alloc.allocate(64);
+    unsigned long nodes = 0;
+    const int large_mode = policy_at(large, nodes);
+    const unsigned long large_nodes = nodes;
+    const int small_mode = policy_at(small, nodes);
+    alloc.deallocate(small, 64);
+    alloc.deallocate(large, 1 << 20);
+
+    if (large_mode < 0) GTEST_SKIP() << "get_mempolicy unavailable";
+    EXPECT_EQ(large_mode, MPOL_BIND);
+    EXPECT_EQ(large_nodes, 1UL);
+    EXPECT_EQ(small_mode, MPOL_DEFAULT);
+}
+
+TEST(NumaAllocatorTest, PolicyTravelsWithTheContainer)
+{
+    using Alloc = NumaAllocator<int>;
+    EXPECT_NE(Alloc(NumaPolicy::bind(0)), Alloc(NumaPolicy::interleave()));
+    EXPECT_EQ(Alloc(NumaPolicy::bind(0)), NumaAllocator<char>(NumaPolicy::bind(0)));
+    EXPECT_THROW(NumaPolicy::bind(NumaPolicy::max_nodes), std::out_of_range);
+
+    Vector<int, Alloc> bound{Alloc(NumaPolicy::bind(0))};
+    bound.push_back(1);
+    Vector<int, Alloc> spread;
+    spread = std::move(bound);
+    EXPECT_EQ(spread.get_allocator().policy(), NumaPolicy::bind(0));
+    EXPECT_EQ(spread[0], 1);
+}
+#endif
+
+// RecyclingAllocator
+TEST(RecyclingAllocatorTest, FreedBufferIsReusedByTheNextVectorOfItsClass)
+{
+    const int* recycled = nullptr;
+    {
+        Vector<int, RecyclingAllocator<int>> vec;
+        vec.reserve(100);
+        EXPECT_EQ(vec.capacity(), 128u); // the whole 512-byte class
+        recycled = vec.data();
+    }
+    ThreadBufferCache& cache = *ThreadBufferCache::local();
+    const std::size_t hits = cache.hits();
+
+    Vector<int, RecyclingAllocator<int>> next;
+    next.reserve(120);
+    EXPECT_EQ(next.data(), recycled);
+    EXPECT_EQ(cache.hits(), hits + 1);
+
+    Vector<double, RecyclingAllocator<double>> rebound; // same bytes, another element type
+    next = Vector<int, RecyclingAllocator<int>>();
+    rebound.reserve(64);
+    EXPECT_EQ(static_cast<const void*>(rebound.data()), static_cast<const void*>(recycled));
+}
+
+TEST(RecyclingAllocatorTest, CachesAreBoundedAndPerThread)
+{
+    ThreadBufferCache& cache = *ThreadBufferCache::local();
+    cache.trim();
+    RecyclingAllocator<char> alloc;
+
+    char* blocks[ThreadBufferCache::blocks_per_class + 2];
+    for (char*& block : blocks) {
+        block = alloc.allocate(1000);
+    }
+    for (char* block : blocks) {
+        alloc.deallocate(block, 1000); // the last two overflow to the heap
+    }
+    const std::size_t hits = cache.hits();
+    for (char*& block : blocks) {
+        block = alloc.allocate(1024);
+    }
+    EXPECT_EQ(cache.hits(), hits + ThreadBufferCache::blocks_per_class);
+
+    // a block freed on another thread joins that thread's cache, not this one
+    std::thread([&] { alloc.deallocate(blocks[0], 1024); }).join();
+    EXPECT_EQ(cache.hits(), hits + ThreadBufferCache::blocks_per_class);
+    for (std::size_t i = 1; i < std::size(blocks); ++i) {
+        alloc.deallocate(blocks[i], 1024);
+    }
+
+    // blocks above the largest class bypass the cache
+    const std::size_t misses = cache.misses();
+    char* huge = alloc.allocate(ThreadBufferCache::max_class_bytes + 1);
+    alloc.deallocate(huge, ThreadBufferCache::max_class_bytes + 1);
+    huge = alloc.allocate(ThreadBufferCache::max_class_bytes + 1);
+    alloc.deallocate(huge, ThreadBufferCache::max_class_bytes + 1);
+    EXPECT_EQ(cache.misses(), misses + 2);
+    cache.trim();
+}
+
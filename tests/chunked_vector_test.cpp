@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include "../Allocator.h"
+#include "../ChunkedVector.h"
+
+namespace {
+using SmallChunks = ChunkedVector<int, std::allocator<int>, 8>;
+
+static_assert(std::random_access_iterator<SmallChunks::iterator>);
+static_assert(std::random_access_iterator<SmallChunks::const_iterator>);
+static_assert(std::ranges::random_access_range<SmallChunks>);
+
+TEST(ChunkedVectorTest, PushBackFillsChunksInOrder) {
+    SmallChunks vec;
+    for (int i = 0; i < 20; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(vec.size(), 20u);
+    EXPECT_EQ(vec.chunk_count(), 3u);
+    EXPECT_EQ(vec.capacity(), 24u);
+    EXPECT_EQ(vec.front(), 0);
+    EXPECT_EQ(vec.back(), 19);
+    for (int i = 0; i < 20; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+    EXPECT_THROW(vec.at(20), std::out_of_range);
+}
+
+TEST(ChunkedVectorTest, ReferencesSurviveGrowth) {
+    SmallChunks vec;
+    int& first = vec.emplace_back(42);
+    const int* address = &first;
+    auto it = vec.begin();
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(&vec[0], address);
+    EXPECT_EQ(first, 42);
+    EXPECT_EQ(*it, 42);
+}
+
+TEST(ChunkedVectorTest, PopBackKeepsChunksUntilShrink) {
+    SmallChunks vec;
+    for (int i = 0; i < 17; ++i) {
+        vec.push_back(i);
+    }
+    for (int i = 0; i < 10; ++i) {
+        vec.pop_back();
+    }
+
+    EXPECT_EQ(vec.size(), 7u);
+    EXPECT_EQ(vec.chunk_count(), 3u);
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.chunk_count(), 1u);
+    EXPECT_EQ(vec.back(), 6);
+
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    vec.pop_back(); // no-op on an empty vector
+    EXPECT_EQ(vec.size(), 0u);
+    vec.reserve(30);
+    EXPECT_EQ(vec.chunk_count(), 4u);
+}
+
+TEST(ChunkedVectorTest, IteratorsWorkWithAlgorithms) {
+    SmallChunks vec;
+    for (int i = 0; i < 50; ++i) {
+        vec.push_back(49 - i);
+    }
+
+    std::sort(vec.begin(), vec.end());
+    EXPECT_TRUE(std::is_sorted(vec.cbegin(), vec.cend()));
+    EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0), 49 * 50 / 2);
+    EXPECT_EQ(vec.end() - vec.begin(), 50);
+    EXPECT_EQ(*(vec.begin() + 17), 17);
+    EXPECT_EQ(std::ranges::distance(vec | std::views::filter([](int v) { return v % 2 == 0; })), 25);
+}
+
+TEST(ChunkedVectorTest, CopyMoveAndSwap) {
+    ChunkedVector<std::string, std::allocator<std::string>, 4> source = {"a", "b", "c", "d", "e"};
+    auto copy = source;
+    EXPECT_EQ(copy, source);
+
+    auto moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.size(), 5u);
+    EXPECT_EQ(moved[4], "e");
+
+    decltype(source) other = {"x"};
+    other.swap(moved);
+    EXPECT_EQ(other.size(), 5u);
+    EXPECT_EQ(moved.size(), 1u);
+
+    other = moved;
+    EXPECT_EQ(other, moved);
+    other = std::move(source);
+    EXPECT_EQ(other.back(), "e");
+}
+
+TEST(ChunkedVectorTest, ThrowingConstructorLeavesContainerUnchanged) {
+    struct Explosive {
+        explicit Explosive(bool boom)
+        {
+            if (boom) throw std::runtime_error("boom");
+        }
+    };
+
+    ChunkedVector<Explosive, std::allocator<Explosive>, 2> vec;
+    vec.emplace_back(false);
+    vec.emplace_back(false);
+    EXPECT_THROW(vec.emplace_back(true), std::runtime_error);
+    EXPECT_EQ(vec.size(), 2u);
+    vec.emplace_back(false);
+    EXPECT_EQ(vec.size(), 3u);
+}
+
+TEST(ChunkedVectorTest, AllocatesChunksFromAllocator) {
+    ChunkedVector<double, AlignedAllocator<double, 64>> vec;
+    for (int i = 0; i < 2000; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(vec.chunk_size, 512u);
+    for (std::size_t chunk = 0; chunk < vec.chunk_count(); ++chunk) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&vec[chunk * vec.chunk_size]) % 64, 0u);
+    }
+}
+} // namespace
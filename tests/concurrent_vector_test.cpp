@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../ConcurrentVector.h"
+
+namespace {
+constexpr int thread_count = 4;
+constexpr int per_thread = 5000;
+
+// Runs body(thread_index) on thread_count threads and joins them.
+template <typename Body>
+void run_threads(Body body)
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; ++t) {
+        threads.emplace_back(body, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(ConcurrentVectorTest, ConcurrentPushBackKeepsEveryElement) {
+    ConcurrentVector<std::uint64_t> vec;
+    run_threads([&](int t) {
+        for (int i = 0; i < per_thread; ++i) {
+            vec.push_back(static_cast<std::uint64_t>(t) * per_thread + i);
+        }
+    });
+
+    ASSERT_EQ(vec.size(), static_cast<std::size_t>(thread_count * per_thread));
+    std::vector<std::uint64_t> seen;
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        seen.push_back(vec[i]);
+    }
+    std::sort(seen.begin(), seen.end());
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+        EXPECT_EQ(seen[i], i);
+    }
+}
+
+TEST(ConcurrentVectorTest, ReturnedIndicesAndReferencesStayValid) {
+    ConcurrentVector<std::string> vec;
+    const std::size_t first = vec.emplace_back(3, 'a');
+    const std::string* address = &vec[first];
+
+    std::vector<std::vector<std::size_t>> indices(thread_count);
+    run_threads([&](int t) {
+        for (int i = 0; i < per_thread; ++i) {
+            indices[t].push_back(vec.push_back(std::to_string(t * per_thread + i)));
+        }
+    });
+
+    EXPECT_EQ(&vec[first], address);
+    EXPECT_EQ(*address, "aaa");
+    for (int t = 0; t < thread_count; ++t) {
+        for (int i = 0; i < per_thread; ++i) {
+            EXPECT_EQ(vec[indices[t][i]], std::to_string(t * per_thread + i));
+        }
+    }
+}
+
+TEST(ConcurrentVectorTest, ReadersSeePublishedElementsDuringGrowth) {
+    ConcurrentVector<int> vec;
+    std::atomic<std::size_t> published{0};
+    std::atomic<bool> mismatch{false};
+
+    std::thread reader([&] {
+        std::size_t checked = 0;
+        while (checked < static_cast<std::size_t>(per_thread)) {
+            const std::size_t limit = published.load(std::memory_order_acquire);
+            for (; checked < limit; ++checked) {
+                if (vec[checked] != static_cast<int>(checked)) mismatch = true;
+            }
+        }
+    });
+    for (int i = 0; i < per_thread; ++i) {
+        vec.push_back(i);
+        published.store(static_cast<std::size_t>(i) + 1, std::memory_order_release);
+    }
+    reader.join();
+
+    EXPECT_FALSE(mismatch);
+}
+
+TEST(ConcurrentVectorTest, GrowByClaimsContiguousRuns) {
+    ConcurrentVector<int> vec;
+    constexpr std::size_t run = 300; // spans several segments
+    std::vector<std::size_t> starts(thread_count);
+    run_threads([&](int t) {
+        starts[t] = vec.grow_by(run, t + 1);
+    });
+
+    ASSERT_EQ(vec.size(), run * thread_count);
+    for (int t = 0; t < thread_count; ++t) {
+        for (std::size_t i = 0; i < run; ++i) {
+            EXPECT_EQ(vec[starts[t] + i], t + 1);
+        }
+    }
+
+    const std::size_t zeros = vec.grow_by(5);
+    EXPECT_EQ(vec.at(zeros + 4), 0);
+    EXPECT_THROW(vec.at(vec.size()), std::out_of_range);
+}
+
+TEST(ConcurrentVectorTest, CompactProducesContiguousVector) {
+    ConcurrentVector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 2000; ++i) {
+        vec.emplace_back(std::make_unique<int>(i));
+    }
+
+    Vector<std::unique_ptr<int>> flat = vec.compact();
+    EXPECT_TRUE(vec.empty());
+    ASSERT_EQ(flat.size(), 2000u);
+    for (int i = 0; i < 2000; ++i) {
+        EXPECT_EQ(*flat[i], i);
+    }
+
+    vec.emplace_back(std::make_unique<int>(7));
+    EXPECT_EQ(*vec[0], 7);
+}
+
+TEST(ConcurrentVectorTest, ToVectorCopiesInIndexOrder) {
+    ConcurrentVector<double> vec;
+    for (int i = 0; i < 1500; ++i) {
+        vec.push_back(i * 0.5);
+    }
+
+    const Vector<double> copy = vec.to_vector();
+    ASSERT_EQ(copy.size(), vec.size());
+    for (std::size_t i = 0; i < copy.size(); ++i) {
+        EXPECT_EQ(copy[i], vec[i]);
+    }
+
+    std::size_t visited = 0;
+    vec.for_each_segment([&](std::span<const double> segment) { visited += segment.size(); });
+    EXPECT_EQ(visited, vec.size());
+}
+
+struct ThrowingConstruction {
+    explicit ThrowingConstruction(int value)
+        : value(value)
+    {
+        if (value < 0) throw std::invalid_argument("negative");
+    }
+    ThrowingConstruction(ThrowingConstruction&&) noexcept = default;
+
+    int value;
+};
+
+TEST(ConcurrentVectorTest, ThrowingConstructorClaimsNoSlot) {
+    ConcurrentVector<ThrowingConstruction> vec;
+    vec.emplace_back(1);
+    EXPECT_THROW(vec.emplace_back(-1), std::invalid_argument);
+    vec.emplace_back(2);
+
+    ASSERT_EQ(vec.size(), 2u);
+    EXPECT_EQ(vec[1].value, 2);
+}
+} // namespace
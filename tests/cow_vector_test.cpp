@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "../CowVector.h"
+
+namespace {
+TEST(CowVectorTest, CopiesShareOneBuffer)
+{
+    CowVector<std::string> original{"a", "b", "c"};
+    const CowVector<std::string> copy = original;
+
+    EXPECT_EQ(std::as_const(original).data(), copy.data());
+    EXPECT_EQ(copy.use_count(), 2);
+    EXPECT_EQ(copy[1], "b");
+    EXPECT_EQ(copy.at(2), "c");
+    EXPECT_THROW(copy.at(3), std::out_of_range);
+    EXPECT_EQ(copy, original);
+}
+
+TEST(CowVectorTest, FirstWriteDetachesAndLeavesOtherCopiesAlone)
+{
+    CowVector<std::string> original{"a", "b", "c"};
+    CowVector<std::string> copy = original;
+    const std::string* shared = std::as_const(original).data();
+
+    copy.push_back("d");
+    EXPECT_NE(std::as_const(copy).data(), shared);
+    EXPECT_EQ(std::as_const(original).data(), shared);
+    EXPECT_EQ(original.use_count(), 1);
+    EXPECT_EQ(copy.use_count(), 1);
+    EXPECT_EQ(original, (CowVector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(copy, (CowVector<std::string>{"a", "b", "c", "d"}));
+
+    // the sole owner writes in place
+    original[0] = "z";
+    EXPECT_EQ(std::as_const(original).data(), shared);
+    EXPECT_EQ(copy.front(), "a");
+}
+
+TEST(CowVectorTest, EditsThroughIteratorsIntoTheSharedBuffer)
+{
+    CowVector<int> original{1, 2, 4, 5};
+    CowVector<int> copy = original;
+
+    auto it = copy.insert(copy.cbegin() + 2, 3); // cbegin() still points into the shared buffer
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(copy, (CowVector<int>{1, 2, 3, 4, 5}));
+
+    CowVector<int> other = original;
+    other.erase(other.cbegin(), other.cbegin() + 2);
+    EXPECT_EQ(other, (CowVector<int>{4, 5}));
+    EXPECT_EQ(original, (CowVector<int>{1, 2, 4, 5}));
+
+    CowVector<int> third = original;
+    third.clear(); // drops the reference instead of copying
+    EXPECT_TRUE(third.empty());
+    EXPECT_EQ(third.use_count(), 0);
+    EXPECT_EQ(original.size(), 4u);
+}
+
+TEST(CowVectorTest, AdoptsVectorWithoutCopying)
+{
+    Vector<std::string> built{"configuration"};
+    const std::string* element = built.data();
+
+    CowVector<std::string> frozen(std::move(built));
+    EXPECT_EQ(std::as_const(frozen).data(), element);
+    EXPECT_EQ(frozen.to_vector()[0], "configuration");
+    frozen.emplace_back(3, 'x');
+    EXPECT_EQ(frozen.back(), "xxx");
+    frozen.pop_back();
+    EXPECT_EQ(frozen.size(), 1u);
+}
+
+TEST(CowVectorTest, AtomicSlotPublishesSnapshotsToReaders)
+{
+    AtomicCowVector<int> slot(CowVector<int>{0});
+    constexpr int versions = 200;
+    std::atomic<bool> torn{false};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                const CowVector<int> snapshot = slot.load();
+                // every published version v holds v + 1 copies of v
+                if (snapshot.size() != static_cast<std::size_t>(snapshot.front()) + 1) torn = true;
+                for (int value : snapshot) {
+                    if (value != snapshot.front()) torn = true;
+                }
+            }
+        });
+    }
+
+    CowVector<int> next = slot.load();
+    for (int v = 1; v < versions; ++v) {
+        next = CowVector<int>();
+        for (int i = 0; i <= v; ++i) {
+            next.push_back(v);
+        }
+        slot.store(next);
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_FALSE(torn);
+    EXPECT_EQ(slot.load().size(), static_cast<std::size_t>(versions));
+    const CowVector<int> previous = slot.exchange(CowVector<int>{});
+    EXPECT_EQ(previous.front(), versions - 1);
+    EXPECT_TRUE(slot.load().empty());
+}
+} // namespace
@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include "../FlatMap.h"
+
+namespace {
+static_assert(std::random_access_iterator<FlatMap<int, int>::iterator>);
+static_assert(std::contiguous_iterator<FlatSet<int>::iterator>);
+
+template <typename T>
+std::vector<T> to_std(const Vector<T>& column)
+{
+    return std::vector<T>(column.begin(), column.end());
+}
+
+TEST(FlatSetTest, KeepsKeysSortedAndUnique)
+{
+    FlatSet<int> set{5, 1, 4, 1, 3};
+    EXPECT_EQ(set.size(), 4u);
+    EXPECT_EQ(to_std(set.keys()), (std::vector<int>{1, 3, 4, 5}));
+
+    EXPECT_TRUE(set.insert(2).second);
+    EXPECT_FALSE(set.insert(4).second);
+    EXPECT_EQ(*set.insert(0).first, 0);
+    EXPECT_EQ(to_std(set.keys()), (std::vector<int>{0, 1, 2, 3, 4, 5}));
+
+    EXPECT_TRUE(set.contains(3));
+    EXPECT_EQ(set.count(7), 0u);
+    EXPECT_EQ(set.find(7), set.end());
+    EXPECT_EQ(*set.lower_bound(6 - 3), 3);
+    EXPECT_EQ(set.upper_bound(5), set.end());
+
+    EXPECT_EQ(set.erase(3), 1u);
+    EXPECT_EQ(set.erase(3), 0u);
+    EXPECT_EQ(*set.erase(set.begin()), 1);
+    EXPECT_EQ(set, (FlatSet<int>{1, 2, 4, 5}));
+}
+
+TEST(FlatSetTest, HonoursCustomOrdering)
+{
+    FlatSet<std::string, std::greater<>> set{"pear", "apple", "fig"};
+    EXPECT_EQ(to_std(set.keys()), (std::vector<std::string>{"pear", "fig", "apple"}));
+    EXPECT_EQ(*set.lower_bound("grape"), "fig");
+
+    set.build_lookup_index();
+    EXPECT_EQ(*set.lower_bound("grape"), "fig");
+    EXPECT_TRUE(set.contains("apple"));
+    EXPECT_FALSE(set.contains("kiwi"));
+}
+
+TEST(FlatMapTest, InsertsLooksUpAndErases)
+{
+    FlatMap<int, std::string> map;
+    EXPECT_TRUE(map.insert({2, "two"}).second);
+    EXPECT_TRUE(map.emplace(1, "one").second);
+    EXPECT_FALSE(map.emplace(1, "uno").second);
+    map[3] = "three";
+    EXPECT_EQ(map.at(1), "one");
+    EXPECT_THROW(map.at(4), std::out_of_range);
+
+    EXPECT_FALSE(map.insert_or_assign(2, "dos").second);
+    EXPECT_TRUE(map.insert_or_assign(4, "four").second);
+    EXPECT_EQ(to_std(map.keys()), (std::vector<int>{1, 2, 3, 4}));
+    EXPECT_EQ(to_std(map.values()), (std::vector<std::string>{"one", "dos", "three", "four"}));
+
+    auto it = map.find(3);
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, 3);
+    it->second += "!";
+    EXPECT_EQ(map.at(3), "three!");
+
+    EXPECT_EQ(map.erase(2), 1u);
+    EXPECT_EQ(map.erase(2), 0u);
+    it = map.erase(map.find(1));
+    EXPECT_EQ(it->first, 3);
+    EXPECT_EQ(map, (FlatMap<int, std::string>{{3, "three!"}, {4, "four"}}));
+}
+
+TEST(FlatMapTest, TryEmplaceLeavesArgumentsAloneWhenKeyIsPresent)
+{
+    FlatMap<std::string, std::unique_ptr<int>> map;
+    auto value = std::make_unique<int>(1);
+    EXPECT_TRUE(map.try_emplace("a", std::move(value)).second);
+    EXPECT_EQ(value, nullptr);
+
+    auto other = std::make_unique<int>(2);
+    EXPECT_FALSE(map.try_emplace("a", std::move(other)).second);
+    ASSERT_NE(other, nullptr);
+    EXPECT_EQ(*map.at("a"), 1);
+}
+
+TEST(FlatMapTest, IteratesInKeyOrderWithPairProxies)
+{
+    const FlatMap<int, int> map{{30, 3}, {10, 1}, {20, 2}};
+    std::vector<std::pair<int, int>> seen;
+    for (const auto& [key, value] : map) {
+        seen.emplace_back(key, value);
+    }
+    EXPECT_EQ(seen, (std::vector<std::pair<int, int>>{{10, 1}, {20, 2}, {30, 3}}));
+
+    EXPECT_EQ(map.end() - map.begin(), 3);
+    EXPECT_EQ(map.begin()[2].second, 3);
+    EXPECT_EQ((*map.lower_bound(15)).first, 20);
+    EXPECT_EQ(map.upper_bound(20)->first, 30);
+    EXPECT_EQ((map.end() - 1)->second, 3);
+}
+
+TEST(FlatMapTest, InsertSortedRangeMergesInOnePass)
+{
+    FlatMap<int, std::string> map{{2, "b"}, {4, "d"}, {6, "f"}};
+    const std::vector<std::pair<int, std::string>> batch{{1, "a"}, {2, "B"}, {3, "c"}, {3, "C"}, {7, "g"}};
+    map.insert_sorted_range(batch.begin(), batch.end());
+    // present keys keep their values and the first of repeated keys wins
+    EXPECT_EQ(to_std(map.keys()), (std::vector<int>{1, 2, 3, 4, 6, 7}));
+    EXPECT_EQ(to_std(map.values()), (std::vector<std::string>{"a", "b", "c", "d", "f", "g"}));
+
+    const std::vector<std::pair<int, std::string>> unsorted{{9, "i"}, {0, "z"}, {5, "e"}, {0, "Z"}};
+    map.insert(unsorted.begin(), unsorted.end());
+    EXPECT_EQ(to_std(map.keys()), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 9}));
+    EXPECT_EQ(map.at(0), "z");
+
+    FlatSet<int> set{10, 30};
+    set.reserve(8);
+    EXPECT_GE(set.capacity(), 8u);
+    const int keys[] = {5, 10, 10, 20, 40};
+    set.insert_sorted_range(std::begin(keys), std::end(keys));
+    EXPECT_EQ(to_std(set.keys()), (std::vector<int>{5, 10, 20, 30, 40}));
+}
+
+TEST(FlatMapTest, InsertSortedRangeCopiesFromLvalueRanges)
+{
+    FlatMap<std::string, std::string> map{{"b", "2"}};
+    const std::vector<std::pair<std::string, std::string>> expected{{"a", "1"}, {"c", "3"}};
+    std::vector<std::pair<std::string, std::string>> source = expected;
+    map.insert_sorted_range(source.begin(), source.end());
+    EXPECT_EQ(source, expected);
+    EXPECT_EQ(to_std(map.keys()), (std::vector<std::string>{"a", "b", "c"}));
+    EXPECT_EQ(map.at("c"), "3");
+
+    std::vector<std::string> keys{"x", "y"};
+    FlatSet<std::string> set;
+    set.insert_sorted_range(keys.begin(), keys.end());
+    EXPECT_EQ(keys, (std::vector<std::string>{"x", "y"}));
+    EXPECT_TRUE(set.contains("y"));
+}
+
+// Value whose copies throw once copies_left runs out; moves never throw.
+struct ThrowingCopy {
+    static inline int copies_left = 0;
+
+    int value;
+
+    ThrowingCopy(int v) : value(v) {}
+    ThrowingCopy(ThrowingCopy&&) noexcept = default;
+    ThrowingCopy& operator=(ThrowingCopy&&) noexcept = default;
+    ThrowingCopy(const ThrowingCopy& other) : value(other.value)
+    {
+        if (copies_left-- == 0) throw std::runtime_error("copy failed");
+    }
+};
+
+TEST(FlatMapTest, InsertSortedRangeThatThrowsLeavesTheMapEmpty)
+{
+    ThrowingCopy::copies_left = 100;
+    FlatMap<int, ThrowingCopy> map;
+    for (int key = 0; key < 10; key += 2) {
+        map.try_emplace(key, key);
+    }
+    const std::vector<std::pair<int, ThrowingCopy>> batch{{1, 1}, {5, 5}, {9, 9}};
+    ThrowingCopy::copies_left = 1;
+    EXPECT_THROW(map.insert_sorted_range(batch.begin(), batch.end()), std::runtime_error);
+    EXPECT_TRUE(map.empty());
+    EXPECT_TRUE(map.keys().empty());
+    EXPECT_TRUE(map.values().empty());
+
+    ThrowingCopy::copies_left = 100;
+    map.insert_sorted_range(batch.begin(), batch.end());
+    EXPECT_EQ(to_std(map.keys()), (std::vector<int>{1, 5, 9}));
+}
+
+TEST(FlatMapTest, LookupIndexAgreesWithBinarySearchUntilKeysChange)
+{
+    for (int count = 0; count <= 70; ++count) {
+        FlatMap<int, int> map;
+        for (int i = 0; i < count; ++i) {
+            map.try_emplace(2 * i, i);
+        }
+        map.build_lookup_index();
+        EXPECT_EQ(map.has_lookup_index(), count > 0);
+        for (int key = -1; key <= 2 * count; ++key) {
+            const auto expected = static_cast<std::ptrdiff_t>(key <= 0 ? 0 : (key + 1) / 2);
+            ASSERT_EQ(map.lower_bound(key) - map.begin(), expected) << count << " " << key;
+            ASSERT_EQ(map.contains(key), key >= 0 && key % 2 == 0 && key < 2 * count);
+        }
+    }
+
+    FlatMap<int, int> map{{1, 10}, {3, 30}};
+    map.build_lookup_index();
+    map.at(3) = 31; // values only
+    EXPECT_TRUE(map.has_lookup_index());
+    map[2] = 20;
+    EXPECT_FALSE(map.has_lookup_index());
+    EXPECT_EQ(map.at(2), 20);
+}
+} // namespace
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "../Allocator.h"
+#include "../GrowthPolicy.h"
+#include "../Vector.h"
+
+TEST(GrowthPolicyTest, DoublingGrowthStartsAtOne)
+{
+    EXPECT_EQ(DoublingGrowth::next_capacity(0, 1, sizeof(int)), 1u);
+    EXPECT_EQ(DoublingGrowth::next_capacity(1, 2, sizeof(int)), 2u);
+    EXPECT_EQ(DoublingGrowth::next_capacity(8, 9, sizeof(int)), 16u);
+}
+
+TEST(GrowthPolicyTest, GeometricGrowthSkipsTinyAllocations)
+{
+    EXPECT_EQ(Growth2x::next_capacity(0, 1, sizeof(int)), 16u);
+    EXPECT_EQ(Growth2x::next_capacity(16, 17, sizeof(int)), 32u);
+    EXPECT_EQ(Growth1_5x::next_capacity(0, 1, sizeof(std::uint64_t)), 8u);
+    EXPECT_EQ(Growth1_5x::next_capacity(8, 9, sizeof(std::uint64_t)), 12u);
+    EXPECT_EQ(Growth1_5x::next_capacity(1, 2, 128), 2u); // factor rounds down to no growth
+}
+
+TEST(GrowthPolicyTest, PoliciesHonourRequiredCapacity)
+{
+    EXPECT_EQ(DoublingGrowth::next_capacity(4, 100, 1), 100u);
+    EXPECT_EQ(Growth1_5x::next_capacity(4, 100, 1), 100u);
+    EXPECT_EQ((CappedGrowth<64>::next_capacity(1000, 5000, 1)), 5000u);
+}
+
+TEST(GrowthPolicyTest, CappedGrowthLimitsStepSize)
+{
+    using Capped = CappedGrowth<1024>;
+    EXPECT_EQ(Capped::next_capacity(64, 65, 1), 128u);
+    EXPECT_EQ(Capped::next_capacity(4096, 4097, 1), 4096u + 1024u);
+    EXPECT_EQ(Capped::next_capacity(4096, 4097, 8), 4096u + 128u);
+}
+
+TEST(GrowthPolicyTest, GrowthSaturatesInsteadOfOverflowing)
+{
+    const std::size_t huge = static_cast<std::size_t>(-1) / 4;
+    EXPECT_GE(Growth2x::next_capacity(huge, huge + 1, 4), huge + 1);
+    EXPECT_GE(DoublingGrowth::next_capacity(huge, huge + 1, 4), huge + 1);
+}
+
+TEST(GrowthPolicyTest, SizeClassGrowthFillsAllocatorBins)
+{
+    // 1.5x of 12 three-byte elements asks for 54 bytes; the whole bin becomes capacity
+    const std::size_t capacity = SizeClassGrowth<Growth1_5x>::next_capacity(12, 13, 3);
+    EXPECT_GE(capacity, 18u);
+    EXPECT_EQ(capacity, growth_detail::allocator_size_class(54) / 3);
+
+#if defined(__GLIBC__)
+    if (nallocx == nullptr) {
+        // what malloc_usable_size() reports for glibc's 16-byte chunks
+        EXPECT_EQ(growth_detail::allocator_size_class(1), 24u);
+        EXPECT_EQ(growth_detail::allocator_size_class(17), 24u);
+        EXPECT_EQ(growth_detail::allocator_size_class(25), 40u);
+        EXPECT_EQ(growth_detail::allocator_size_class(136), 136u);
+        EXPECT_EQ(growth_detail::allocator_size_class(4096), 4104u);
+        EXPECT_EQ(growth_detail::allocator_size_class(4097), 4104u);
+    }
+#endif
+}
+
+TEST(GrowthPolicyTest, SizeClassGrowthNeverFallsShortOrOverflows)
+{
+    const std::size_t huge = static_cast<std::size_t>(-1) / 8;
+    EXPECT_GE(SizeClassGrowth<>::next_capacity(huge - 1, huge, 8), huge);
+    EXPECT_GE(SizeClassGrowth<>::next_capacity(huge, huge + 1, 8), huge + 1);
+    EXPECT_EQ(growth_detail::allocator_size_class(static_cast<std::size_t>(-1) - 4), static_cast<std::size_t>(-1) - 4);
+    for (std::size_t bytes = 0; bytes < 5000; ++bytes) {
+        ASSERT_GE(growth_detail::allocator_size_class(bytes), bytes);
+    }
+}
+
+TEST(GrowthPolicyTest, VectorUsesSelectedPolicy)
+{
+    Vector<int, std::allocator<int>, Growth1_5x> vec;
+    vec.push_back(1);
+    EXPECT_EQ(vec.capacity(), 16u);
+
+    for (int i = 1; i < 17; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(vec.capacity(), 24u);
+    EXPECT_EQ(vec[16], 16);
+}
+
+TEST(GrowthPolicyTest, CapacityReportsAllocatorUsableSize)
+{
+    Vector<char, ReallocAllocator<char>> vec;
+    vec.reserve(13);
+
+    EXPECT_GE(vec.capacity(), 13u);
+#if defined(__GLIBC__)
+    EXPECT_EQ(vec.capacity(), ::malloc_usable_size(vec.data()));
+#endif
+    const std::size_t usable = vec.capacity();
+    for (std::size_t i = 0; i < usable; ++i) {
+        vec.push_back('x');
+    }
+    EXPECT_EQ(vec.capacity(), usable);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include "../IncrementalVector.h"
+
+namespace {
+static_assert(std::random_access_iterator<IncrementalVector<int>::iterator>);
+
+TEST(IncrementalVectorTest, GrowthLeavesOldElementsForLaterAppends) {
+    IncrementalVector<int> vec;
+    vec.reserve(1024);
+    for (int i = 0; i < 1024; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_FALSE(vec.migrating());
+
+    vec.push_back(1024);
+    EXPECT_TRUE(vec.migrating());
+    EXPECT_EQ(vec.capacity(), 2048u);
+    for (int i = 0; i <= 1024; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+
+    while (vec.migrating()) {
+        vec.push_back(static_cast<int>(vec.size()));
+    }
+    // a whole batch per append finishes long before the new buffer fills
+    EXPECT_LE(vec.size(), 1024u + 1024u / IncrementalVector<int>::migration_batch + 1);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], static_cast<int>(i));
+    }
+}
+
+TEST(IncrementalVectorTest, MigratesNonTrivialElements) {
+    IncrementalVector<std::string> vec;
+    for (int i = 0; i < 5000; ++i) {
+        vec.push_back(std::to_string(i));
+        ASSERT_EQ(vec.back(), std::to_string(i));
+    }
+    for (int i = 0; i < 5000; ++i) {
+        EXPECT_EQ(vec.at(i), std::to_string(i));
+    }
+    EXPECT_THROW(vec.at(5000), std::out_of_range);
+}
+
+TEST(IncrementalVectorTest, AppendsCopiesOfItsOwnElements) {
+    const std::string text = "a string too long for the small-string buffer";
+    IncrementalVector<std::string> vec{text};
+    for (int i = 0; i < 2000; ++i) {
+        // some of these appends grow the buffer, others migrate vec[0] and free the old one
+        vec.push_back(vec[0]);
+        vec.push_back(vec.back());
+    }
+    ASSERT_EQ(vec.size(), 4001u);
+    EXPECT_TRUE(std::all_of(vec.begin(), vec.end(), [&](const std::string& s) { return s == text; }));
+}
+
+TEST(IncrementalVectorTest, PopBackShortensPendingRange) {
+    IncrementalVector<std::unique_ptr<int>> vec;
+    vec.reserve(1024);
+    for (int i = 0; i < 1024; ++i) {
+        vec.push_back(std::make_unique<int>(i));
+    }
+    vec.push_back(std::make_unique<int>(1024));
+    ASSERT_TRUE(vec.migrating());
+
+    // drop everything past the part already migrated
+    while (vec.migrating()) {
+        vec.pop_back();
+    }
+    EXPECT_EQ(vec.size(), IncrementalVector<std::unique_ptr<int>>::migration_batch);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(*vec[i], static_cast<int>(i));
+    }
+    vec.push_back(std::make_unique<int>(99));
+    EXPECT_EQ(*vec.back(), 99);
+
+    vec.clear();
+    vec.pop_back(); // no-op on an empty vector
+    EXPECT_TRUE(vec.empty());
+}
+
+TEST(IncrementalVectorTest, DataFinishesMigration) {
+    IncrementalVector<double> vec;
+    for (int i = 0; i < 3000; ++i) {
+        vec.push_back(i);
+    }
+    vec.reserve(vec.capacity());
+    while (!vec.migrating()) {
+        vec.push_back(static_cast<double>(vec.size()));
+    }
+
+    const double* data = vec.data();
+    EXPECT_FALSE(vec.migrating());
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(data[i], static_cast<double>(i));
+    }
+}
+
+TEST(IncrementalVectorTest, CopyMoveAndSwapMidMigration) {
+    IncrementalVector<std::string> vec;
+    vec.reserve(64);
+    for (int i = 0; i < 65; ++i) {
+        vec.push_back(std::string(20, static_cast<char>('a' + i % 26)));
+    }
+    ASSERT_TRUE(vec.migrating());
+
+    IncrementalVector<std::string> copy = vec;
+    EXPECT_FALSE(copy.migrating());
+    EXPECT_EQ(copy, vec);
+
+    IncrementalVector<std::string> moved = std::move(vec);
+    EXPECT_TRUE(moved.migrating());
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(moved, copy);
+
+    IncrementalVector<std::string> other = {"x", "y"};
+    other.swap(moved);
+    EXPECT_EQ(other, copy);
+    EXPECT_EQ(moved.size(), 2u);
+
+    moved = other;
+    EXPECT_EQ(moved, copy);
+    EXPECT_TRUE(std::equal(moved.begin(), moved.end(), copy.begin()));
+}
+
+struct ThrowingCopy {
+    static inline int copies_left = 1000000;
+
+    explicit ThrowingCopy(int value)
+        : value(value) {}
+    ThrowingCopy(const ThrowingCopy& other)
+        : value(other.value)
+    {
+        if (--copies_left < 0) throw std::runtime_error("copy");
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+
+    int value;
+};
+
+TEST(IncrementalVectorTest, ThrowingMigrationKeepsEveryElement) {
+    IncrementalVector<ThrowingCopy> vec;
+    vec.reserve(100);
+    for (int i = 0; i < 100; ++i) {
+        vec.emplace_back(i);
+    }
+
+    ThrowingCopy::copies_left = 3;
+    EXPECT_THROW(vec.emplace_back(100), std::runtime_error);
+    EXPECT_EQ(vec.size(), 100u);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(vec[i].value, i);
+    }
+
+    ThrowingCopy::copies_left = 1000000;
+    vec.emplace_back(100);
+    vec.finish_migration();
+    for (int i = 0; i <= 100; ++i) {
+        EXPECT_EQ(vec[i].value, i);
+    }
+}
+} // namespace
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "../InplaceVector.h"
+
+namespace {
+// Squares of 0..N-1, computed entirely at compile time.
+template <std::size_t N>
+constexpr InplaceVector<int, N> squares()
+{
+    InplaceVector<int, N> table;
+    for (std::size_t i = 0; i < N; ++i) {
+        table.push_back(static_cast<int>(i * i));
+    }
+    return table;
+}
+
+constexpr auto square_table = squares<16>();
+static_assert(square_table.size() == 16);
+static_assert(square_table[15] == 225);
+static_assert(std::is_trivially_copyable_v<InplaceVector<int, 8>>);
+static_assert(!std::is_trivially_copyable_v<InplaceVector<std::string, 8>>);
+
+// Exercises the editing members on non-trivial elements inside a constant expression.
+constexpr bool edit_strings_at_compile_time()
+{
+    InplaceVector<std::string, 8> vec{"b", "d"};
+    vec.insert(vec.begin(), "a");
+    vec.emplace(vec.begin() + 2, 1, 'c');
+    vec.insert(vec.end(), 2, "e");
+    vec.erase(vec.end() - 1);
+    if (vec.try_push_back("f") == nullptr) return false;
+    erase(vec, std::string("d"));
+    return vec == InplaceVector<std::string, 8>{"a", "b", "c", "e", "f"};
+}
+static_assert(edit_strings_at_compile_time());
+
+TEST(InplaceVectorTest, TryPushBackReturnsNullptrWhenFull)
+{
+    InplaceVector<int, 3> vec;
+    for (int i = 0; i < 3; ++i) {
+        int* slot = vec.try_push_back(i);
+        ASSERT_NE(slot, nullptr);
+        EXPECT_EQ(*slot, i);
+        EXPECT_EQ(slot, &vec.back());
+    }
+    EXPECT_TRUE(vec.full());
+    EXPECT_EQ(vec.try_push_back(3), nullptr);
+    EXPECT_EQ(vec.try_emplace_back(3), nullptr);
+
+    auto owner = std::make_unique<int>(7);
+    InplaceVector<std::unique_ptr<int>, 1> owners;
+    owners.push_back(std::make_unique<int>(1));
+    EXPECT_EQ(owners.try_push_back(std::move(owner)), nullptr);
+    ASSERT_NE(owner, nullptr); // a rejected rvalue is left untouched
+    EXPECT_EQ(*owner, 7);
+}
+
+TEST(InplaceVectorTest, ThrowingMembersReportOverflowWithBadAlloc)
+{
+    InplaceVector<std::string, 2> vec{"a", "b"};
+    EXPECT_THROW(vec.push_back("c"), std::bad_alloc);
+    EXPECT_THROW(vec.insert(vec.begin(), "c"), std::bad_alloc);
+    EXPECT_THROW(vec.resize(3), std::bad_alloc);
+    EXPECT_THROW(vec.reserve(3), std::bad_alloc);
+    EXPECT_THROW((InplaceVector<int, 2>{1, 2, 3}), std::bad_alloc);
+    EXPECT_THROW(vec.at(2), std::out_of_range);
+
+    std::array<std::string, 3> more{"x", "y", "z"};
+    vec.pop_back();
+    EXPECT_THROW(vec.append_range(more), std::bad_alloc);
+    EXPECT_EQ(vec, (InplaceVector<std::string, 2>{"a"})); // nothing appended
+
+    auto rest = vec.try_append_range(more);
+    EXPECT_EQ(rest, more.begin() + 1);
+    EXPECT_EQ(vec, (InplaceVector<std::string, 2>{"a", "x"}));
+}
+
+TEST(InplaceVectorTest, InsertAndEraseKeepOrder)
+{
+    InplaceVector<std::string, 16> vec{"a", "e"};
+    std::array<std::string, 3> middle{"b", "c", "d"};
+    auto it = vec.insert(vec.begin() + 1, middle.begin(), middle.end());
+    EXPECT_EQ(*it, "b");
+    EXPECT_EQ(vec, (InplaceVector<std::string, 16>{"a", "b", "c", "d", "e"}));
+
+    vec.insert(vec.begin(), 2, vec[4]); // value aliases an element
+    EXPECT_EQ(vec, (InplaceVector<std::string, 16>{"e", "e", "a", "b", "c", "d", "e"}));
+
+    it = vec.erase(vec.begin(), vec.begin() + 2);
+    EXPECT_EQ(*it, "a");
+    vec.swap_remove(0);
+    EXPECT_EQ(vec, (InplaceVector<std::string, 16>{"e", "b", "c", "d"}));
+    EXPECT_EQ(erase_if(vec, [](const std::string& s) { return s < "d"; }), 2u);
+    EXPECT_EQ(vec, (InplaceVector<std::string, 16>{"e", "d"}));
+}
+
+TEST(InplaceVectorTest, CopyMoveAndSwapHandleEveryElement)
+{
+    InplaceVector<std::string, 4> a{"one", "two", "three"};
+    InplaceVector<std::string, 4> b = a;
+    EXPECT_EQ(a, b);
+
+    InplaceVector<std::string, 4> c{"x"};
+    c.swap(a);
+    EXPECT_EQ(a, (InplaceVector<std::string, 4>{"x"}));
+    EXPECT_EQ(c, b);
+
+    InplaceVector<std::string, 4> d = std::move(c);
+    EXPECT_EQ(d, b);
+    a = d;
+    EXPECT_EQ(a, b);
+    a = {"y"};
+    EXPECT_EQ(a.size(), 1u);
+
+    InplaceVector<int, 4> ints{1, 2, 3};
+    InplaceVector<int, 4> copy = ints;
+    copy.resize(4);
+    EXPECT_EQ(copy[3], 0);
+    EXPECT_EQ(ints.size(), 3u);
+}
+
+TEST(InplaceVectorTest, StoresElementsInsideTheObject)
+{
+    InplaceVector<double, 32> vec(5, 1.5);
+    const auto* begin = reinterpret_cast<const std::byte*>(&vec);
+    const auto* element = reinterpret_cast<const std::byte*>(vec.data());
+    EXPECT_GE(element, begin);
+    EXPECT_LT(element, begin + sizeof(vec));
+    EXPECT_EQ(vec.capacity(), 32u);
+    EXPECT_EQ(std::count(vec.begin(), vec.end(), 1.5), 5);
+
+    // destroying the vector destroys exactly its elements
+    auto shared = std::make_shared<int>(0);
+    {
+        InplaceVector<std::shared_ptr<int>, 4> holders(3, shared);
+        EXPECT_EQ(shared.use_count(), 4);
+        holders.pop_back();
+        EXPECT_EQ(shared.use_count(), 3);
+    }
+    EXPECT_EQ(shared.use_count(), 1);
+}
+} // namespace
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <string>
+#include <unistd.h>
+#include "../MappedVector.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+namespace {
+class MappedVectorTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        path = std::filesystem::temp_directory_path() /
+            ("mapped_vector_test_" + std::to_string(::getpid()) + "_" +
+             ::testing::UnitTest::GetInstance()->current_test_info()->name());
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path);
+    }
+
+    std::filesystem::path path;
+};
+
+TEST_F(MappedVectorTest, CreatedFileGrowsAndIsTrimmedOnClose) {
+    {
+        auto vec = MappedVector<std::uint64_t>::create(path);
+        for (std::uint64_t i = 0; i < 10000; ++i) {
+            vec.push_back(i);
+        }
+        EXPECT_EQ(vec.size(), 10000u);
+        EXPECT_GE(vec.capacity(), 10000u);
+        EXPECT_GE(std::filesystem::file_size(path), vec.capacity() * sizeof(std::uint64_t));
+    }
+
+    EXPECT_EQ(std::filesystem::file_size(path), 10000u * sizeof(std::uint64_t));
+}
+
+TEST_F(MappedVectorTest, ExistingArrayFileOpensInPlace) {
+    std::vector<std::int32_t> raw(4096);
+    std::iota(raw.begin(), raw.end(), -100);
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(raw.data()), static_cast<std::streamsize>(raw.size() * sizeof(std::int32_t)));
+    }
+
+    const MappedVector<std::int32_t> vec(path, MappedVector<std::int32_t>::Mode::read_only);
+    vec.advise(MappedVector<std::int32_t>::Access::sequential);
+    ASSERT_EQ(vec.size(), raw.size());
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), raw.begin()));
+    EXPECT_EQ(vec.front(), -100);
+    EXPECT_EQ(vec.at(4095), 3995);
+    EXPECT_THROW(vec.at(4096), std::out_of_range);
+}
+
+TEST_F(MappedVectorTest, ChangesPersistAcrossReopen) {
+    {
+        auto vec = MappedVector<double>::create(path, 16);
+        vec.resize(100);
+        vec[42] = 4.5;
+        vec.flush();
+    }
+    {
+        MappedVector<double> vec(path);
+        ASSERT_EQ(vec.size(), 100u);
+        EXPECT_EQ(vec[0], 0.0);
+        EXPECT_EQ(vec[42], 4.5);
+        vec.push_back(7.0);
+        vec.close();
+        EXPECT_FALSE(vec.is_open());
+    }
+    MappedVector<double> vec(path, MappedVector<double>::Mode::read_only);
+    EXPECT_EQ(vec.size(), 101u);
+    EXPECT_EQ(vec.back(), 7.0);
+}
+
+TEST_F(MappedVectorTest, ShrinkThenGrowValueInitializes) {
+    auto vec = MappedVector<int>::create(path);
+    vec.resize(10);
+    std::fill(vec.begin(), vec.end(), 9);
+    vec.resize(2);
+    vec.resize(10);
+    EXPECT_EQ(vec[1], 9);
+    EXPECT_EQ(vec[2], 0);
+
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 10u);
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 0u);
+    EXPECT_EQ(vec.data(), nullptr);
+    vec.push_back(3);
+    EXPECT_EQ(vec[0], 3);
+}
+
+TEST_F(MappedVectorTest, ReadOnlyMappingRefusesEverySizeChange) {
+    {
+        auto created = MappedVector<int>::create(path);
+        created.push_back(1);
+        created.push_back(2);
+    }
+    MappedVector<int> vec(path, MappedVector<int>::Mode::read_only);
+    EXPECT_FALSE(vec.writable());
+    EXPECT_THROW(vec.push_back(2), std::logic_error);
+    EXPECT_THROW(vec.emplace_back(2), std::logic_error);
+    EXPECT_THROW(vec.pop_back(), std::logic_error);
+    EXPECT_THROW(vec.clear(), std::logic_error);
+    EXPECT_THROW(vec.resize(1), std::logic_error);
+    EXPECT_THROW(vec.reserve(8), std::logic_error);
+    EXPECT_THROW(vec.shrink_to_fit(), std::logic_error);
+    ASSERT_EQ(vec.size(), 2u);
+    EXPECT_EQ(vec[1], 2);
+}
+
+TEST_F(MappedVectorTest, PushBackOfOwnElementSurvivesRemap) {
+    auto vec = MappedVector<std::int64_t>::create(path);
+    vec.push_back(7);
+    for (int i = 0; i < 5000; ++i) {
+        vec.push_back(vec[0]);
+        vec.emplace_back(vec.back());
+    }
+    ASSERT_EQ(vec.size(), 10001u);
+    EXPECT_TRUE(std::all_of(vec.begin(), vec.end(), [](std::int64_t v) { return v == 7; }));
+}
+
+TEST_F(MappedVectorTest, RejectsMissingAndMisSizedFiles) {
+    EXPECT_THROW(MappedVector<int>{path}, std::system_error);
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "abcde";
+    }
+    EXPECT_THROW(MappedVector<int>{path}, std::invalid_argument);
+}
+
+TEST_F(MappedVectorTest, MoveTransfersTheMapping) {
+    auto first = MappedVector<int>::create(path);
+    first.push_back(5);
+    MappedVector<int> second(std::move(first));
+    EXPECT_FALSE(first.is_open());
+    EXPECT_EQ(second[0], 5);
+
+    static_assert(std::ranges::contiguous_range<MappedVector<int>>);
+}
+} // namespace
+#endif
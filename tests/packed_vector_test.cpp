@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include "../PackedVector.h"
+
+namespace {
+TEST(BitVectorTest, StoresOneBitPerFlag)
+{
+    BitVector<> bits;
+    for (int i = 0; i < 130; ++i) {
+        bits.push_back(i % 3 == 0);
+    }
+    ASSERT_EQ(bits.size(), 130u);
+    EXPECT_EQ(bits.words().size(), 3u);
+    for (int i = 0; i < 130; ++i) {
+        EXPECT_EQ(bits[i], i % 3 == 0) << i;
+    }
+    EXPECT_EQ(bits.popcount(), 44u);
+
+    bits[1] = true;
+    bits.flip(0);
+    bits.reset(3);
+    EXPECT_TRUE(bits.test(1));
+    EXPECT_FALSE(bits.at(0));
+    EXPECT_FALSE(bits[3]);
+    EXPECT_THROW(bits.at(130), std::out_of_range);
+
+    bits.pop_back(); // 129 was set
+    EXPECT_EQ(bits.size(), 129u);
+    EXPECT_EQ(bits.popcount(), 42u);
+}
+
+TEST(BitVectorTest, ProxyIteratorsWorkWithAlgorithms)
+{
+    BitVector<> bits{true, false, true, true, false};
+    EXPECT_EQ(std::count(bits.cbegin(), bits.cend(), true), 3);
+
+    for (auto bit : bits) {
+        bit = !bit;
+    }
+    EXPECT_EQ(bits, (BitVector<>{false, true, false, false, true}));
+
+    bits[0] = bits[1]; // assigns the value, not the proxy
+    EXPECT_TRUE(bits[0]);
+    EXPECT_TRUE(bits[1]);
+    EXPECT_EQ(bits.end() - bits.begin(), 5);
+}
+
+TEST(BitVectorTest, FindScansWholeWords)
+{
+    BitVector<> bits(300);
+    EXPECT_TRUE(bits.none());
+    EXPECT_EQ(bits.find_first(), BitVector<>::npos);
+
+    for (std::size_t i : {5u, 64u, 65u, 299u}) {
+        bits.set(i);
+    }
+    std::vector<std::size_t> found;
+    for (std::size_t i = bits.find_first(); i != BitVector<>::npos; i = bits.find_next(i)) {
+        found.push_back(i);
+    }
+    EXPECT_EQ(found, (std::vector<std::size_t>{5, 64, 65, 299}));
+    EXPECT_EQ(bits.find_next(299), BitVector<>::npos);
+}
+
+TEST(BitVectorTest, BulkOperationsCombineWordwise)
+{
+    BitVector<> a(200);
+    BitVector<> b(200);
+    for (std::size_t i = 0; i < 200; ++i) {
+        a.set(i, i % 2 == 0);
+        b.set(i, i % 3 == 0);
+    }
+
+    EXPECT_EQ((a & b).popcount(), 34u); // multiples of 6
+    EXPECT_EQ((a | b).popcount(), 100u + 67u - 34u);
+    EXPECT_EQ((a ^ b).popcount(), 100u + 67u - 2 * 34u);
+
+    BitVector<> c = a;
+    c.flip();
+    EXPECT_EQ(c.popcount(), 100u);
+    EXPECT_EQ(c.words().back() >> (200 % 64), 0u); // padding stays clear
+    c.fill(true);
+    EXPECT_TRUE(c.all());
+    c.resize(70);
+    EXPECT_EQ(c.popcount(), 70u);
+    c.resize(130, false);
+    EXPECT_EQ(c.popcount(), 70u);
+    c.resize(140, true);
+    EXPECT_EQ(c.popcount(), 80u);
+
+    EXPECT_THROW(a &= BitVector<>(10), std::invalid_argument);
+}
+
+TEST(PackedIntVectorTest, StoresFieldsAcrossWordBoundaries)
+{
+    PackedIntVector<12> ids;
+    for (std::uint16_t i = 0; i < 1000; ++i) {
+        ids.push_back(static_cast<std::uint16_t>(i * 37 % 4096));
+    }
+    static_assert(std::is_same_v<PackedIntVector<12>::value_type, std::uint16_t>);
+    EXPECT_EQ(ids.words().size(), (1000u * 12 + 63) / 64);
+    for (std::uint16_t i = 0; i < 1000; ++i) {
+        ASSERT_EQ(ids[i], i * 37 % 4096) << i;
+    }
+
+    ids[5] = 4095; // field 5 straddles words 0 and 1
+    ids[6] = 0;
+    EXPECT_EQ(ids[4], 4 * 37);
+    EXPECT_EQ(ids[5], 4095);
+    EXPECT_EQ(ids[6], 0);
+    EXPECT_EQ(ids.at(7), 7 * 37);
+    EXPECT_THROW(ids.at(1000), std::out_of_range);
+
+    ids.pop_back();
+    ids.resize(10);
+    EXPECT_EQ(ids.size(), 10u);
+    EXPECT_EQ(ids.back(), 9 * 37);
+    ids.resize(12, 7);
+    EXPECT_EQ(ids[11], 7);
+    EXPECT_EQ(std::count(ids.cbegin(), ids.cend(), 7), 2);
+}
+
+template <std::size_t Bits>
+void check_unpack()
+{
+    std::mt19937_64 random(Bits);
+    PackedIntVector<Bits> packed;
+    std::vector<typename PackedIntVector<Bits>::value_type> expected;
+    for (int i = 0; i < 1000; ++i) {
+        const auto value = static_cast<typename PackedIntVector<Bits>::value_type>(random() & vector_detail::low_bits(Bits));
+        packed.push_back(value);
+        expected.push_back(value);
+    }
+
+    const auto all = packed.unpack();
+    ASSERT_EQ(all.size(), expected.size());
+    EXPECT_TRUE(std::equal(all.begin(), all.end(), expected.begin())) << Bits;
+
+    // a run that starts and ends inside blocks
+    std::vector<typename PackedIntVector<Bits>::value_type> part(700);
+    packed.unpack(37, part);
+    EXPECT_TRUE(std::equal(part.begin(), part.end(), expected.begin() + 37)) << Bits;
+}
+
+TEST(PackedIntVectorTest, PushBackGrowsGeometrically)
+{
+    PackedIntVector<12> ids;
+    std::size_t reallocations = 0;
+    std::size_t capacity = ids.capacity();
+    for (std::uint32_t i = 0; i < 100000; ++i) {
+        ids.push_back(static_cast<std::uint16_t>(i % 4096));
+        if (ids.capacity() != capacity) {
+            ++reallocations;
+            capacity = ids.capacity();
+        }
+    }
+    // doubling needs about log2(18750 words) reallocations, not one per word
+    EXPECT_LE(reallocations, 20u);
+    EXPECT_EQ(ids.words().size(), (100000u * 12 + 63) / 64);
+    EXPECT_EQ(ids[99999], 99999 % 4096);
+}
+
+TEST(PackedIntVectorTest, UnpackMatchesElementAccessForEveryWidth)
+{
+    check_unpack<1>();
+    check_unpack<3>();
+    check_unpack<12>();
+    check_unpack<17>();
+    check_unpack<32>();
+    check_unpack<33>();
+    check_unpack<63>();
+    check_unpack<64>();
+
+    PackedIntVector<5> small{1, 2, 3};
+    std::vector<std::uint8_t> out(3);
+    EXPECT_THROW(small.unpack(1, out), std::out_of_range);
+}
+} // namespace
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../VectorSerialization.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+namespace {
+struct Sample {
+    std::uint32_t id;
+    float weight;
+    double score;
+};
+
+Vector<Sample> make_samples(std::size_t count)
+{
+    Vector<Sample> vec;
+    for (std::size_t i = 0; i < count; ++i) {
+        vec.push_back({static_cast<std::uint32_t>(i), static_cast<float>(i) * 0.5f, static_cast<double>(i) * 2.0});
+    }
+    return vec;
+}
+
+// Reads everything currently in a seekable fd from the start.
+std::vector<std::byte> slurp(int fd)
+{
+    std::vector<std::byte> bytes(static_cast<std::size_t>(::lseek(fd, 0, SEEK_END)));
+    ::lseek(fd, 0, SEEK_SET);
+    EXPECT_EQ(::read(fd, bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+    ::lseek(fd, 0, SEEK_SET);
+    return bytes;
+}
+
+class SerializationTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        char name[] = "/tmp/vector_io_testXXXXXX";
+        fd = ::mkstemp(name);
+        ASSERT_GE(fd, 0);
+        ::unlink(name);
+    }
+
+    void TearDown() override
+    {
+        ::close(fd);
+    }
+
+    int fd = -1;
+};
+
+TEST_F(SerializationTest, RoundTripsThroughAFile) {
+    const auto original = make_samples(1000);
+    vector_io::write_to(fd, original);
+    EXPECT_EQ(static_cast<std::size_t>(::lseek(fd, 0, SEEK_CUR)), vector_io::serialized_size<Sample>(1000));
+
+    ::lseek(fd, 0, SEEK_SET);
+    const auto loaded = vector_io::read_from<Sample>(fd);
+    ASSERT_EQ(loaded.size(), original.size());
+    EXPECT_EQ(std::memcmp(loaded.data(), original.data(), original.size() * sizeof(Sample)), 0);
+}
+
+TEST_F(SerializationTest, HeaderDescribesThePayload) {
+    vector_io::write_to(fd, make_samples(3));
+    const auto bytes = slurp(fd);
+
+    vector_io::Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    EXPECT_EQ(header.magic, vector_io::format_magic);
+    EXPECT_EQ(header.version, vector_io::format_version);
+    EXPECT_EQ(header.element_size, sizeof(Sample));
+    EXPECT_EQ(header.count, 3u);
+    EXPECT_EQ(header.payload_offset % header.alignment, 0u);
+    EXPECT_EQ(bytes.size(), header.payload_offset + 3 * sizeof(Sample));
+}
+
+TEST_F(SerializationTest, FromBufferViewsThePayloadInPlace) {
+    Vector<std::uint64_t> original;
+    for (std::uint64_t i = 0; i < 500; ++i) {
+        original.push_back(i * i);
+    }
+    vector_io::write_to(fd, original);
+    const auto bytes = slurp(fd); // std::vector storage is suitably aligned for uint64_t
+
+    const auto view = vector_io::from_buffer<std::uint64_t>(bytes);
+    ASSERT_EQ(view.size(), 500u);
+    EXPECT_EQ(static_cast<const void*>(view.data()), static_cast<const void*>(bytes.data() + sizeof(vector_io::Header) + 32));
+    EXPECT_EQ(view[499], 499u * 499u);
+
+    EXPECT_THROW(vector_io::from_buffer<std::uint64_t>(std::span(bytes).first(bytes.size() - 1)), vector_io::FormatError);
+    EXPECT_THROW(vector_io::from_buffer<std::uint32_t>(bytes), vector_io::FormatError);
+}
+
+TEST_F(SerializationTest, StreamsThroughAPipe) {
+    int pipe_fds[2];
+    ASSERT_EQ(::pipe(pipe_fds), 0);
+    const auto original = make_samples(20000); // larger than a pipe buffer, so writes are partial
+
+    std::thread writer([&] {
+        vector_io::write_to(pipe_fds[1], original);
+        ::close(pipe_fds[1]);
+    });
+    const auto loaded = vector_io::read_from<Sample>(pipe_fds[0]);
+    writer.join();
+    ::close(pipe_fds[0]);
+
+    ASSERT_EQ(loaded.size(), original.size());
+    EXPECT_EQ(loaded[19999].id, 19999u);
+    EXPECT_EQ(loaded[19999].score, 39998.0);
+}
+
+TEST_F(SerializationTest, RejectsMismatchedOrTruncatedInput) {
+    vector_io::write_to(fd, make_samples(10));
+    ::lseek(fd, 0, SEEK_SET);
+    EXPECT_THROW(vector_io::read_from<std::uint64_t>(fd), vector_io::FormatError);
+
+    ASSERT_EQ(::ftruncate(fd, static_cast<off_t>(vector_io::serialized_size<Sample>(10) - 1)), 0);
+    ::lseek(fd, 0, SEEK_SET);
+    EXPECT_THROW(vector_io::read_from<Sample>(fd), vector_io::FormatError);
+
+    const std::byte garbage[64] = {};
+    EXPECT_THROW(vector_io::from_buffer<Sample>(garbage), vector_io::FormatError);
+}
+
+TEST_F(SerializationTest, ForgedCountFailsWithoutAllocatingIt) {
+    vector_io::write_to(fd, make_samples(4));
+    const auto bytes = slurp(fd);
+    vector_io::Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    header.count = std::uint64_t{1} << 56; // 2^60 bytes of Sample
+    ASSERT_EQ(::pwrite(fd, &header, sizeof(header), 0), static_cast<ssize_t>(sizeof(header)));
+    EXPECT_THROW(vector_io::read_from<Sample>(fd), vector_io::FormatError);
+}
+
+TEST_F(SerializationTest, PayloadsPastTheTrustedSizeArriveInChunks) {
+    const std::size_t count = vector_io::trusted_read_bytes / sizeof(std::uint64_t) * 3 + 5;
+    Vector<std::uint64_t> original;
+    original.resize_for_overwrite(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        original[i] = i * 7;
+    }
+    vector_io::write_to(fd, original);
+    ::lseek(fd, 0, SEEK_SET);
+    const auto loaded = vector_io::read_from<std::uint64_t>(fd);
+    ASSERT_EQ(loaded.size(), count);
+    EXPECT_EQ(std::memcmp(loaded.data(), original.data(), count * sizeof(std::uint64_t)), 0);
+
+    ASSERT_EQ(::ftruncate(fd, static_cast<off_t>(vector_io::serialized_size<std::uint64_t>(count) - 8)), 0);
+    ::lseek(fd, 0, SEEK_SET);
+    EXPECT_THROW(vector_io::read_from<std::uint64_t>(fd), vector_io::FormatError);
+}
+
+TEST_F(SerializationTest, ReportsForeignByteOrder) {
+    vector_io::write_to(fd, make_samples(2));
+    auto bytes = slurp(fd);
+    vector_io::Header header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    // what a writer of the other byte order puts in the first field
+    header.magic = std::byteswap(header.magic);
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    try {
+        (void)vector_io::from_buffer<Sample>(bytes);
+        FAIL() << "expected FormatError";
+    } catch (const vector_io::FormatError& error) {
+        EXPECT_NE(std::string(error.what()).find("byte order"), std::string::npos) << error.what();
+    }
+}
+
+TEST_F(SerializationTest, EmptyVectorRoundTrips) {
+    vector_io::write_to(fd, Vector<int>());
+    ::lseek(fd, 0, SEEK_SET);
+    EXPECT_TRUE(vector_io::read_from<int>(fd).empty());
+}
+} // namespace
+#endif
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "../VectorSimd.h"
+
+namespace {
+// Instruction sets this machine can run, so every compiled table is checked against scalar.
+std::vector<simd::Isa> runnable_isas()
+{
+    std::vector<simd::Isa> isas;
+    for (simd::Isa isa : {simd::Isa::sse2, simd::Isa::neon, simd::Isa::avx2, simd::Isa::avx512}) {
+        if (simd::supported(isa)) isas.push_back(isa);
+    }
+    return isas;
+}
+
+template <typename T>
+Vector<T> make_values(std::size_t count, int seed)
+{
+    Vector<T> vec;
+    for (std::size_t i = 0; i < count; ++i) {
+        const int pattern = static_cast<int>((i * 37 + static_cast<std::size_t>(seed) * 11) % 23) - 11;
+        vec.push_back(static_cast<T>(pattern));
+    }
+    return vec;
+}
+
+template <typename T>
+void expect_same(T actual, T expected)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        EXPECT_NEAR(actual, expected, std::abs(expected) * 1e-5 + 1e-5);
+    } else {
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+// Runs every kernel of every runnable table over odd sizes and misaligned starts.
+template <typename T>
+void check_kernels_match_scalar()
+{
+    const auto& scalar = simd::detail::kernels_for<T>(simd::Isa::scalar);
+    for (simd::Isa isa : runnable_isas()) {
+        SCOPED_TRACE(simd::isa_name(isa));
+        const auto& table = simd::detail::kernels_for<T>(isa);
+        for (std::size_t n : {0u, 1u, 7u, 16u, 63u, 64u, 65u, 257u, 1000u}) {
+            for (std::size_t offset : {0u, 1u, 3u}) {
+                const auto a = make_values<T>(n + offset, 1);
+                const auto b = make_values<T>(n + offset, 2);
+                const T* pa = a.data() + offset;
+                const T* pb = b.data() + offset;
+
+                expect_same(table.sum(pa, n), scalar.sum(pa, n));
+                expect_same(table.dot(pa, pb, n), scalar.dot(pa, pb, n));
+                if (n > 0) {
+                    EXPECT_EQ(table.minmax(pa, n), scalar.minmax(pa, n));
+                    EXPECT_EQ(table.find(pa, n, pa[n - 1]), scalar.find(pa, n, pa[n - 1]));
+                }
+                EXPECT_EQ(table.find(pa, n, static_cast<T>(100)), n);
+                EXPECT_EQ(table.count(pa, n, static_cast<T>(3)), scalar.count(pa, n, static_cast<T>(3)));
+
+                Vector<T> expected(b);
+                Vector<T> actual(b);
+                scalar.axpy(static_cast<T>(3), pa, expected.data() + offset, n);
+                table.axpy(static_cast<T>(3), pa, actual.data() + offset, n);
+                for (std::size_t i = 0; i < actual.size(); ++i) {
+                    expect_same(actual[i], expected[i]);
+                }
+
+                scalar.add(pa, pb, expected.data() + offset, n);
+                table.add(pa, pb, actual.data() + offset, n);
+                for (std::size_t i = 0; i < actual.size(); ++i) {
+                    expect_same(actual[i], expected[i]);
+                }
+
+                scalar.mul(pa, pb, expected.data() + offset, n);
+                table.mul(pa, pb, actual.data() + offset, n);
+                for (std::size_t i = 0; i < actual.size(); ++i) {
+                    expect_same(actual[i], expected[i]);
+                }
+            }
+        }
+    }
+}
+
+TEST(VectorSimdTest, FloatKernelsMatchScalar) {
+    check_kernels_match_scalar<float>();
+}
+
+TEST(VectorSimdTest, DoubleKernelsMatchScalar) {
+    check_kernels_match_scalar<double>();
+}
+
+TEST(VectorSimdTest, IntegerKernelsMatchScalar) {
+    check_kernels_match_scalar<std::int32_t>();
+    check_kernels_match_scalar<std::uint64_t>();
+    check_kernels_match_scalar<std::int16_t>();
+}
+
+TEST(VectorSimdTest, ByteCountsDrainBeforeLaneOverflow) {
+    check_kernels_match_scalar<std::int8_t>();
+
+    Vector<std::uint8_t> bytes;
+    bytes.assign(100000, 7);
+    EXPECT_EQ(simd::count(bytes, 7), 100000u);
+}
+
+TEST(VectorSimdTest, FreeFunctionsOperateOnVector) {
+    Vector<float> a = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+    Vector<float> b = {5.0f, 4.0f, 3.0f, 2.0f, 1.0f};
+
+    EXPECT_FLOAT_EQ(simd::sum(a), 15.0f);
+    EXPECT_FLOAT_EQ(simd::dot(a, b), 35.0f);
+    EXPECT_FLOAT_EQ(simd::min(b), 1.0f);
+    EXPECT_FLOAT_EQ(simd::max(b), 5.0f);
+    EXPECT_EQ(simd::find(a, 3.0f), a.begin() + 2);
+    EXPECT_EQ(simd::find(a, 9.0f), a.end());
+    EXPECT_EQ(simd::count(a, 3.0f), 1u);
+
+    Vector<float> out;
+    simd::add(a, b, out);
+    ASSERT_EQ(out.size(), 5u);
+    EXPECT_FLOAT_EQ(out[0], 6.0f);
+
+    simd::mul(a, b, out);
+    EXPECT_FLOAT_EQ(out[1], 8.0f);
+
+    simd::axpy(2.0f, a, b);
+    EXPECT_FLOAT_EQ(b[0], 7.0f);
+    EXPECT_FLOAT_EQ(b[4], 11.0f);
+}
+
+TEST(VectorSimdTest, IntegerSumsWrapInElementType) {
+    Vector<std::uint8_t> bytes;
+    bytes.assign(300, 1);
+    EXPECT_EQ(simd::sum(bytes), static_cast<std::uint8_t>(300 % 256));
+}
+
+TEST(VectorSimdTest, RejectsEmptyAndMismatchedInputs) {
+    Vector<int> empty;
+    Vector<int> three = {1, 2, 3};
+    Vector<int> out;
+
+    EXPECT_THROW(simd::min(empty), std::out_of_range);
+    EXPECT_THROW(simd::dot(three, empty), std::invalid_argument);
+    EXPECT_THROW(simd::axpy(1, three, empty), std::invalid_argument);
+    EXPECT_THROW(simd::add(three, empty, out), std::invalid_argument);
+    EXPECT_EQ(simd::sum(empty), 0);
+}
+} // namespace
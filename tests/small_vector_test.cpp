@@ -0,0 +1,358 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include "../Allocator.h"
+#include "../SmallVector.h"
+
+namespace {
+// Allocator that counts how many heap blocks are live.
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    static inline int live_blocks{0};
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) {}
+
+    T* allocate(std::size_t n)
+    {
+        ++live_blocks;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* pointer, std::size_t n)
+    {
+        --live_blocks;
+        std::allocator<T>().deallocate(pointer, n);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const
+    {
+        return true;
+    }
+};
+
+class SmallVectorTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        CountingAllocator<int>::live_blocks = 0;
+        CountingAllocator<std::string>::live_blocks = 0;
+    }
+};
+} // namespace
+
+TEST_F(SmallVectorTest, DefaultConstructedVectorUsesInlineStorage)
+{
+    SmallVector<int, 4> vec;
+
+    EXPECT_TRUE(vec.empty());
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(vec.capacity(), 4u);
+    EXPECT_EQ(vec.begin(), vec.end());
+}
+
+TEST_F(SmallVectorTest, StaysInlineUpToInlineCapacity)
+{
+    SmallVector<int, 4, CountingAllocator<int>> vec;
+    for (int i = 0; i < 4; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(CountingAllocator<int>::live_blocks, 0);
+    EXPECT_EQ(vec.size(), 4u);
+    EXPECT_EQ(vec[3], 3);
+}
+
+TEST_F(SmallVectorTest, SpillsToHeapPastInlineCapacity)
+{
+    {
+        SmallVector<int, 4, CountingAllocator<int>> vec;
+        for (int i = 0; i < 9; ++i) {
+            vec.push_back(i);
+        }
+
+        EXPECT_FALSE(vec.is_inline());
+        EXPECT_EQ(CountingAllocator<int>::live_blocks, 1);
+        EXPECT_GE(vec.capacity(), 9u);
+        for (int i = 0; i < 9; ++i) {
+            EXPECT_EQ(vec[i], i);
+        }
+    }
+    EXPECT_EQ(CountingAllocator<int>::live_blocks, 0);
+}
+
+TEST_F(SmallVectorTest, SpillCopiesAnElementOfItself)
+{
+    const std::string text = "a string too long for the small-string buffer";
+    SmallVector<std::string, 2> vec;
+    vec.push_back(text);
+    vec.push_back("b");
+    vec.push_back(vec[0]);
+    ASSERT_FALSE(vec.is_inline());
+    EXPECT_EQ(vec[0], text);
+    EXPECT_EQ(vec[2], text);
+
+    vec.emplace_back(vec[1]);
+    vec.emplace_back(vec[2]);
+    ASSERT_EQ(vec.size(), 5u);
+    EXPECT_EQ(vec[3], "b");
+    EXPECT_EQ(vec[4], text);
+}
+
+TEST_F(SmallVectorTest, ReserveAndResizeFollowVectorSemantics)
+{
+    SmallVector<std::string, 2> vec;
+    vec.reserve(2);
+    EXPECT_TRUE(vec.is_inline());
+
+    vec.resize(3);
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_EQ(vec.size(), 3u);
+    EXPECT_TRUE(vec[2].empty());
+
+    vec[0] = "kept";
+    vec.resize(1);
+    EXPECT_EQ(vec.size(), 1u);
+    EXPECT_EQ(vec.front(), "kept");
+    EXPECT_THROW(vec.at(1), std::out_of_range);
+}
+
+TEST_F(SmallVectorTest, EmplaceBackReturnsConstructedElement)
+{
+    SmallVector<std::pair<int, std::string>, 2> vec;
+    auto& first = vec.emplace_back(1, "one");
+    EXPECT_EQ(&first, &vec.back());
+    vec.emplace_back(2, "two");
+    auto& third = vec.emplace_back(3, "three");
+
+    EXPECT_EQ(third.second, "three");
+    EXPECT_EQ(vec[0].second, "one");
+}
+
+TEST_F(SmallVectorTest, MoveFromInlineMovesElements)
+{
+    SmallVector<std::string, 4> source;
+    source.push_back("a");
+    source.push_back("b");
+
+    SmallVector<std::string, 4> moved(std::move(source));
+
+    EXPECT_TRUE(moved.is_inline());
+    ASSERT_EQ(moved.size(), 2u);
+    EXPECT_EQ(moved[1], "b");
+    EXPECT_TRUE(source.empty());
+    EXPECT_TRUE(source.is_inline());
+}
+
+TEST_F(SmallVectorTest, MoveFromHeapStealsBuffer)
+{
+    SmallVector<std::string, 2, CountingAllocator<std::string>> source;
+    for (int i = 0; i < 5; ++i) {
+        source.push_back(std::to_string(i));
+    }
+    auto* heap = source.data();
+
+    SmallVector<std::string, 2, CountingAllocator<std::string>> moved(std::move(source));
+
+    EXPECT_EQ(moved.data(), heap);
+    EXPECT_EQ(moved[4], "4");
+    EXPECT_TRUE(source.is_inline());
+    EXPECT_EQ(source.capacity(), 2u);
+    EXPECT_EQ(CountingAllocator<std::string>::live_blocks, 1);
+}
+
+TEST_F(SmallVectorTest, MoveAssignmentReleasesPreviousHeapBuffer)
+{
+    SmallVector<int, 2, CountingAllocator<int>> target;
+    for (int i = 0; i < 5; ++i) {
+        target.push_back(i);
+    }
+    SmallVector<int, 2, CountingAllocator<int>> source;
+    source.push_back(42);
+
+    target = std::move(source);
+
+    EXPECT_TRUE(target.is_inline());
+    ASSERT_EQ(target.size(), 1u);
+    EXPECT_EQ(target[0], 42);
+    EXPECT_EQ(CountingAllocator<int>::live_blocks, 0);
+}
+
+TEST_F(SmallVectorTest, CopyProducesIndependentVector)
+{
+    SmallVector<std::string, 2> source;
+    source.push_back("x");
+    source.push_back("y");
+    source.push_back("z");
+
+    SmallVector<std::string, 2> copy(source);
+    source[0] = "changed";
+
+    ASSERT_EQ(copy.size(), 3u);
+    EXPECT_EQ(copy[0], "x");
+    EXPECT_NE(copy.data(), source.data());
+
+    SmallVector<std::string, 2> assigned;
+    assigned.push_back("old");
+    assigned = copy;
+    EXPECT_EQ(assigned.size(), 3u);
+    EXPECT_EQ(assigned[2], "z");
+}
+
+TEST_F(SmallVectorTest, SwapHandlesEveryStorageCombination)
+{
+    SmallVector<std::string, 2> inline_a;
+    inline_a.push_back("ia");
+    SmallVector<std::string, 2> heap_b;
+    for (int i = 0; i < 3; ++i) {
+        heap_b.push_back("hb" + std::to_string(i));
+    }
+    auto* heap_b_data = heap_b.data();
+
+    inline_a.swap(heap_b);
+    EXPECT_EQ(inline_a.data(), heap_b_data);
+    ASSERT_EQ(inline_a.size(), 3u);
+    EXPECT_EQ(inline_a[2], "hb2");
+    EXPECT_TRUE(heap_b.is_inline());
+    ASSERT_EQ(heap_b.size(), 1u);
+    EXPECT_EQ(heap_b[0], "ia");
+
+    SmallVector<std::string, 2> inline_c;
+    inline_c.push_back("c0");
+    inline_c.push_back("c1");
+    heap_b.swap(inline_c);
+    EXPECT_EQ(heap_b.size(), 2u);
+    EXPECT_EQ(heap_b[1], "c1");
+    EXPECT_EQ(inline_c.size(), 1u);
+    EXPECT_EQ(inline_c[0], "ia");
+
+    SmallVector<std::string, 2> heap_d;
+    for (int i = 0; i < 4; ++i) {
+        heap_d.push_back("hd" + std::to_string(i));
+    }
+    auto* heap_d_data = heap_d.data();
+    std::swap(inline_a, heap_d);
+    EXPECT_EQ(inline_a.data(), heap_d_data);
+    EXPECT_EQ(heap_d.data(), heap_b_data);
+}
+
+TEST_F(SmallVectorTest, SwapOfInlineVectorsExchangesElementsInPlace)
+{
+    static_assert(std::is_nothrow_swappable_v<SmallVector<std::string, 4>>);
+    SmallVector<std::string, 4> three;
+    SmallVector<std::string, 4> one;
+    for (int i = 0; i < 3; ++i) {
+        three.push_back("t" + std::to_string(i));
+    }
+    one.push_back("o0");
+
+    swap(three, one);
+    EXPECT_TRUE(three.is_inline());
+    EXPECT_TRUE(one.is_inline());
+    ASSERT_EQ(three.size(), 1u);
+    EXPECT_EQ(three[0], "o0");
+    ASSERT_EQ(one.size(), 3u);
+    EXPECT_EQ(one[2], "t2");
+
+    SmallVector<int, 4> ints;
+    SmallVector<int, 4> more;
+    ints.push_back(1);
+    more.push_back(2);
+    more.push_back(3);
+    ints.swap(more);
+    ASSERT_EQ(ints.size(), 2u);
+    EXPECT_EQ(ints[1], 3);
+    ASSERT_EQ(more.size(), 1u);
+    EXPECT_EQ(more[0], 1);
+}
+
+// Element whose copies throw once copies_left runs out.
+struct ThrowingCopy {
+    static inline int copies_left = 0;
+
+    ThrowingCopy() = default;
+    ThrowingCopy(const ThrowingCopy&)
+    {
+        if (copies_left-- == 0) throw std::runtime_error("copy failed");
+    }
+};
+
+TEST_F(SmallVectorTest, ThrowingCopyConstructionFreesTheSpilledBuffer)
+{
+    SmallVector<ThrowingCopy, 2, CountingAllocator<ThrowingCopy>> vec;
+    vec.resize(5);
+    ASSERT_EQ(CountingAllocator<ThrowingCopy>::live_blocks, 1);
+
+    ThrowingCopy::copies_left = 3;
+    using Copy = SmallVector<ThrowingCopy, 2, CountingAllocator<ThrowingCopy>>;
+    EXPECT_THROW(Copy{vec}, std::runtime_error);
+    EXPECT_EQ(CountingAllocator<ThrowingCopy>::live_blocks, 1);
+}
+
+TEST_F(SmallVectorTest, MoveAssignmentIsNoexceptOnlyWhenItCannotAllocate)
+{
+    static_assert(std::is_nothrow_move_assignable_v<SmallVector<std::string, 2>>);
+    // unequal polymorphic allocators do not propagate, so the elements move into a new buffer
+    static_assert(!std::is_nothrow_move_assignable_v<SmallVector<int, 2, std::pmr::polymorphic_allocator<int>>>);
+}
+
+TEST_F(SmallVectorTest, MoveOnlyElementsAreSupported)
+{
+    SmallVector<std::unique_ptr<int>, 2> vec;
+    for (int i = 0; i < 5; ++i) {
+        vec.push_back(std::make_unique<int>(i));
+    }
+
+    SmallVector<std::unique_ptr<int>, 2> moved(std::move(vec));
+    EXPECT_EQ(*moved[4], 4);
+
+    vec.emplace_back(std::make_unique<int>(9));
+    moved.swap(vec);
+    EXPECT_EQ(moved.size(), 1u);
+    EXPECT_EQ(*vec[0], 0);
+}
+
+TEST_F(SmallVectorTest, IteratorsCoverElements)
+{
+    SmallVector<int, 3> vec;
+    vec.push_back(4);
+    vec.push_back(8);
+    vec.push_back(15);
+
+    int sum = 0;
+    for (int value : vec) {
+        sum += value;
+    }
+    EXPECT_EQ(sum, 27);
+
+    const auto& cvec = vec;
+    EXPECT_EQ(*cvec.cbegin(), 4);
+}
+
+TEST_F(SmallVectorTest, InlineBufferHonoursAllocatorAlignment)
+{
+    using Aligned = SmallVector<float, 4, AlignedAllocator<float, 64>>;
+    static_assert(Aligned::alignment == 64);
+
+    Aligned vec;
+    vec.push_back(1.0f);
+    EXPECT_TRUE(vec.is_inline());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % 64, 0u);
+
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(static_cast<float>(i));
+    }
+    EXPECT_FALSE(vec.is_inline());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vec.data()) % 64, 0u);
+}
@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include "../SoAVector.h"
+
+namespace {
+using Particles = SoAVector<float, float, std::uint8_t, std::string>;
+
+static_assert(std::random_access_iterator<Particles::iterator>);
+
+Particles make_particles(int count)
+{
+    Particles particles;
+    for (int i = 0; i < count; ++i) {
+        particles.emplace_back(static_cast<float>(i), static_cast<float>(2 * i), static_cast<std::uint8_t>(i % 256),
+                               "p" + std::to_string(i));
+    }
+    return particles;
+}
+
+TEST(SoAVectorTest, ColumnsAreContiguousAndAligned) {
+    Particles particles = make_particles(1000);
+    ASSERT_EQ(particles.size(), 1000u);
+
+    auto xs = particles.column<0>();
+    auto ys = particles.column<1>();
+    std::span<std::uint8_t> tags = particles.column<2>();
+    EXPECT_EQ(xs.size(), 1000u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(xs.data()) % Particles::column_alignment, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ys.data()) % Particles::column_alignment, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(tags.data()) % Particles::column_alignment, 0u);
+
+    EXPECT_FLOAT_EQ(std::accumulate(xs.begin(), xs.end(), 0.0f), 999.0f * 1000.0f / 2.0f);
+    EXPECT_FLOAT_EQ(ys[10], 20.0f);
+    EXPECT_EQ(tags[300], 300 % 256);
+    EXPECT_EQ(particles.column<3>()[999], "p999");
+}
+
+TEST(SoAVectorTest, RowsReadAndWriteThroughReferences) {
+    Particles particles = make_particles(3);
+    auto [x, y, tag, name] = particles[1];
+    EXPECT_FLOAT_EQ(x, 1.0f);
+    y = 42.0f;
+    name += "!";
+    EXPECT_FLOAT_EQ(particles.column<1>()[1], 42.0f);
+    EXPECT_EQ(std::get<3>(particles.at(1)), "p1!");
+    EXPECT_THROW(particles.at(3), std::out_of_range);
+
+    particles.push_back({7.0f, 8.0f, 9, "seven"});
+    EXPECT_EQ(std::get<3>(particles.back()), "seven");
+    particles.pop_back();
+    EXPECT_EQ(particles.size(), 3u);
+    EXPECT_EQ(std::get<3>(particles.front()), "p0");
+}
+
+TEST(SoAVectorTest, RowIteratorWalksEveryRow) {
+    Particles particles = make_particles(100);
+    float sum = 0.0f;
+    for (auto [x, y, tag, name] : particles) {
+        sum += y - x;
+        tag = 1;
+    }
+    EXPECT_FLOAT_EQ(sum, 99.0f * 100.0f / 2.0f);
+    EXPECT_TRUE(std::ranges::all_of(particles.column<2>(), [](std::uint8_t tag) { return tag == 1; }));
+
+    const Particles& view = particles;
+    auto it = std::find_if(view.begin(), view.end(), [](const auto& row) { return std::get<3>(row) == "p42"; });
+    EXPECT_EQ(it - view.begin(), 42);
+    EXPECT_FLOAT_EQ(std::get<0>(it[1]), 43.0f);
+}
+
+TEST(SoAVectorTest, GrowthMovesEveryColumn) {
+    SoAVector<std::unique_ptr<int>, double, std::string> rows;
+    for (int i = 0; i < 500; ++i) {
+        rows.emplace_back(std::make_unique<int>(i), i * 0.5, std::string(20, static_cast<char>('a' + i % 26)));
+    }
+    for (int i = 0; i < 500; ++i) {
+        auto [owner, half, text] = rows[i];
+        EXPECT_EQ(*owner, i);
+        EXPECT_DOUBLE_EQ(half, i * 0.5);
+        EXPECT_EQ(text, std::string(20, static_cast<char>('a' + i % 26)));
+    }
+
+    rows.resize(10);
+    EXPECT_EQ(rows.size(), 10u);
+    rows.resize(12);
+    EXPECT_EQ(std::get<0>(rows[11]), nullptr);
+    EXPECT_EQ(std::get<2>(rows[11]), "");
+}
+
+TEST(SoAVectorTest, CopyMoveAndCompare) {
+    Particles particles = make_particles(50);
+    Particles copy = particles;
+    EXPECT_EQ(copy, particles);
+
+    std::get<3>(copy[10]) = "changed";
+    EXPECT_FALSE(copy == particles);
+
+    Particles moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(std::get<3>(moved[10]), "changed");
+
+    moved = particles;
+    EXPECT_EQ(moved, particles);
+    moved.clear();
+    EXPECT_TRUE(moved.empty());
+    EXPECT_GE(moved.capacity(), 50u);
+}
+
+struct ThrowingCopy {
+    static inline bool armed = false;
+
+    ThrowingCopy() = default;
+    ThrowingCopy(const ThrowingCopy&)
+    {
+        if (armed) throw std::runtime_error("copy");
+    }
+    ThrowingCopy& operator=(const ThrowingCopy&) = default;
+};
+
+TEST(SoAVectorTest, ThrowingGrowthLeavesContainerIntact) {
+    SoAVector<std::string, ThrowingCopy> rows;
+    rows.reserve(4);
+    for (int i = 0; i < 4; ++i) {
+        rows.emplace_back(std::to_string(i), ThrowingCopy());
+    }
+
+    ThrowingCopy::armed = true;
+    EXPECT_THROW(rows.reserve(100), std::runtime_error);
+    EXPECT_THROW(rows.emplace_back("4", ThrowingCopy()), std::runtime_error);
+    ThrowingCopy::armed = false;
+
+    EXPECT_EQ(rows.size(), 4u);
+    EXPECT_EQ(rows.capacity(), 4u);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(std::get<0>(rows[i]), std::to_string(i));
+    }
+}
+
+TEST(SoAVectorTest, ThrowingCopyConstructionFreesWhatItBuilt) {
+    SoAVector<std::string, ThrowingCopy> rows;
+    for (int i = 0; i < 4; ++i) {
+        rows.emplace_back("a string too long for the small-string buffer " + std::to_string(i), ThrowingCopy());
+    }
+    // the block and its strings would show up as leaks under LeakSanitizer
+    ThrowingCopy::armed = true;
+    using Rows = SoAVector<std::string, ThrowingCopy>;
+    EXPECT_THROW(Rows{rows}, std::runtime_error);
+    ThrowingCopy::armed = false;
+    EXPECT_EQ(rows.size(), 4u);
+}
+
+TEST(SoAVectorTest, EmplaceBackOfItsOwnRowSurvivesGrowth) {
+    const std::string text = "a string too long for the small-string buffer";
+    SoAVector<std::string, int> rows;
+    rows.emplace_back(text, 7);
+    for (int i = 0; i < 100; ++i) {
+        rows.emplace_back(std::get<0>(rows[0]), std::get<1>(rows[i]));
+    }
+    ASSERT_EQ(rows.size(), 101u);
+    for (const auto& [name, value] : rows) {
+        EXPECT_EQ(name, text);
+        EXPECT_EQ(value, 7);
+    }
+}
+} // namespace
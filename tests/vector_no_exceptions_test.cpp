@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "../Vector.h"
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS)
+#error "vector_no_exceptions_test.cpp must be built with -fno-exceptions"
+#endif
+
+namespace {
+// Allocator whose try_allocate() returns nullptr once it has handed out budget elements.
+template <typename T>
+struct NothrowBudgetAllocator {
+    using value_type = T;
+
+    static inline std::size_t budget{0};
+
+    NothrowBudgetAllocator() = default;
+
+    template <typename U>
+    NothrowBudgetAllocator(const NothrowBudgetAllocator<U>&) {}
+
+    T* allocate(std::size_t n)
+    {
+        return std::allocator<T>().allocate(n);
+    }
+
+    T* try_allocate(std::size_t n) noexcept
+    {
+        if (n > budget) return nullptr;
+        budget -= n;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* pointer, std::size_t n)
+    {
+        std::allocator<T>().deallocate(pointer, n);
+    }
+
+    template <typename U>
+    bool operator==(const NothrowBudgetAllocator<U>&) const
+    {
+        return true;
+    }
+};
+} // namespace
+
+TEST(VectorNoExceptionsTest, EditsElementsWithoutExceptionSupport)
+{
+    Vector<std::string> vec{"b", "d"};
+    vec.insert(vec.begin(), "a");
+    vec.emplace(vec.begin() + 2, "c");
+    vec.resize(5);
+    vec.back() = "e";
+    Vector<std::string> copy = vec;
+    copy.erase(copy.begin());
+    EXPECT_EQ(vec.size(), 5u);
+    EXPECT_EQ(vec.at(2), "c");
+    EXPECT_EQ(copy.front(), "b");
+    EXPECT_EQ(copy.back(), "e");
+}
+
+TEST(VectorNoExceptionsTest, TryMembersReportAllocationFailure)
+{
+    Vector<int> vec;
+    EXPECT_EQ(vec.try_reserve(vec.max_size() + 1).error(), AllocError::capacity_overflow);
+    ASSERT_TRUE(vec.try_reserve(16).has_value());
+    EXPECT_EQ(vec.try_push_back(1)->get(), 1);
+
+    using Alloc = NothrowBudgetAllocator<std::string>;
+    Alloc::budget = 2;
+    Vector<std::string, Alloc> bounded;
+    ASSERT_TRUE(bounded.try_reserve(2).has_value());
+    ASSERT_TRUE(bounded.try_emplace_back("one").has_value());
+    ASSERT_TRUE(bounded.try_emplace_back("two").has_value());
+    const auto third = bounded.try_emplace_back("three");
+    ASSERT_FALSE(third.has_value());
+    EXPECT_EQ(third.error(), AllocError::out_of_memory);
+    EXPECT_EQ(bounded.size(), 2u);
+    EXPECT_EQ(bounded[1], "two");
+}
+
+TEST(VectorNoExceptionsDeathTest, AtAbortsOnAnOutOfRangeIndex)
+{
+    const Vector<int> vec{1, 2, 3};
+    EXPECT_DEATH((void)vec.at(3), "index out of range");
+}
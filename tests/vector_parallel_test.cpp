@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include "../VectorParallel.h"
+
+namespace {
+// Options that force the parallel path on a small private pool.
+ParallelOptions small_chunks(ThreadPool& pool)
+{
+    ParallelOptions options;
+    options.pool = &pool;
+    options.serial_threshold = 0;
+    options.min_chunk = 16;
+    return options;
+}
+
+Vector<std::uint64_t> make_sequence(std::size_t count)
+{
+    Vector<std::uint64_t> vec;
+    vec.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        vec.push_back(i);
+    }
+    return vec;
+}
+
+class VectorParallelTest : public ::testing::Test {
+protected:
+    ThreadPool pool{3};
+};
+
+TEST_F(VectorParallelTest, PoolRunsEveryIndexExactlyOnce) {
+    std::vector<std::atomic<int>> hits(1000);
+    pool.run(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+TEST_F(VectorParallelTest, PoolRethrowsTheFirstException) {
+    EXPECT_THROW(pool.run(100, [](std::size_t i) {
+        if (i == 42) throw std::runtime_error("chunk failed");
+    }), std::runtime_error);
+
+    // the pool stays usable afterwards
+    std::atomic<int> calls{0};
+    pool.run(10, [&](std::size_t) { calls.fetch_add(1); });
+    EXPECT_EQ(calls.load(), 10);
+}
+
+TEST_F(VectorParallelTest, NestedRunsExecuteSerially) {
+    std::atomic<int> calls{0};
+    pool.run(8, [&](std::size_t) {
+        pool.run(8, [&](std::size_t) { calls.fetch_add(1); });
+    });
+    EXPECT_EQ(calls.load(), 64);
+}
+
+TEST_F(VectorParallelTest, ChunkBoundariesFallOnCacheLines) {
+    auto vec = make_sequence(10000);
+    const std::uint64_t* base = vec.data() + 3; // deliberately misaligned start
+    const parallel_detail::ChunkPlan plan(base, sizeof(std::uint64_t), 9997, 16, 1);
+
+    EXPECT_EQ(plan.begin(0), 0u);
+    EXPECT_EQ(plan.end(plan.count() - 1), 9997u);
+    for (std::size_t i = 1; i < plan.count(); ++i) {
+        EXPECT_EQ(plan.begin(i), plan.end(i - 1));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(base + plan.begin(i)) % parallel_detail::cache_line, 0u);
+    }
+}
+
+TEST_F(VectorParallelTest, ChunkBoundariesFallOnCacheLinesForAnyElementSize) {
+    alignas(64) static std::byte buffer[1 << 16];
+    for (const std::size_t element_size : {4u, 12u, 24u, 48u, 80u, 96u}) {
+        for (std::size_t offset = 0; offset < 64; offset += 4) {
+            const std::size_t total = (sizeof(buffer) - offset) / element_size;
+            const parallel_detail::ChunkPlan plan(buffer + offset, element_size, total, 16, 1);
+            ASSERT_GT(plan.count(), 1u);
+            EXPECT_EQ(plan.end(plan.count() - 1), total);
+            for (std::size_t i = 1; i < plan.count(); ++i) {
+                ASSERT_EQ(plan.begin(i), plan.end(i - 1));
+                if (offset % std::gcd(element_size, std::size_t{64}) == 0) {
+                    // some element then starts on a line, so every inner boundary does
+                    ASSERT_EQ((offset + plan.begin(i) * element_size) % 64, 0u) << element_size << " " << offset;
+                }
+            }
+        }
+    }
+}
+
+TEST_F(VectorParallelTest, ForEachVisitsEveryElement) {
+    auto vec = make_sequence(5000);
+    parallel_for_each(vec, [](std::uint64_t& value) { value *= 2; }, small_chunks(pool));
+
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], 2 * i);
+    }
+}
+
+TEST_F(VectorParallelTest, TransformResizesAndFillsTheOutput) {
+    const auto input = make_sequence(5000);
+    Vector<float> output;
+    parallel_transform(input, output, [](std::uint64_t value) { return static_cast<float>(value) + 0.5f; },
+                       small_chunks(pool));
+
+    ASSERT_EQ(output.size(), input.size());
+    for (std::size_t i = 0; i < output.size(); ++i) {
+        EXPECT_FLOAT_EQ(output[i], static_cast<float>(i) + 0.5f);
+    }
+}
+
+TEST_F(VectorParallelTest, ReduceMatchesSerialSum) {
+    const auto vec = make_sequence(100000);
+    const std::uint64_t expected = 100000ull * 99999ull / 2;
+
+    EXPECT_EQ(parallel_reduce(vec, std::uint64_t{0}, std::plus<>{}, small_chunks(pool)), expected);
+    EXPECT_EQ(parallel_reduce(vec, std::uint64_t{0}), expected); // serial path on the shared pool
+}
+
+TEST_F(VectorParallelTest, ReduceKeepsLeftToRightOrderForNonCommutativeOps) {
+    Vector<std::string> words;
+    for (int i = 0; i < 200; ++i) {
+        words.push_back(std::string(1, static_cast<char>('a' + i % 26)));
+    }
+    std::string expected;
+    for (const auto& word : words) {
+        expected += word;
+    }
+
+    EXPECT_EQ(parallel_reduce(words, std::string{}, std::plus<>{}, small_chunks(pool)), expected);
+}
+
+TEST_F(VectorParallelTest, SortOrdersLargeShuffledInput) {
+    auto vec = make_sequence(50000);
+    std::shuffle(vec.begin(), vec.end(), std::mt19937_64(7));
+
+    parallel_sort(vec, std::less<>{}, small_chunks(pool));
+
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+    EXPECT_EQ(vec.front(), 0u);
+    EXPECT_EQ(vec.back(), 49999u);
+}
+
+TEST_F(VectorParallelTest, SortHonorsComparatorAndMoveOnlyElements) {
+    Vector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 3000; ++i) {
+        vec.push_back(std::make_unique<int>((i * 7919) % 3000));
+    }
+
+    parallel_sort(vec, [](const auto& a, const auto& b) { return *a > *b; }, small_chunks(pool));
+
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(*vec[i], static_cast<int>(vec.size() - 1 - i));
+    }
+}
+
+TEST_F(VectorParallelTest, ZeroWorkerPoolRunsOnTheCaller) {
+    ThreadPool serial(0);
+    EXPECT_EQ(serial.concurrency(), 1u);
+
+    auto vec = make_sequence(1000);
+    std::reverse(vec.begin(), vec.end());
+    parallel_sort(vec, std::less<>{}, small_chunks(serial));
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+}
+
+TEST_F(VectorParallelTest, ResizeFillsTheNewTailOnThePool) {
+    auto vec = make_sequence(100);
+    parallel_resize(vec, 50000, std::uint64_t{7}, small_chunks(pool));
+
+    ASSERT_EQ(vec.size(), 50000u);
+    EXPECT_EQ(vec[99], 99u);
+    EXPECT_TRUE(std::all_of(vec.begin() + 100, vec.end(), [](std::uint64_t value) { return value == 7; }));
+
+    parallel_resize(vec, 10, std::uint64_t{0}, small_chunks(pool));
+    EXPECT_EQ(vec.size(), 10u);
+    EXPECT_EQ(vec[9], 9u);
+
+    // an element that lives in the buffer being replaced is copied before it moves
+    parallel_resize(vec, 40000, vec[3], small_chunks(pool));
+    EXPECT_EQ(vec.back(), 3u);
+}
+} // namespace
@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <source_location>
+#include <string>
+#include "../Vector.h"
+
+#if !defined(VECTOR_STATS)
+#error "vector_stats_test.cpp must be built with VECTOR_STATS defined"
+#endif
+
+namespace {
+// Finds the snapshot of the site on the given line of this file.
+VectorSiteSnapshot site_on_line(std::uint_least32_t line)
+{
+    for (const auto& site : VectorStatsRegistry::instance().snapshot()) {
+        if (site.line == line && site.file == std::source_location::current().file_name()) {
+            return site;
+        }
+    }
+    ADD_FAILURE() << "no site registered for line " << line;
+    return {};
+}
+
+class VectorStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        VectorStatsRegistry::instance().reset();
+    }
+};
+} // namespace
+
+TEST_F(VectorStatsTest, CountsConstructionsPerCallSite)
+{
+    std::uint_least32_t line = 0;
+    for (int i = 0; i < 3; ++i) {
+        line = std::source_location::current().line() + 1;
+        Vector<int> vec;
+    }
+
+    const auto site = site_on_line(line);
+    EXPECT_EQ(site.constructions, 3u);
+    EXPECT_EQ(site.destructions, 3u);
+}
+
+TEST_F(VectorStatsTest, RecordsReallocationsAndBytesMoved)
+{
+    const auto line = std::source_location::current().line() + 1;
+    Vector<std::uint64_t> vec;
+    for (int i = 0; i < 5; ++i) {
+        vec.push_back(i); // capacities 1, 2, 4, 8
+    }
+
+    const auto site = site_on_line(line);
+    EXPECT_EQ(site.reallocations, 3u);
+    EXPECT_EQ(site.bytes_moved, (1 + 2 + 4) * sizeof(std::uint64_t));
+    EXPECT_EQ(site.peak_capacity_bytes, 8 * sizeof(std::uint64_t));
+}
+
+TEST_F(VectorStatsTest, RecordsWastedCapacityAtDestruction)
+{
+    std::uint_least32_t line = 0;
+    {
+        line = std::source_location::current().line() + 1;
+        Vector<char> vec;
+        vec.reserve(100);
+        vec.push_back('x');
+    }
+
+    const auto site = site_on_line(line);
+    EXPECT_EQ(site.wasted_bytes_at_destruction, 99u);
+    EXPECT_EQ(site.reallocations, 0u);
+}
+
+TEST_F(VectorStatsTest, CopiesAreTaggedWithTheirOwnSite)
+{
+    Vector<std::string> original{"a", "b"};
+    const auto line = std::source_location::current().line() + 1;
+    Vector<std::string> copy(original);
+
+    const auto site = site_on_line(line);
+    EXPECT_EQ(site.constructions, 1u);
+    EXPECT_EQ(site.peak_capacity_bytes, 2 * sizeof(std::string));
+}
+
+TEST_F(VectorStatsTest, ForEachVisitsRegisteredSites)
+{
+    Vector<int> vec;
+    vec.push_back(1);
+
+    std::size_t visited = 0;
+    VectorStatsRegistry::instance().for_each([&](const VectorSiteSnapshot& site) {
+        EXPECT_FALSE(site.file.empty());
+        ++visited;
+    });
+    EXPECT_GT(visited, 0u);
+}
@@ -1,6 +1,17 @@
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
 #include <utility>
+#include <vector>
 #include "../Vector.h"
 
 namespace {
@@ -121,6 +132,106 @@ struct ThrowOnCopy {
     }
 };
 
+// Stateful allocator that tags every allocation with an id and counts live blocks.
+template <typename T, bool Propagate>
+struct TaggedAllocator {
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_move_assignment = std::bool_constant<Propagate>;
+    using propagate_on_container_swap = std::bool_constant<Propagate>;
+    using is_always_equal = std::false_type;
+
+    static inline int live_blocks{0};
+
+    int id;
+
+    explicit TaggedAllocator(int tag) : id(tag) {}
+
+    template <typename U>
+    TaggedAllocator(const TaggedAllocator<U, Propagate>& other) : id(other.id) {}
+
+    T* allocate(std::size_t n)
+    {
+        ++live_blocks;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* pointer, std::size_t n)
+    {
+        --live_blocks;
+        std::allocator<T>().deallocate(pointer, n);
+    }
+
+    template <typename U>
+    bool operator==(const TaggedAllocator<U, Propagate>& other) const
+    {
+        return id == other.id;
+    }
+};
+
+// Allocator that fails once it has handed out budget elements in total, either by throwing
+// std::bad_alloc from allocate() or, when Nothrow, by returning nullptr from try_allocate().
+template <typename T, bool Nothrow>
+struct BudgetAllocator {
+    using value_type = T;
+
+    static inline std::size_t budget{0};
+
+    BudgetAllocator() = default;
+
+    template <typename U>
+    BudgetAllocator(const BudgetAllocator<U, Nothrow>&) {}
+
+    T* allocate(std::size_t n)
+    {
+        if (n > budget) throw std::bad_alloc();
+        budget -= n;
+        return std::allocator<T>().allocate(n);
+    }
+
+    T* try_allocate(std::size_t n) noexcept
+        requires Nothrow
+    {
+        if (n > budget) return nullptr;
+        budget -= n;
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* pointer, std::size_t n)
+    {
+        std::allocator<T>().deallocate(pointer, n);
+    }
+
+    template <typename U>
+    bool operator==(const BudgetAllocator<U, Nothrow>&) const
+    {
+        return true;
+    }
+};
+
+// Handle type that opts into trivial relocation while counting its moves and destructions.
+struct RelocatableHandle {
+    static inline unsigned move_ctor_count{0};
+    static inline unsigned dtor_count{0};
+
+    int* resource;
+
+    explicit RelocatableHandle(int v) : resource(new int(v)) {}
+    RelocatableHandle(const RelocatableHandle&) = delete;
+
+    RelocatableHandle(RelocatableHandle&& other) noexcept : resource(other.resource)
+    {
+        other.resource = nullptr;
+        ++move_ctor_count;
+    }
+
+    ~RelocatableHandle()
+    {
+        delete resource;
+        ++dtor_count;
+    }
+};
+
 class VectorTest : public ::testing::Test {
 protected:
     void SetUp() override
@@ -135,6 +246,9 @@ protected:
 };
 } // namespace
 
+template <>
+struct is_trivially_relocatable<RelocatableHandle> : std::true_type {};
+
 // Constructors
 TEST_F(VectorTest, DefaultConstructedVectorIsEmpty)
 {
@@ -177,17 +291,42 @@ TEST_F(VectorTest, ConstSubscriptProvidesConstAccess)
     EXPECT_EQ(const_ref[1], 9);
 }
 
-TEST_F(VectorTest, SubscriptThrowsOnOutOfRangeAccess)
+TEST_F(VectorTest, AtThrowsOnOutOfRangeAccess)
 {
     Vector<int> vec;
     vec.push_back(42);
 
-    EXPECT_THROW(vec[1], std::out_of_range);
+    EXPECT_EQ(vec.at(0), 42);
+    EXPECT_THROW(vec.at(1), std::out_of_range);
 
     const Vector<int>& cvec = vec;
-    EXPECT_THROW(cvec[1], std::out_of_range);
+    EXPECT_EQ(cvec.at(0), 42);
+    EXPECT_THROW(cvec.at(1), std::out_of_range);
 }
 
+TEST_F(VectorTest, SubscriptIsUncheckedInRegularBuilds)
+{
+    Vector<int> vec;
+    vec.reserve(4);
+    vec.push_back(42);
+
+    // no exception path: operator[] compiles to a plain load
+    EXPECT_NO_THROW(static_cast<void>(vec[0]));
+    static_assert(!noexcept(vec.at(0)));
+}
+
+#if defined(VECTOR_HARDENED) && !defined(NDEBUG)
+TEST_F(VectorTest, HardenedAccessAssertsOnBrokenPreconditions)
+{
+    Vector<int> vec;
+    EXPECT_DEATH(static_cast<void>(vec.front()), "front");
+    EXPECT_DEATH(static_cast<void>(vec.back()), "back");
+
+    vec.push_back(1);
+    EXPECT_DEATH(static_cast<void>(vec[1]), "index out of range");
+}
+#endif
+
 // Capacity
 TEST_F(VectorTest, CapacityExpandsAsElementsAreAdded)
 {
@@ -686,3 +825,728 @@ TEST_F(VectorTest, IteratorArrowAccessProvidesMember)
     EXPECT_EQ(cit->x, 1);
     EXPECT_EQ(cit->y, 2);
 }
+
+// Allocator support
+TEST_F(VectorTest, UsesSuppliedAllocatorForStorage)
+{
+    using Alloc = TaggedAllocator<int, true>;
+    Alloc::live_blocks = 0;
+    {
+        Vector<int, Alloc> vec{Alloc(7)};
+        vec.push_back(1);
+        vec.push_back(2);
+        vec.push_back(3);
+
+        EXPECT_EQ(vec.get_allocator().id, 7);
+        EXPECT_EQ(Alloc::live_blocks, 1);
+    }
+    EXPECT_EQ(Alloc::live_blocks, 0);
+}
+
+TEST_F(VectorTest, PropagatingAllocatorFollowsAssignmentAndSwap)
+{
+    using Alloc = TaggedAllocator<int, true>;
+    Vector<int, Alloc> a{Alloc(1)};
+    a.push_back(10);
+    Vector<int, Alloc> b{Alloc(2)};
+    b.push_back(20);
+
+    a = b;
+    EXPECT_EQ(a.get_allocator().id, 2);
+    EXPECT_EQ(a[0], 20);
+
+    Vector<int, Alloc> c{Alloc(3)};
+    c.push_back(30);
+    auto* c_data = c.data();
+    a = std::move(c);
+    EXPECT_EQ(a.get_allocator().id, 3);
+    EXPECT_EQ(a.data(), c_data);
+
+    a.swap(b);
+    EXPECT_EQ(a.get_allocator().id, 2);
+    EXPECT_EQ(b.get_allocator().id, 3);
+    EXPECT_EQ(b[0], 30);
+}
+
+TEST_F(VectorTest, NonPropagatingAllocatorMovesElementsWhenUnequal)
+{
+    using Alloc = TaggedAllocator<AllocCounter, false>;
+    Vector<AllocCounter, Alloc> source{Alloc(1)};
+    source.emplace_back(4);
+    source.emplace_back(5);
+    auto* source_data = source.data();
+
+    Vector<AllocCounter, Alloc> target{Alloc(2)};
+    AllocCounter::reset();
+    target = std::move(source);
+
+    EXPECT_EQ(target.get_allocator().id, 2);
+    EXPECT_NE(target.data(), source_data);
+    ASSERT_EQ(target.size(), 2u);
+    EXPECT_EQ(target[0].value, 4);
+    EXPECT_EQ(target[1].value, 5);
+    EXPECT_EQ(AllocCounter::move_ctor_count, 2u);
+    EXPECT_EQ(AllocCounter::copy_ctor_count, 0u);
+}
+
+TEST_F(VectorTest, AllocatorExtendedMoveConstructorStealsWhenEqual)
+{
+    using Alloc = TaggedAllocator<int, false>;
+    Vector<int, Alloc> source{Alloc(5)};
+    source.push_back(1);
+    auto* data = source.data();
+
+    Vector<int, Alloc> same(std::move(source), Alloc(5));
+    EXPECT_EQ(same.data(), data);
+    EXPECT_EQ(source.size(), 0u);
+
+    Vector<int, Alloc> other(std::move(same), Alloc(6));
+    EXPECT_NE(other.data(), data);
+    EXPECT_EQ(other[0], 1);
+}
+
+// Trivial relocation
+TEST_F(VectorTest, TriviallyRelocatableTraitDefaults)
+{
+    static_assert(is_trivially_relocatable_v<int>);
+    static_assert(is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(is_trivially_relocatable_v<RelocatableHandle>);
+    static_assert(!is_trivially_relocatable_v<AllocCounter>);
+}
+
+TEST_F(VectorTest, ReallocateRelocatesOptedInTypesWithoutMoves)
+{
+    RelocatableHandle::move_ctor_count = 0;
+    RelocatableHandle::dtor_count = 0;
+    {
+        Vector<RelocatableHandle> vec;
+        for (int i = 0; i < 9; ++i) {
+            vec.emplace_back(i);
+        }
+
+        EXPECT_EQ(RelocatableHandle::move_ctor_count, 0u);
+        EXPECT_EQ(RelocatableHandle::dtor_count, 0u);
+        for (int i = 0; i < 9; ++i) {
+            EXPECT_EQ(*vec[i].resource, i);
+        }
+    }
+    EXPECT_EQ(RelocatableHandle::dtor_count, 9u);
+}
+
+TEST_F(VectorTest, UniquePtrElementsSurviveGrowth)
+{
+    Vector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 20; ++i) {
+        vec.push_back(std::make_unique<int>(i));
+    }
+
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_NE(vec[i], nullptr);
+        EXPECT_EQ(*vec[i], i);
+    }
+
+    Vector<std::unique_ptr<int>> moved(std::move(vec));
+    EXPECT_EQ(*moved[19], 19);
+}
+
+TEST_F(VectorTest, TriviallyCopyableCopyMatchesSource)
+{
+    Vector<double> source;
+    for (int i = 0; i < 100; ++i) {
+        source.push_back(i * 0.5);
+    }
+
+    Vector<double> copy(source);
+    ASSERT_EQ(copy.size(), source.size());
+    EXPECT_NE(copy.data(), source.data());
+    for (std::size_t i = 0; i < copy.size(); ++i) {
+        EXPECT_EQ(copy[i], source[i]);
+    }
+}
+
+// Bulk insertion
+TEST_F(VectorTest, RangeConstructorCopiesElementsWithOneAllocation)
+{
+    using Alloc = TaggedAllocator<int, true>;
+    Alloc::live_blocks = 0;
+    const std::vector<int> source{1, 2, 3, 4, 5};
+
+    Vector<int, Alloc> vec(source.begin(), source.end(), Alloc(1));
+
+    ASSERT_EQ(vec.size(), 5u);
+    EXPECT_EQ(vec.capacity(), 5u);
+    EXPECT_EQ(vec[4], 5);
+    EXPECT_EQ(Alloc::live_blocks, 1);
+}
+
+TEST_F(VectorTest, RangeConstructorAcceptsSinglePassIterators)
+{
+    std::istringstream input("3 1 4 1 5");
+    Vector<int> vec{std::istream_iterator<int>(input), std::istream_iterator<int>()};
+
+    ASSERT_EQ(vec.size(), 5u);
+    EXPECT_EQ(vec[2], 4);
+}
+
+TEST_F(VectorTest, InitializerListConstructionAndAssignment)
+{
+    Vector<std::string> vec{"a", "b", "c"};
+    ASSERT_EQ(vec.size(), 3u);
+    EXPECT_EQ(vec[2], "c");
+
+    vec = {"x"};
+    ASSERT_EQ(vec.size(), 1u);
+    EXPECT_EQ(vec[0], "x");
+}
+
+TEST_F(VectorTest, AppendRangeGrowsOnce)
+{
+    using Alloc = TaggedAllocator<int, true>;
+    Alloc::live_blocks = 0;
+    Vector<int, Alloc> vec{Alloc(1)};
+    vec.push_back(0);
+
+    const std::list<int> batch{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    vec.append_range(batch);
+
+    ASSERT_EQ(vec.size(), 11u);
+    for (int i = 0; i < 11; ++i) {
+        EXPECT_EQ(vec[i], i);
+    }
+    EXPECT_EQ(vec.capacity(), 11u);
+    EXPECT_EQ(Alloc::live_blocks, 1);
+}
+
+TEST_F(VectorTest, AppendRangeCopiesNonTrivialElements)
+{
+    Vector<AllocCounter> vec;
+    std::vector<AllocCounter> batch;
+    batch.emplace_back(1);
+    batch.emplace_back(2);
+
+    AllocCounter::reset();
+    vec.append_range(batch);
+
+    ASSERT_EQ(vec.size(), 2u);
+    EXPECT_EQ(vec[1].value, 2);
+    EXPECT_EQ(AllocCounter::copy_ctor_count, 2u);
+}
+
+TEST_F(VectorTest, InsertRangeInMiddleShiftsTail)
+{
+    Vector<int> vec{1, 2, 6, 7};
+    const int middle[] = {3, 4, 5};
+
+    auto pos = vec.begin();
+    ++pos;
+    ++pos;
+    auto it = vec.insert(pos, std::begin(middle), std::end(middle));
+
+    EXPECT_EQ(*it, 3);
+    ASSERT_EQ(vec.size(), 7u);
+    for (int i = 0; i < 7; ++i) {
+        EXPECT_EQ(vec[i], i + 1);
+    }
+}
+
+TEST_F(VectorTest, InsertRangeHandlesNonTrivialElements)
+{
+    Vector<std::string> vec{"a", "d"};
+    vec.reserve(16);
+    const std::vector<std::string> middle{"b", "c"};
+
+    vec.insert(++vec.cbegin(), middle.begin(), middle.end());
+    vec.insert(vec.cend(), {"e", "f"});
+    vec.insert(vec.cbegin(), middle.begin(), middle.begin());
+
+    ASSERT_EQ(vec.size(), 6u);
+    const char* expected[] = {"a", "b", "c", "d", "e", "f"};
+    for (std::size_t i = 0; i < 6; ++i) {
+        EXPECT_EQ(vec[i], expected[i]);
+    }
+}
+
+TEST_F(VectorTest, InsertRangeFromSinglePassIterators)
+{
+    Vector<int> vec{1, 5};
+    std::istringstream input("2 3 4");
+
+    vec.insert(++vec.begin(), std::istream_iterator<int>(input), std::istream_iterator<int>());
+
+    ASSERT_EQ(vec.size(), 5u);
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_EQ(vec[i], i + 1);
+    }
+}
+
+TEST_F(VectorTest, InsertRangeRollsBackWhenCopyThrows)
+{
+    ThrowOnCopy::reset();
+    {
+        Vector<ThrowOnCopy> vec;
+        vec.reserve(8);
+        vec.emplace_back(1);
+        vec.emplace_back(2);
+        std::vector<ThrowOnCopy> more;
+        more.reserve(2);
+        more.emplace_back(3);
+        more.emplace_back(4);
+
+        ThrowOnCopy::throw_on_copy = 1;
+        EXPECT_THROW(vec.append_range(more), CopyError);
+        EXPECT_EQ(vec.size(), 2u);
+        EXPECT_EQ(ThrowOnCopy::live_objects, 4);
+    }
+    EXPECT_EQ(ThrowOnCopy::live_objects, 0);
+    ThrowOnCopy::reset();
+}
+
+TEST_F(VectorTest, AssignReplacesContents)
+{
+    Vector<int> vec{9, 9, 9, 9, 9, 9};
+    const auto capacity = vec.capacity();
+
+    const std::vector<int> shorter{1, 2};
+    vec.assign(shorter.begin(), shorter.end());
+    ASSERT_EQ(vec.size(), 2u);
+    EXPECT_EQ(vec[1], 2);
+    EXPECT_EQ(vec.capacity(), capacity);
+
+    vec.assign(10, 7);
+    ASSERT_EQ(vec.size(), 10u);
+    EXPECT_EQ(vec.capacity(), 10u);
+    EXPECT_EQ(vec[9], 7);
+
+    vec.assign({4, 5, 6});
+    ASSERT_EQ(vec.size(), 3u);
+    EXPECT_EQ(vec[0], 4);
+}
+
+TEST_F(VectorTest, AssignFillFromOwnElement)
+{
+    Vector<std::string> vec{"keep", "drop"};
+    vec.assign(3, vec[0]);
+
+    ASSERT_EQ(vec.size(), 3u);
+    EXPECT_EQ(vec[2], "keep");
+}
+
+// Uninitialized growth
+TEST_F(VectorTest, ResizeForOverwriteKeepsPrefixAndGrows)
+{
+    Vector<char> vec;
+    vec.push_back('a');
+    vec.push_back('b');
+
+    vec.resize_for_overwrite(64);
+    ASSERT_EQ(vec.size(), 64u);
+    EXPECT_EQ(vec[0], 'a');
+    EXPECT_EQ(vec[1], 'b');
+
+    std::memset(vec.data() + 2, 'z', 62);
+    EXPECT_EQ(vec[63], 'z');
+
+    vec.resize_for_overwrite(1);
+    EXPECT_EQ(vec.size(), 1u);
+    EXPECT_EQ(vec[0], 'a');
+}
+
+TEST_F(VectorTest, ResizeForOverwriteDefaultConstructsNonTrivialTypes)
+{
+    Vector<AllocCounter> vec;
+    vec.emplace_back(3);
+
+    AllocCounter::reset();
+    vec.resize_for_overwrite(4);
+
+    ASSERT_EQ(vec.size(), 4u);
+    EXPECT_EQ(vec[0].value, 3);
+    EXPECT_EQ(AllocCounter::default_ctor_count, 3u);
+}
+
+TEST_F(VectorTest, AppendUninitializedReturnsWritableTail)
+{
+    Vector<char> buffer;
+    buffer.push_back('>');
+
+    auto tail = buffer.append_uninitialized(5);
+    ASSERT_EQ(tail.size(), 5u);
+    EXPECT_EQ(tail.data(), buffer.data() + 1);
+    std::memcpy(tail.data(), "hello", 5);
+
+    ASSERT_EQ(buffer.size(), 6u);
+    EXPECT_EQ(std::string(buffer.data(), buffer.size()), ">hello");
+
+    auto empty = buffer.append_uninitialized(0);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(buffer.size(), 6u);
+}
+
+// Iterator concepts
+static_assert(std::contiguous_iterator<Vector<int>::iterator>);
+static_assert(std::contiguous_iterator<Vector<int>::const_iterator>);
+static_assert(std::ranges::contiguous_range<Vector<int>>);
+static_assert(std::ranges::contiguous_range<const Vector<int>>);
+static_assert(std::ranges::sized_range<Vector<int>>);
+static_assert(std::is_convertible_v<Vector<int>::iterator, Vector<int>::const_iterator>);
+static_assert(!std::is_convertible_v<Vector<int>::const_iterator, Vector<int>::iterator>);
+static_assert(std::is_same_v<std::iterator_traits<Vector<int>::iterator>::iterator_category,
+                             std::random_access_iterator_tag>);
+static_assert(std::is_same_v<std::iter_value_t<Vector<int>::const_iterator>, int>);
+
+TEST_F(VectorTest, IteratorArithmeticAndOrdering)
+{
+    Vector<int> vec{10, 20, 30, 40};
+
+    auto it = vec.begin();
+    EXPECT_EQ(*(it + 2), 30);
+    EXPECT_EQ(*(2 + it), 30);
+    it += 3;
+    EXPECT_EQ(*it, 40);
+    it -= 2;
+    EXPECT_EQ(*it, 20);
+    EXPECT_EQ(*(it - 1), 10);
+    EXPECT_EQ(vec.end() - vec.begin(), 4);
+    EXPECT_EQ(it[-1], 10);
+
+    EXPECT_LT(vec.begin(), vec.end());
+    EXPECT_GE(vec.end(), it);
+    EXPECT_GT(it, vec.begin());
+    EXPECT_LE(it, it);
+}
+
+TEST_F(VectorTest, MutableAndConstIteratorsInteroperate)
+{
+    Vector<int> vec{1, 2, 3};
+    Vector<int>::const_iterator cit = vec.begin();
+
+    EXPECT_EQ(cit, vec.cbegin());
+    EXPECT_EQ(vec.begin(), cit);
+    EXPECT_LT(cit, vec.end());
+    EXPECT_EQ(vec.cend() - cit, 3);
+    EXPECT_EQ(std::to_address(vec.begin()), vec.data());
+}
+
+TEST_F(VectorTest, StandardAlgorithmsWorkOnVector)
+{
+    Vector<int> vec{5, 3, 9, 1, 7};
+
+    std::sort(vec.begin(), vec.end());
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+    EXPECT_EQ(vec[0], 1);
+    EXPECT_EQ(vec[4], 9);
+
+    std::ranges::reverse(vec);
+    EXPECT_EQ(vec.front(), 9);
+
+    Vector<int> copy;
+    copy.resize(vec.size());
+    std::copy(vec.cbegin(), vec.cend(), copy.begin());
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), copy.begin()));
+
+    EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0), 25);
+    EXPECT_EQ(*std::ranges::max_element(vec), 9);
+
+    std::span<const int> view(vec);
+    EXPECT_EQ(view.size(), 5u);
+    EXPECT_EQ(view.data(), vec.data());
+}
+
+TEST_F(VectorTest, AppendRangeFromVectorUsesContiguousSource)
+{
+    Vector<int> first{1, 2, 3};
+    Vector<int> second{4, 5};
+
+    first.append_range(second);
+    first.insert(first.begin() + 1, second.begin(), second.end());
+
+    const int expected[] = {1, 4, 5, 2, 3, 4, 5};
+    ASSERT_EQ(first.size(), 7u);
+    EXPECT_TRUE(std::equal(first.begin(), first.end(), std::begin(expected)));
+}
+
+TEST_F(VectorTest, ShrinkToFitReturnsUnusedCapacity)
+{
+    Vector<std::string> vec;
+    vec.reserve(100);
+    vec.push_back("kept");
+    vec.push_back("also kept");
+
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 2u);
+    EXPECT_EQ(vec[1], "also kept");
+
+    vec.clear();
+    vec.shrink_to_fit();
+    EXPECT_EQ(vec.capacity(), 0u);
+    EXPECT_EQ(vec.data(), nullptr);
+}
+
+TEST_F(VectorTest, ReleaseHandsOverBufferAndAdoptTakesItBack)
+{
+    Vector<std::string> vec = {"a", "b", "c"};
+    vec.reserve(8);
+    const std::string* data = vec.data();
+
+    auto buffer = vec.release();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.capacity(), 0u);
+    EXPECT_EQ(buffer.data, data);
+    EXPECT_EQ(buffer.size, 3u);
+    EXPECT_EQ(buffer.capacity, 8u);
+
+    auto adopted = Vector<std::string>::adopt(buffer);
+    EXPECT_EQ(adopted.data(), data);
+    EXPECT_EQ(adopted[2], "c");
+    adopted.push_back("d");
+    EXPECT_EQ(adopted.capacity(), 8u);
+}
+
+TEST_F(VectorTest, InsertSingleAndRepeatedValues)
+{
+    Vector<int> vec = {1, 2, 5};
+    auto it = vec.insert(vec.begin() + 2, 4);
+    EXPECT_EQ(*it, 4);
+    it = vec.insert(vec.cbegin() + 2, 3);
+    EXPECT_EQ(it - vec.begin(), 2);
+    vec.insert(vec.end(), 2, 6);
+    vec.insert(vec.begin(), 0u, 9);
+
+    const int expected[] = {1, 2, 3, 4, 5, 6, 6};
+    ASSERT_EQ(vec.size(), 7u);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), std::begin(expected)));
+
+    Vector<std::string> words = {"a", "d"};
+    words.insert(words.begin() + 1, 2, std::string("bc"));
+    words.insert(words.begin(), std::string("start"));
+    const std::string expected_words[] = {"start", "a", "bc", "bc", "d"};
+    EXPECT_TRUE(std::equal(words.begin(), words.end(), std::begin(expected_words)));
+}
+
+TEST_F(VectorTest, InsertOfOwnElementSurvivesGrowth)
+{
+    Vector<std::string> vec = {"first", "second"};
+    vec.shrink_to_fit();
+    vec.insert(vec.begin(), vec[1]);
+    vec.insert(vec.begin() + 1, 3, vec[0]);
+
+    const std::string expected[] = {"second", "second", "second", "second", "first", "second"};
+    ASSERT_EQ(vec.size(), 6u);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), std::begin(expected)));
+}
+
+TEST_F(VectorTest, PushBackOfOwnElementSurvivesGrowth)
+{
+    const std::string text = "a string too long for the small-string buffer";
+    Vector<std::string> vec = {text, "b"};
+    vec.shrink_to_fit();
+    vec.push_back(vec[0]);
+    vec.shrink_to_fit();
+    vec.emplace_back(vec[1]);
+    vec.shrink_to_fit();
+    ASSERT_TRUE(vec.try_push_back(vec[2]).has_value());
+    vec.shrink_to_fit();
+    ASSERT_TRUE(vec.try_emplace_back(vec[3]).has_value());
+
+    const std::string expected[] = {text, "b", text, "b", text, "b"};
+    ASSERT_EQ(vec.size(), 6u);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), std::begin(expected)));
+}
+
+TEST_F(VectorTest, EmplaceConstructsInPlaceAtAnyPosition)
+{
+    Vector<std::pair<int, std::string>> vec;
+    vec.emplace(vec.end(), 3, "three");
+    vec.emplace(vec.begin(), 1, "one");
+    auto it = vec.emplace(vec.begin() + 1, 2, "two");
+
+    EXPECT_EQ(it->second, "two");
+    ASSERT_EQ(vec.size(), 3u);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_EQ(vec[i].first, i + 1);
+    }
+
+    Vector<std::unique_ptr<int>> owners;
+    owners.emplace(owners.end(), std::make_unique<int>(2));
+    owners.emplace(owners.begin(), std::make_unique<int>(1));
+    EXPECT_EQ(*owners[0], 1);
+    EXPECT_EQ(*owners[1], 2);
+}
+
+TEST_F(VectorTest, EraseSingleAndRange)
+{
+    Vector<int> vec = {0, 1, 2, 3, 4, 5, 6};
+    auto it = vec.erase(vec.begin() + 1);
+    EXPECT_EQ(*it, 2);
+    it = vec.erase(vec.begin() + 2, vec.begin() + 4);
+    EXPECT_EQ(*it, 5);
+    it = vec.erase(vec.begin() + 1, vec.begin() + 1);
+    EXPECT_EQ(*it, 2);
+
+    const int expected[] = {0, 2, 5, 6};
+    ASSERT_EQ(vec.size(), 4u);
+    EXPECT_TRUE(std::equal(vec.begin(), vec.end(), std::begin(expected)));
+
+    Vector<std::string> words = {"a", "b", "c", "d"};
+    words.erase(words.begin(), words.begin() + 2);
+    EXPECT_EQ(words.front(), "c");
+    words.erase(words.end() - 1);
+    ASSERT_EQ(words.size(), 1u);
+    EXPECT_EQ(words[0], "c");
+}
+
+TEST_F(VectorTest, SwapRemoveMovesLastElementIntoHole)
+{
+    Vector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 5; ++i) {
+        vec.push_back(std::make_unique<int>(i));
+    }
+
+    vec.swap_remove(1);
+    ASSERT_EQ(vec.size(), 4u);
+    EXPECT_EQ(*vec[1], 4);
+    vec.swap_remove(3);
+    EXPECT_EQ(*vec.back(), 2);
+
+    Vector<std::string> words = {"a", "b", "c"};
+    words.swap_remove(0);
+    EXPECT_EQ(words[0], "c");
+    EXPECT_EQ(words[1], "b");
+}
+
+TEST_F(VectorTest, EraseIfCompactsInOrder)
+{
+    Vector<int> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i);
+    }
+    EXPECT_EQ(erase_if(vec, [](int v) { return v % 3 != 0; }), 66u);
+    ASSERT_EQ(vec.size(), 34u);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], static_cast<int>(i * 3));
+    }
+    EXPECT_EQ(erase(vec, 99), 1u);
+    EXPECT_EQ(vec.back(), 96);
+
+    Vector<std::string> words = {"keep", "drop", "keep", "drop", "drop"};
+    EXPECT_EQ(words.remove_if([](const std::string& w) { return w == "drop"; }), 3u);
+    ASSERT_EQ(words.size(), 2u);
+    EXPECT_EQ(words[1], "keep");
+}
+
+TEST_F(VectorTest, RemoveIfLeavesLiveElementsWhenPredicateThrows)
+{
+    Vector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 10; ++i) {
+        vec.push_back(std::make_unique<int>(i));
+    }
+
+    EXPECT_THROW(vec.remove_if([](const std::unique_ptr<int>& p) {
+        if (*p == 6) throw std::runtime_error("stop");
+        return *p % 2 == 0;
+    }), std::runtime_error);
+
+    const int expected[] = {1, 3, 5, 6, 7, 8, 9};
+    ASSERT_EQ(vec.size(), 7u);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(*vec[i], expected[i]);
+    }
+}
+
+// Builds, edits and reads back vectors inside a constant expression, so every member used here
+// must stay free of placement new and byte copies when constant-evaluated.
+constexpr int sum_after_edits()
+{
+    Vector<int> vec;
+    for (int i = 0; i < 50; ++i) {
+        vec.push_back(i);
+    }
+    vec.insert(vec.begin(), 3, -1);
+    vec.erase(vec.begin() + 3, vec.begin() + 13);
+    erase_if(vec, [](int x) { return x % 2 != 0; });
+    vec.swap_remove(0);
+    Vector<int> copy = vec;
+    copy.resize_for_overwrite(copy.size() + 1);
+    copy.back() = 1000;
+    copy.assign(2, copy[0]);
+    copy.append_range(vec);
+    copy.shrink_to_fit();
+    int sum = 0;
+    for (int x : copy) {
+        sum += x;
+    }
+    return sum;
+}
+
+constexpr std::size_t owners_after_edits()
+{
+    Vector<std::unique_ptr<int>> vec;
+    for (int i = 0; i < 20; ++i) {
+        vec.emplace_back(std::make_unique<int>(i));
+    }
+    vec.emplace(vec.begin() + 5, std::make_unique<int>(100));
+    vec.remove_if([](const std::unique_ptr<int>& p) { return *p < 10; });
+    return vec.size() * 1000 + static_cast<std::size_t>(*vec.front());
+}
+
+TEST_F(VectorTest, UsableInConstantExpressions)
+{
+    // two copies of 48, then 48 and the even numbers 12..46
+    static_assert(sum_after_edits() == 666);
+    static_assert(owners_after_edits() == 11 * 1000 + 100);
+    EXPECT_EQ(sum_after_edits(), 666);
+}
+
+TEST_F(VectorTest, TryMembersReportCapacityOverflow)
+{
+    Vector<int> vec{1, 2, 3};
+    auto reserved = vec.try_reserve(vec.max_size() + 1);
+    ASSERT_FALSE(reserved.has_value());
+    EXPECT_EQ(reserved.error(), AllocError::capacity_overflow);
+    EXPECT_TRUE(vec.try_reserve(2).has_value()); // already has room
+    EXPECT_TRUE(vec.try_reserve(64).has_value());
+    EXPECT_GE(vec.capacity(), 64u);
+
+    auto pushed = vec.try_push_back(4);
+    ASSERT_TRUE(pushed.has_value());
+    pushed->get() = 40;
+    EXPECT_EQ(vec.back(), 40);
+    EXPECT_EQ(vec.try_emplace_back(5)->get(), 5);
+}
+
+TEST_F(VectorTest, TryMembersReportThrowingAllocatorFailureAndKeepContents)
+{
+    using Alloc = BudgetAllocator<std::string, false>;
+    Alloc::budget = 4;
+    Vector<std::string, Alloc> vec;
+    ASSERT_TRUE(vec.try_reserve(4).has_value()); // spends the whole budget
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(vec.try_push_back(std::to_string(i)).has_value());
+    }
+    const std::string* data = vec.data();
+
+    std::string next = "next";
+    auto pushed = vec.try_push_back(std::move(next));
+    ASSERT_FALSE(pushed.has_value());
+    EXPECT_EQ(pushed.error(), AllocError::out_of_memory);
+    EXPECT_EQ(next, "next"); // not moved from
+    EXPECT_EQ(vec.data(), data);
+    EXPECT_EQ(vec.size(), 4u);
+    EXPECT_EQ(vec[3], "3");
+    EXPECT_EQ(vec.try_reserve(100).error(), AllocError::out_of_memory);
+    EXPECT_THROW(vec.reserve(100), std::bad_alloc); // the throwing members still throw
+}
+
+TEST_F(VectorTest, TryMembersUseNonThrowingAllocation)
+{
+    using Alloc = BudgetAllocator<int, true>;
+    Alloc::budget = 8;
+    Vector<int, Alloc> vec;
+    ASSERT_TRUE(vec.try_reserve(8).has_value());
+    for (int i = 0; i < 8; ++i) {
+        ASSERT_TRUE(vec.try_emplace_back(i).has_value());
+    }
+    EXPECT_EQ(vec.try_emplace_back(8).error(), AllocError::out_of_memory);
+    EXPECT_EQ(vec.size(), 8u);
+    EXPECT_EQ(vec.back(), 7);
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include "../SmallVector.h"
+#include "../VectorView.h"
+
+namespace {
+// Sums through a std::span, standing in for an existing span-based API.
+int sum(std::span<const int> values)
+{
+    return std::accumulate(values.begin(), values.end(), 0);
+}
+
+Vector<int> make_sequence(int count)
+{
+    Vector<int> vec;
+    for (int i = 0; i < count; ++i) {
+        vec.push_back(i);
+    }
+    return vec;
+}
+
+TEST(VectorViewTest, ViewsAVectorWithoutCopying) {
+    auto vec = make_sequence(10);
+    VectorView view(vec);
+    static_assert(std::is_same_v<decltype(view), VectorView<int>>);
+
+    EXPECT_EQ(view.data(), vec.data());
+    EXPECT_EQ(view.size(), 10u);
+    view[3] = 30;
+    EXPECT_EQ(vec[3], 30);
+}
+
+TEST(VectorViewTest, ConstVectorsGiveConstViews) {
+    const auto vec = make_sequence(4);
+    VectorView view(vec);
+    static_assert(std::is_same_v<decltype(view), VectorView<const int>>);
+    static_assert(!std::is_constructible_v<VectorView<int>, const Vector<int>&>);
+    // a view of a temporary container would dangle immediately
+    static_assert(!std::is_constructible_v<VectorView<const int>, Vector<int>>);
+    static_assert(!std::is_constructible_v<VectorView<const int>, const Vector<int>&&>);
+    static_assert(std::is_constructible_v<VectorView<int>, std::span<int>>);
+
+    VectorView<int> other;
+    VectorView<const int> readonly = other; // mutable views narrow to const
+    EXPECT_TRUE(readonly.empty());
+    EXPECT_EQ(view.back(), 3);
+}
+
+TEST(VectorViewTest, SliceClampsLengthAndChecksOffset) {
+    auto vec = make_sequence(10);
+    VectorView<int> view(vec);
+
+    const auto middle = view.slice(2, 5);
+    EXPECT_EQ(middle.size(), 5u);
+    EXPECT_EQ(middle.front(), 2);
+    EXPECT_EQ(middle.back(), 6);
+
+    EXPECT_EQ(view.slice(8).size(), 2u);
+    EXPECT_EQ(view.slice(8, 100).size(), 2u);
+    EXPECT_TRUE(view.slice(10).empty());
+    EXPECT_THROW(view.slice(11), std::out_of_range);
+
+    EXPECT_EQ(view.first(3).back(), 2);
+    EXPECT_EQ(view.last(3).front(), 7);
+    EXPECT_THROW(view.first(11), std::out_of_range);
+    EXPECT_THROW(view.at(10), std::out_of_range);
+}
+
+TEST(VectorViewTest, ConvertsToSpanAndWindowsFeedSpanApis) {
+    const auto vec = make_sequence(100);
+    const VectorView<const int> view(vec);
+
+    int total = 0;
+    for (std::size_t offset = 0; offset < view.size(); offset += 32) {
+        total += sum(view.slice(offset, 32));
+    }
+    EXPECT_EQ(total, 4950);
+
+    std::span<const int> span = view.slice(10, 5);
+    EXPECT_EQ(span.data(), vec.data() + 10);
+}
+
+TEST(VectorViewTest, ViewsOtherContiguousContainers) {
+    SmallVector<int, 4> small;
+    small.push_back(1);
+    small.push_back(2);
+    std::vector<int> standard = {3, 4, 5};
+
+    EXPECT_EQ(sum(VectorView(small)), 3);
+    EXPECT_EQ(sum(VectorView(standard).slice(1)), 9);
+    EXPECT_EQ(VectorView(std::span(standard)).size(), 3u);
+}
+
+TEST(VectorViewTest, IsABorrowedContiguousView) {
+    static_assert(std::ranges::contiguous_range<VectorView<int>>);
+    static_assert(std::ranges::view<VectorView<int>>);
+    static_assert(std::ranges::borrowed_range<VectorView<int>>);
+
+    auto vec = make_sequence(6);
+    auto evens = VectorView(vec) | std::views::filter([](int value) { return value % 2 == 0; });
+    EXPECT_EQ(std::ranges::distance(evens), 3);
+    EXPECT_EQ(std::ranges::find(VectorView(vec), 4), vec.begin() + 4);
+}
+} // namespace